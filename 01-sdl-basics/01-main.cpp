@@ -1,5 +1,8 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_image.h>
+#include "MScene01.hpp"
+#include "MRenderScheduler.hpp"
+#include "MAllocTracker.hpp"
 #include <string>
 #include <iostream>
 
@@ -8,9 +11,21 @@ constexpr int SCREEN_WIDTH = {640};
 constexpr int SCREEN_HEIGHT = {480};
 constexpr const char *WINDOW_TITLE{"SDL3 Tutorial 01: Basics Example"};
 
+// Scale the image with the SIMD kernels of MSurfaceBlitter instead of SDL_BlitSurfaceScaled
+constexpr bool USE_SIMD_BLITTER{true};
+
+// Scale the image once into MScaledSurfaceCache and copy the scaled surface every frame (rebuilt when the window is resized)
+constexpr bool USE_SCALED_CACHE{true};
+
+// Log every steady-state frame that allocates on the heap (the tracker is compiled out of NDEBUG builds)
+constexpr bool CHECK_FRAME_ALLOCATIONS{true};
+
 // Function to initialize SDL and create a window
 bool init(SDL_Window *&window_prt, SDL_Surface *&screen_surface)
 {
+    // Count SDL's heap allocations from the first one: its memory functions cannot be replaced once it has allocated
+    MAllocTracker::install();
+
     // Initialize SDL3
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -20,7 +35,7 @@ bool init(SDL_Window *&window_prt, SDL_Surface *&screen_surface)
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "SDL initialized successfully.\n");
 
     // Create a window with the specified title, width, height, and flags
-    if (window_prt = SDL_CreateWindow(WINDOW_TITLE, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_OPENGL); window_prt == nullptr)
+    if (window_prt = SDL_CreateWindow(WINDOW_TITLE, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE); window_prt == nullptr)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create window: %s\n", SDL_GetError());
 
@@ -67,7 +82,7 @@ void cleanup(SDL_Window *&window, SDL_Surface *&screen_surface, SDL_Surface *&im
 }
 
 // Function to check media availability (textures, sounds, etc.)
-bool checkMediaAvailability(SDL_Surface *&image_surface)
+bool checkMediaAvailability(SDL_Surface *&image_surface, const SDL_Surface *screen_surface)
 {
     bool success{true};
 
@@ -81,6 +96,20 @@ bool checkMediaAvailability(SDL_Surface *&image_surface)
         success = false; // Exit if image loading fails
     }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Image loaded successfully from %s.\n", image_path);
+
+    // Convert the image once to the screen format, so that every blit is a plain copy the SIMD kernels can do
+    if (success && screen_surface != nullptr && image_surface->format != screen_surface->format)
+    {
+        if (SDL_Surface *converted_surface = SDL_ConvertSurface(image_surface, screen_surface->format); converted_surface != nullptr)
+        {
+            SDL_DestroySurface(image_surface);
+            image_surface = converted_surface;
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not convert image to the screen format: %s\n", SDL_GetError());
+        }
+    }
     return success;
 }
 
@@ -93,9 +122,6 @@ int main()
     SDL_Surface *pScreenSurface{nullptr};
     SDL_Surface *pImageSurface{nullptr};
 
-    // Define the destination rectangle for rendering the image scaled
-    SDL_Rect destination_rect{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-
     // Flag to indicate when the application should exit
     bool quit = {false};
 
@@ -110,42 +136,89 @@ int main()
     }
 
     // Load media resources
-    if (!checkMediaAvailability(pImageSurface))
+    if (!checkMediaAvailability(pImageSurface, pScreenSurface))
     {
         exit_code = 2; // Exit if media availability check fails
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Media availability check failed.\n");
     }
 
+    // Create the scene that scales the image into the changed rectangles of the window, with the scaled cache or the blitter
+    constexpr MScene01::ScalePath scale_path = USE_SCALED_CACHE ? MScene01::SCALED_CACHE : USE_SIMD_BLITTER ? MScene01::SIMD_BLITTER : MScene01::SDL_BLITTER;
+    MScene01 scene(pScreenSurface != nullptr ? pScreenSurface->w : SCREEN_WIDTH, pScreenSurface != nullptr ? pScreenSurface->h : SCREEN_HEIGHT, scale_path);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Blit kernel: %s.\n", MSurfaceBlitter::getKernelName(scene.getBlitter().getKernel()));
+
+    // Create the scheduler that sleeps while nothing changes
+    MRenderScheduler scheduler{};
+
     // Create an event structure to handle events
     SDL_Event event;
     SDL_zero(event); // Initialize the event structure
 
+    // Every frame after the first one (which grows the list of dirty rectangles) must draw without allocating
+    MAllocTracker::setStrict(CHECK_FRAME_ALLOCATIONS, 1);
+
     // Main loop: keep running until the quit flag is set
     while (!quit)
     {
-        while (SDL_PollEvent(&event)) // Events Loop: Poll for events
+        // Allocations are counted from the start of the iteration that presents, idle iterations are not counted
+        MAllocTracker::beginFrame();
+
+        // Wait for the next event: blocks while nothing has to be redrawn
+        if (scheduler.waitEvent(&event))
         {
-            // Check if the quit event is triggered
-            if (event.type == SDL_EVENT_QUIT)
+            do // Events Loop: handle the event and any other pending one
             {
-                quit = true; // Set the quit flag to true
-            }
+                // Window events (expose, resize, ...) wake the render loop up
+                scheduler.handleEvent(event);
+
+                // Check if the quit event is triggered
+                if (event.type == SDL_EVENT_QUIT)
+                {
+                    quit = true; // Set the quit flag to true
+                }
+
+                // The window content was lost (uncovered, restored): every pixel has to be presented again
+                if (event.type == SDL_EVENT_WINDOW_EXPOSED)
+                {
+                    scene.invalidate();
+                }
+
+                // The window surface is recreated at the new size: get it again and scale the image to it on the next frame
+                if (event.type == SDL_EVENT_WINDOW_RESIZED)
+                {
+                    if (pScreenSurface = SDL_GetWindowSurface(pWindow); pScreenSurface == nullptr)
+                    {
+                        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not get window surface after resize: %s\n", SDL_GetError());
+                        quit = true;
+                        exit_code = 1;
+                        break;
+                    }
+                    scene.resize(pScreenSurface->w, pScreenSurface->h);
+                    MAllocTracker::expectAllocations(); // The new surface and the scaled copy are allocated by this frame
+                    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Window resized to %dx%d.\n", pScreenSurface->w, pScreenSurface->h);
+                }
+            } while (SDL_PollEvent(&event));
         }
 
-        // Definition of the color to fill the screen (white in this case)
-        SDL_Color white_color{255, 255, 255, 255}; 
-        
-        // Fill the screen surface with a color 
-        SDL_FillSurfaceRect(pScreenSurface, nullptr, SDL_MapSurfaceRGB(pScreenSurface, white_color.r, white_color.g, white_color.b));
-
-        // Render the image surface onto the screen surface with scaling
-        SDL_BlitSurfaceScaled(pImageSurface, nullptr, pScreenSurface, &destination_rect, SDL_SCALEMODE_LINEAR);
+        // Skip the frame if nothing changed since the last present, then redraw only the changed rectangles (nothing when none changed)
+        if (quit || !scheduler.shouldRender() || !scene.render(pImageSurface, pScreenSurface, pWindow))
+        {
+            continue;
+        }
+        MAllocTracker::endFrame();
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames presented: %llu, pixels presented: %llu, draw calls: %llu\n", (unsigned long long)scene.getDirtyRegion().getFramesPresented(),
+                (unsigned long long)scene.getDirtyRegion().getPixelsPresented(), (unsigned long long)scene.getDrawCalls());
 
-        // Update the window surface to reflect changes
-        SDL_UpdateWindowSurface(pWindow);
+    // Report how many frames allocated on the heap (in strict mode the steady-state ones were logged as they happened)
+    if (MALLOC_TRACKER_ENABLED)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames that allocated: %llu of %llu (at most %llu allocations), steady-state violations: %llu\n", (unsigned long long)MAllocTracker::getAllocatingFrames(),
+                    (unsigned long long)MAllocTracker::getFrameCount(), (unsigned long long)MAllocTracker::getMaxFrameAllocations(), (unsigned long long)MAllocTracker::getViolationCount());
     }
 
-    // Clean up
+    // Clean up (the scaled copy must be freed before SDL quits)
+    scene.clear();
     cleanup(pWindow, pScreenSurface, pImageSurface);
 
     // Return the exit code: 0 for success, non-zero for failure
@@ -0,0 +1,63 @@
+#include "MScene01.hpp"
+
+// ############################################################################################
+// Scene01's constructor starts with the whole window surface dirty
+MScene01::MScene01(const int width, const int height, const ScalePath scale_path)
+    : scale_path(scale_path), destination_rect{0, 0, width, height}, dirty_region(width, height), draw_calls(0)
+{
+}
+
+// ############################################################################################
+// Scene01's resize function scales the image to the new size on the next frame
+void MScene01::resize(const int width, const int height)
+{
+    this->destination_rect = {0, 0, width, height};
+    this->scaled_cache.invalidate();
+    this->dirty_region.reset(width, height);
+}
+
+// ############################################################################################
+// Scene01's render function redraws the changed rectangles: the fill and the blits are clipped to each of them
+bool MScene01::render(SDL_Surface *image_surface, SDL_Surface *screen_surface, SDL_Window *window)
+{
+    if (this->dirty_region.isEmpty())
+    {
+        return false; // Nothing inside the window changed
+    }
+
+    // Definition of the color to fill the screen (white in this case)
+    const SDL_Color white_color{255, 255, 255, 255};
+
+    for (const SDL_Rect &dirty_rect : this->dirty_region.getRects())
+    {
+        SDL_SetSurfaceClipRect(screen_surface, &dirty_rect);
+
+        // Fill the screen surface with a color, unless the image is about to overwrite every pixel anyway
+        if (!MSurfaceBlitter::coversSurface(image_surface, screen_surface, &this->destination_rect))
+        {
+            SDL_FillSurfaceRect(screen_surface, nullptr, SDL_MapSurfaceRGB(screen_surface, white_color.r, white_color.g, white_color.b));
+            this->draw_calls++;
+        }
+
+        // Render the image surface onto the screen surface with scaling
+        switch (this->scale_path)
+        {
+        case SCALED_CACHE:
+            this->scaled_cache.blit(image_surface, screen_surface, &this->destination_rect, SDL_SCALEMODE_LINEAR); // Plain copy, scaled only after a resize
+            break;
+        case SIMD_BLITTER:
+            this->blitter.blitScaled(image_surface, nullptr, screen_surface, &this->destination_rect, SDL_SCALEMODE_LINEAR);
+            break;
+        default:
+            SDL_BlitSurfaceScaled(image_surface, nullptr, screen_surface, &this->destination_rect, SDL_SCALEMODE_LINEAR);
+            break;
+        }
+        this->draw_calls++;
+    }
+    SDL_SetSurfaceClipRect(screen_surface, nullptr);
+
+    // Update only the changed rectangles of the window surface
+    this->dirty_region.present(window);
+    return true;
+}
+// ############################################################################################
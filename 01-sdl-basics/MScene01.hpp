@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MSurfaceBlitter.hpp"
+#include "MScaledSurfaceCache.hpp"
+#include "MDirtyRegion.hpp"
+
+// Frame of tutorial 01: the image scaled to the window surface, redrawn in the changed rectangles only
+// Shared by 01-main.cpp and benchmarks/bench-scenes.cpp, so that the benchmark measures the frames the tutorial draws
+class MScene01
+{
+public:
+    // Path the image is scaled with
+    enum ScalePath
+    {
+        SCALED_CACHE, // Scaled once into MScaledSurfaceCache, then copied (scaled again only after a resize)
+        SIMD_BLITTER, // Scaled every frame by the SIMD kernels of MSurfaceBlitter
+        SDL_BLITTER   // Scaled every frame by SDL_BlitSurfaceScaled
+    };
+
+private:
+    ScalePath scale_path;             // Path the image is scaled with
+    SDL_Rect destination_rect;        // Rectangle the image is scaled to: the whole window surface
+    MSurfaceBlitter blitter;          // Blitter with the best kernel supported by the CPU
+    MScaledSurfaceCache scaled_cache; // Image scaled to the window size
+    MDirtyRegion dirty_region;        // Rectangles of the window surface changed since the last present
+    Uint64 draw_calls;                // Number of fills and blits issued
+
+public:
+    // Constructor to draw into a window surface of the given size, entirely dirty so that the first frame is drawn
+    MScene01(const int width, const int height, const ScalePath scale_path = SCALED_CACHE);
+
+    // Function to follow the window surface recreated at a new size: the image is scaled again and every pixel redrawn
+    void resize(const int width, const int height);
+
+    // Function to redraw every pixel on the next frame, e.g. when the window content was lost (uncovered, restored)
+    inline void invalidate() { dirty_region.addAll(); }
+
+    // Function to draw the image into the changed rectangles of the window surface and present them: returns false when nothing changed
+    bool render(SDL_Surface *image_surface, SDL_Surface *screen_surface, SDL_Window *window);
+
+    // Function to free the scaled copy (before SDL quits)
+    inline void clear() { scaled_cache.invalidate(); }
+
+    // Getters for the scene state inline for efficiency
+    inline const MSurfaceBlitter &getBlitter() const { return blitter; }       // Getter for the blitter of the SIMD path
+    inline const MDirtyRegion &getDirtyRegion() const { return dirty_region; } // Getter for the changed rectangles and the present statistics
+    inline const Uint64 getDrawCalls() const { return draw_calls; }            // Getter for the number of fills and blits issued
+};
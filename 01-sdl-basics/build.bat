@@ -1,4 +1,5 @@
-g++ 01-main.cpp -std=c++2a ^
+g++ 01-main.cpp MScene01.cpp ..\common\MSurfaceBlitter.cpp ..\common\MScaledSurfaceCache.cpp ..\common\MRenderScheduler.cpp ..\common\MDirtyRegion.cpp ..\common\MAllocTracker.cpp -O2 -std=c++2a ^
+-I "..\common" ^
 -I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
 -I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
 -o ../main.exe && start ../main.exe
\ No newline at end of file
@@ -1,15 +1,20 @@
 #include <iostream>
-#include "MTexture02.hpp"
+#include "MTexture.hpp"
+#include "MAllocTracker.hpp"
 
 // Constants for screen dimensions and window title
 constexpr int SCREEN_WIDTH = {640};
 constexpr int SCREEN_HEIGHT = {480};
 constexpr const char *WINDOW_TITLE{"SDL3 Tutorial 02: Textures and Extension Libraries Example"};
+constexpr bool CHECK_FRAME_ALLOCATIONS{true}; // Log every steady-state frame that allocates on the heap (the tracker is compiled out of NDEBUG builds)
 
 
 // Function to initialize SDL and create a window
 bool init(SDL_Window *&window_prt, SDL_Renderer *&renderer)
 {
+    // Count SDL's heap allocations from the first one: its memory functions cannot be replaced once it has allocated
+    MAllocTracker::install();
+
     // Initialize SDL3
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -108,9 +113,14 @@ int main()
     SDL_Event event;
     SDL_zero(event); // Initialize the event structure
 
+    // Every frame after the first one (which grows the draw buffers) must draw without allocating
+    MAllocTracker::setStrict(CHECK_FRAME_ALLOCATIONS, 1);
+
     // Main loop: keep running until the quit flag is set
     while (!quit)
     {
+        MAllocTracker::beginFrame(); // Allocations are counted per loop iteration: one iteration presents one frame
+
         while (SDL_PollEvent(&event)) // Events Loop: Poll for events
         {
             // Check if the quit event is triggered
@@ -129,6 +139,14 @@ int main()
 
         // Present the rendered content to the window
         SDL_RenderPresent(pRenderer);
+        MAllocTracker::endFrame();
+    }
+
+    // Report how many frames allocated on the heap (in strict mode the steady-state ones were logged as they happened)
+    if (MALLOC_TRACKER_ENABLED)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames that allocated: %llu of %llu (at most %llu allocations), steady-state violations: %llu\n", (unsigned long long)MAllocTracker::getAllocatingFrames(),
+                    (unsigned long long)MAllocTracker::getFrameCount(), (unsigned long long)MAllocTracker::getMaxFrameAllocations(), (unsigned long long)MAllocTracker::getViolationCount());
     }
 
     // Clean up
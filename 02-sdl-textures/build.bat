@@ -1,4 +1,5 @@
-g++ 02-main.cpp MTexture02.cpp -std=c++2a ^
+g++ 02-main.cpp ..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp ..\common\MAllocTracker.cpp -std=c++2a ^
+-I "..\common" ^
 -I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
 -I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
 -o ../main.exe && start ../main.exe
\ No newline at end of file
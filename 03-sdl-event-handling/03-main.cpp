@@ -1,4 +1,8 @@
-#include "MTexture03.hpp"
+#include "MTextureCache03.hpp"
+#include "MAssetWatcher.hpp"
+#include "MLog.hpp"
+#include "MProfiler.hpp"
+#include "MAllocTracker.hpp"
 #include <iostream>
 
 
@@ -6,10 +10,24 @@
 constexpr int SCREEN_WIDTH{640};
 constexpr int SCREEN_HEIGHT{480};
 constexpr const char *WINDOW_TITLE{"SDL3 Tutorial 03: Event Handling Example"};
+constexpr bool SHOW_PROFILER_OVERLAY{true};                    // Draw the p50/p99 frame time and the zones of the last frame in the corner
+constexpr const char *PROFILER_TRACE_FILE{"../trace-03.json"}; // Chrome trace of the last frames, written on exit (nullptr to skip it)
+constexpr bool CHECK_FRAME_ALLOCATIONS{true};                  // Log every steady-state frame that allocates on the heap (the tracker is compiled out of NDEBUG builds)
+constexpr bool HOT_RELOAD_ASSETS{true};                        // Reload a texture when its file in assets/ is saved, without restarting
+
+// Image files loaded at startup (and watched when HOT_RELOAD_ASSETS is set)
+constexpr const char *MEDIA_FILES[]{"../assets/03img.png", "../assets/03up.png", "../assets/03down.png", "../assets/03left.png", "../assets/03right.png"};
+constexpr size_t MEDIA_FILE_COUNT{sizeof(MEDIA_FILES) / sizeof(MEDIA_FILES[0])};
 
 // Function to initialize SDL and create a window
 bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
 {
+    // Count SDL's heap allocations from the first one: its memory functions cannot be replaced once it has allocated
+    MAllocTracker::install();
+
+    // Profile this thread, the render thread, from now on: the texture loads are recorded in the first frame, the worker threads are ignored
+    MProfiler::start();
+
     // Initialize SDL3
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -31,11 +49,27 @@ bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
 }
 
 // Function to clean up SDL resources
-void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *texture)
+void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTextureCache *cache, MAsyncLoader *loader, MAssetWatcher *watcher)
 {
+    // Report how many textures were reloaded after their file changed
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Hot reload: %llu file changes, %llu textures reloaded, %llu failed.\n", (unsigned long long)watcher->getChangesDetected(),
+                (unsigned long long)watcher->getReloads(), (unsigned long long)watcher->getFailedReloads());
 
-    // Clear the texture resources
-    texture->clear();
+    // Stop the loader and watcher threads before the textures they feed are released
+    loader->stop();
+    watcher->stop();
+
+    // Report how many texture requests were served without touching the disk
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Texture cache: %llu hits, %llu misses.\n", (unsigned long long)cache->getHits(), (unsigned long long)cache->getMisses());
+
+    // Write the profile of the last frames (open it in chrome://tracing or ui.perfetto.dev)
+    if (MPROFILER_ENABLED && PROFILER_TRACE_FILE != nullptr && MProfiler::exportTrace(PROFILER_TRACE_FILE))
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frame time p50 %.2f ms, p99 %.2f ms, trace written to %s\n", MProfiler::getFrameTimePercentile(50.0), MProfiler::getFrameTimePercentile(99.0), PROFILER_TRACE_FILE);
+    }
+
+    // Clear the cached texture resources
+    cache->clear();
 
     // Destroy the renderer
     SDL_DestroyRenderer(pRenderer);
@@ -52,37 +86,106 @@ void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *texture)
     // Reset pointers to nullptr
     pWindow = nullptr;
     pRenderer = nullptr;
-    texture = nullptr;
+    cache = nullptr;
+    loader = nullptr;
+    watcher = nullptr;
+}
+
+// Function to start loading every texture once on the worker threads, so that key presses never touch the disk
+bool preloadMedia(MTextureCache &cache, MAsyncLoader &loader, MAssetWatcher &watcher, SDL_Renderer *&pRenderer)
+{
+    // The placeholder is shown until a texture has been uploaded
+    if (!cache.createPlaceholder(pRenderer) || !loader.start())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to start loading textures!\n");
+        return false;
+    }
+
+    // Without the watcher the textures are still loaded, they are just not reloaded when their file changes (watchLoadedTextures)
+    if (HOT_RELOAD_ASSETS)
+    {
+        watcher.start();
+    }
+    for (const char *file_path : MEDIA_FILES)
+    {
+        cache.acquireAsync(file_path, loader);
+    }
+
+    return true;
+}
+
+// Function to watch the files of the textures uploaded so far: a watch only starts after the first load, so that a reload is never overwritten by it
+void watchLoadedTextures(MTextureCache &cache, MAssetWatcher &watcher, bool (&watched)[MEDIA_FILE_COUNT])
+{
+    for (size_t i = 0; i < MEDIA_FILE_COUNT; i++)
+    {
+        if (std::shared_ptr<MTexture> texture = cache.find(MEDIA_FILES[i]); !watched[i] && texture != nullptr && texture->isLoaded())
+        {
+            watched[i] = watcher.watch(MEDIA_FILES[i], texture);
+        }
+    }
+}
+
+// Function to render the bound texture (or the placeholder while it is loading) at the center of the screen, ending the profiled frame
+void renderFrame(MTextureCache &cache, const std::shared_ptr<MTexture> &texture, SDL_Renderer *&pRenderer)
+{
+    {
+        MPROFILE_ZONE("clear");
+
+        // Set the default background color to white (inline color setting)
+        SDL_SetRenderDrawColor(pRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(pRenderer);
+    }
+
+    // Render the texture at the center of the screen
+    MTexture &visible_texture = cache.resolve(texture);
+    visible_texture.renderTexture((SCREEN_WIDTH - visible_texture.getWidth()) / 2.0f, (SCREEN_HEIGHT - visible_texture.getHeight()) / 2.0f, pRenderer);
+
+    // Draw the profiler statistics of the previous frames on top
+    if (SHOW_PROFILER_OVERLAY)
+    {
+        MProfiler::renderOverlay(pRenderer, 8.f, 8.f);
+    }
+
+    {
+        MPROFILE_ZONE("present");
+
+        // Present the rendered content to the window
+        SDL_RenderPresent(pRenderer);
+    }
+    MProfiler::endFrame();
+    MAllocTracker::endFrame();
 }
 
 // Function to check media availability (textures, sounds, etc.)
-bool checkMediaAvailability(MTexture &texture, SDL_Renderer *&pRenderer, SDL_Keycode &key_code)
+bool checkMediaAvailability(MTextureCache &cache, std::shared_ptr<MTexture> &texture, SDL_Renderer *&pRenderer, SDL_Keycode &key_code)
 {
     bool success{true};
 
+    // Bind the cached texture that matches the key pressed: no file is loaded after the preload
     if (key_code == SDLK_UP)
-        if (texture.loadTexture("../assets/03up.png", pRenderer) == false)
+        if (texture = cache.acquire("../assets/03up.png", pRenderer); texture == nullptr)
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load up texture!\n");
             success = false;
         }
 
     if (key_code == SDLK_DOWN)
-        if (texture.loadTexture("../assets/03down.png", pRenderer) == false)
+        if (texture = cache.acquire("../assets/03down.png", pRenderer); texture == nullptr)
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load down texture!\n");
             success = false;
         }
 
     if (key_code == SDLK_LEFT)
-        if (texture.loadTexture("../assets/03left.png", pRenderer) == false)
+        if (texture = cache.acquire("../assets/03left.png", pRenderer); texture == nullptr)
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load left texture!\n");
             success = false;
         }
 
     if (key_code == SDLK_RIGHT)
-        if (texture.loadTexture("../assets/03right.png", pRenderer) == false)
+        if (texture = cache.acquire("../assets/03right.png", pRenderer); texture == nullptr)
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load right texture!\n");
             success = false;
@@ -98,8 +201,16 @@ int main()
     SDL_Window *pWindow{nullptr};
     SDL_Renderer *pRenderer{nullptr};
 
-    // The texture to be rendered
-    MTexture texture{};
+    // The cache that owns every texture, and the texture currently bound for rendering
+    MTextureCache cache{};
+    std::shared_ptr<MTexture> texture{};
+
+    // The worker threads that decode the textures in the background
+    MAsyncLoader loader{};
+
+    // The thread that reloads the textures whose file changed on disk, and the files it already watches
+    MAssetWatcher watcher{};
+    bool watched[MEDIA_FILE_COUNT]{};
 
     // Flag to indicate when the application should exit
     bool quit = {false};
@@ -118,63 +229,99 @@ int main()
     SDL_Event event;
     SDL_zero(event); // Initialize the event structure
 
-    // Load the default texture to be rendered
-    texture.loadTexture("../assets/03img.png", pRenderer); 
+    // Start loading every texture once and bind the default texture to be rendered
+    if (!preloadMedia(cache, loader, watcher, pRenderer))
+    {
+        exit_code = 2; // Exit if media availability check fails
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Media availability check failed.\n");
+    }
+    texture = cache.acquireAsync("../assets/03img.png", loader);
 
-    // Set the default background color to white (inline color setting)
-    SDL_SetRenderDrawColor(pRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-    SDL_RenderClear(pRenderer);
+    // Render the default texture (the placeholder until it is loaded)
+    renderFrame(cache, texture, pRenderer);
 
-    // Render the default texture at the center of the screen
-    texture.renderTexture((SCREEN_WIDTH - texture.getWidth()) / 2.0f, (SCREEN_HEIGHT - texture.getHeight()) / 2.0f, pRenderer); // Render the texture at the center of the screen
-    
-    // Present the rendered content to the window
-    SDL_RenderPresent(pRenderer); 
+    // Once the textures are uploaded, a key press only binds a cached texture: the frames after the first one must not allocate
+    MAllocTracker::setStrict(CHECK_FRAME_ALLOCATIONS, 1);
 
     // Main loop: keep running until the quit flag is set
     while (!quit)
     {
-        while (SDL_PollEvent(&event)) // Events Loop: Poll for events
+        // The frame time is measured from the start of the iteration that renders, idle iterations are not counted
+        MProfiler::beginFrame();
+        MAllocTracker::beginFrame();
+        bool redraw{false}; // Flag to indicate that the bound texture changed
+
         {
-            // Check if the quit event is triggered
-            if (event.type == SDL_EVENT_QUIT)
+            MPROFILE_ZONE("poll events");
+            while (SDL_PollEvent(&event)) // Events Loop: Poll for events
             {
-                quit = true; // Set the quit flag to true
-            }
-            // Check if a key is pressed
-            else if (event.type == SDL_EVENT_KEY_DOWN)
-            {
-                if (event.key.key == SDLK_UP || event.key.key == SDLK_DOWN || event.key.key == SDLK_LEFT || event.key.key == SDLK_RIGHT)
+                // Check if the quit event is triggered
+                if (event.type == SDL_EVENT_QUIT)
                 {
-                    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Key pressed: %s\n", SDL_GetKeyName(event.key.key));
-
-                    // Set the texture based on the key pressed
-                    if (!checkMediaAvailability(texture, pRenderer, event.key.key))
+                    quit = true; // Set the quit flag to true
+                }
+                // Check if a key is pressed
+                else if (event.type == SDL_EVENT_KEY_DOWN)
+                {
+                    if (event.key.key == SDLK_UP || event.key.key == SDLK_DOWN || event.key.key == SDLK_LEFT || event.key.key == SDLK_RIGHT)
                     {
-                        exit_code = 2; // Exit if media availability check fails
-                        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Media availability check failed.\n");
+                        MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Key pressed: %s\n", SDL_GetKeyName(event.key.key));
+
+                        // Set the texture based on the key pressed
+                        if (!checkMediaAvailability(cache, texture, pRenderer, event.key.key))
+                        {
+                            exit_code = 2; // Exit if media availability check fails
+                            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Media availability check failed.\n");
+                        }
+                        redraw = true; // Render the texture at the center of the screen once the events are handled
                     }
+                    else
+                    {
+                        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unsupported key pressed: %s\n", SDL_GetKeyName(event.key.key));
+                    }
+                }
+            }
+        }
 
-                    // Set the default background color to white
-                    SDL_SetRenderDrawColor(pRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-                    SDL_RenderClear(pRenderer);
-
-                    // Render the texture at the center of the screen
-                    texture.renderTexture((SCREEN_WIDTH - texture.getWidth()) / 2.0f, (SCREEN_HEIGHT - texture.getHeight()) / 2.0f, pRenderer);
+        // Upload the textures decoded in the background (one per frame) and redraw once one is ready: the upload is part of the frame it delays
+        {
+            MPROFILE_ZONE("upload textures");
+            if (cache.update(loader, pRenderer) > 0)
+            {
+                MAllocTracker::expectAllocations(); // An upload creates a texture: a loading frame is not a steady-state one
+                redraw = true;
 
-                    // Present the rendered content to the window
-                    SDL_RenderPresent(pRenderer);
-                }
-                else
+                // Watch the file of the texture just uploaded
+                if (watcher.isStarted())
                 {
-                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unsupported key pressed: %s\n", SDL_GetKeyName(event.key.key));
+                    watchLoadedTextures(cache, watcher, watched);
                 }
             }
+
+            // Swap in a texture whose file was saved, decoded by the watcher's worker: the holders of the texture see the new pixels at once
+            if (watcher.update(pRenderer) > 0)
+            {
+                MAllocTracker::expectAllocations(); // A reload creates a texture too
+                redraw = true;
+            }
+        }
+
+        if (redraw && !quit)
+        {
+            renderFrame(cache, texture, pRenderer);
         }
     }
 
+    // Report how many frames allocated on the heap (in strict mode the steady-state ones were logged as they happened)
+    if (MALLOC_TRACKER_ENABLED)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames that allocated: %llu of %llu (at most %llu allocations), steady-state violations: %llu\n", (unsigned long long)MAllocTracker::getAllocatingFrames(),
+                    (unsigned long long)MAllocTracker::getFrameCount(), (unsigned long long)MAllocTracker::getMaxFrameAllocations(), (unsigned long long)MAllocTracker::getViolationCount());
+    }
+
     // Clean up
-    cleanup(pWindow, pRenderer, &texture);
+    texture = nullptr;
+    cleanup(pWindow, pRenderer, &cache, &loader, &watcher);
 
     // Return the exit code: 0 for success, non-zero for failure
     return exit_code;
@@ -0,0 +1,133 @@
+#include "MTextureCache03.hpp"
+#include "MLog.hpp"
+
+// TextureCache's destructor cleans up the cached textures
+MTextureCache::~MTextureCache() { clear(); }
+
+// ############################################################################################
+// TextureCache's acquire function returns a shared handle to the texture loaded from a file (a hit does not allocate)
+std::shared_ptr<MTexture> MTextureCache::acquire(const std::string_view file_path, SDL_Renderer *renderer)
+{
+    // Serve the texture from memory if it has already been loaded
+    if (auto it = textures.find(file_path); it != textures.end())
+    {
+        this->hits++;
+        return it->second;
+    }
+
+    // The texture is not cached yet: load it from disk once
+    this->misses++;
+    auto texture = std::make_shared<MTexture>();
+    if (!texture->loadTexture(file_path, renderer))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to cache texture from %.*s\n", (int)file_path.size(), file_path.data());
+        return nullptr; // Failed loads are not cached so they can be retried
+    }
+
+    textures.emplace(std::string{file_path}, texture);
+    MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Texture cached from %.*s.\n", (int)file_path.size(), file_path.data());
+
+    return texture;
+}
+
+// ############################################################################################
+// TextureCache's acquireAsync function returns a shared handle that is filled when the worker threads finish loading
+std::shared_ptr<MTexture> MTextureCache::acquireAsync(const std::string_view file_path, MAsyncLoader &loader)
+{
+    // Serve the texture from memory if it has already been requested
+    if (auto it = textures.find(file_path); it != textures.end())
+    {
+        this->hits++;
+        return it->second;
+    }
+
+    // The texture is not cached yet: decode it on a worker thread and hand out an empty texture meanwhile
+    this->misses++;
+    std::shared_ptr<MAsyncLoad> load = loader.request(file_path);
+    if (load->state == MAsyncLoad::FAILED)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to queue texture load from %.*s\n", (int)file_path.size(), file_path.data());
+        return nullptr; // Failed loads are not cached so they can be retried (e.g. once the loader is started)
+    }
+    auto texture = std::make_shared<MTexture>();
+    textures.emplace(std::string{file_path}, texture);
+    loading.emplace(std::move(load), texture);
+
+    return texture;
+}
+
+// ############################################################################################
+// TextureCache's find function looks a texture up without touching the statistics
+std::shared_ptr<MTexture> MTextureCache::find(const std::string_view file_path) const
+{
+    auto it = textures.find(file_path);
+    return it != textures.end() ? it->second : nullptr;
+}
+
+// ############################################################################################
+// TextureCache's update function uploads the surfaces decoded by the worker threads
+int MTextureCache::update(MAsyncLoader &loader, SDL_Renderer *renderer, const int max_uploads)
+{
+    int uploads{0};
+
+    while (uploads < max_uploads)
+    {
+        std::shared_ptr<MAsyncLoad> load = loader.popCompleted();
+        if (load == nullptr)
+        {
+            break; // Nothing else is ready this frame
+        }
+
+        auto it = loading.find(load);
+        if (it == loading.end())
+        {
+            continue; // The cache was cleared while the load was in flight
+        }
+        std::shared_ptr<MTexture> texture = it->second;
+        loading.erase(it);
+
+        // Upload the decoded surface: this is the only step that runs on the render thread
+        SDL_Surface *decoded_surface = load->takeSurface();
+        if (load->state != MAsyncLoad::DECODED || !texture->loadTexture(decoded_surface, renderer))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to cache texture from %s\n", load->file_path.c_str());
+            textures.erase(load->file_path); // Failed loads are not cached so they can be retried
+        }
+        SDL_DestroySurface(decoded_surface);
+        uploads++;
+    }
+
+    return uploads;
+}
+
+// ############################################################################################
+// TextureCache's createPlaceholder function creates a small light gray texture
+bool MTextureCache::createPlaceholder(SDL_Renderer *renderer)
+{
+    SDL_Surface *placeholder_surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+    if (placeholder_surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create placeholder surface: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_FillSurfaceRect(placeholder_surface, nullptr, SDL_MapSurfaceRGB(placeholder_surface, 0xC0, 0xC0, 0xC0));
+
+    const bool success = placeholder.loadTexture(placeholder_surface, renderer);
+    SDL_DestroySurface(placeholder_surface);
+    return success;
+}
+
+// ############################################################################################
+// TextureCache's clear function releases every cached texture
+void MTextureCache::clear()
+{
+    // Clear the texture resources even if a handle is still held elsewhere
+    for (auto &[file_path, texture] : textures)
+    {
+        texture->clear();
+    }
+    textures.clear();
+    loading.clear();
+    placeholder.clear();
+}
+// ############################################################################################
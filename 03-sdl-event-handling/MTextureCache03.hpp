@@ -0,0 +1,58 @@
+#pragma once
+
+#include "MTexture.hpp"
+#include "MAsyncLoader.hpp"
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+class MTextureCache
+{
+private:
+    // Hash of the file paths that also takes views: a lookup with a literal path does not build a std::string
+    struct PathHash
+    {
+        using is_transparent = void;
+        inline size_t operator()(const std::string_view file_path) const { return std::hash<std::string_view>{}(file_path); }
+    };
+
+    std::unordered_map<std::string, std::shared_ptr<MTexture>, PathHash, std::equal_to<>> textures; // Loaded textures keyed by file path
+    std::unordered_map<std::shared_ptr<MAsyncLoad>, std::shared_ptr<MTexture>> loading;            // Textures waiting for an async load to finish (the key keeps the load alive)
+    MTexture placeholder;                                                                          // Texture rendered while a texture is still loading
+    Uint64 hits;                                                                                   // Number of requests served from memory
+    Uint64 misses;                                                                                 // Number of requests that had to load from disk
+
+public:
+    // Constructor to initialize the counters
+    MTextureCache() : hits(0), misses(0) {};
+
+    // Destructor to clean up the cached textures
+    ~MTextureCache();
+
+    // Function to get the texture for a file path, loading it only the first time it is requested
+    std::shared_ptr<MTexture> acquire(const std::string_view file_path, SDL_Renderer *renderer);
+
+    // Function to get the texture for a file path without blocking: a new texture stays empty until update uploads it (nullptr if the load cannot be queued)
+    std::shared_ptr<MTexture> acquireAsync(const std::string_view file_path, MAsyncLoader &loader);
+
+    // Function to get a texture already requested without loading it nor counting a hit: nullptr if it was never requested or failed to load
+    std::shared_ptr<MTexture> find(const std::string_view file_path) const;
+
+    // Function to upload the textures decoded by the loader (render thread only), at most max_uploads per call
+    int update(MAsyncLoader &loader, SDL_Renderer *renderer, const int max_uploads = 1);
+
+    // Function to create the placeholder texture shown while a texture is loading
+    bool createPlaceholder(SDL_Renderer *renderer);
+
+    // Function to get the texture to render: the placeholder while the texture is still loading
+    inline MTexture &resolve(const std::shared_ptr<MTexture> &texture) { return texture != nullptr && texture->isLoaded() ? *texture : placeholder; }
+
+    // Function to clear every cached texture (must be called before the renderer is destroyed)
+    void clear();
+
+    // Getters for the cache statistics inline for efficiency
+    inline const Uint64 getHits() const { return hits; }                   // Getter for the number of cache hits
+    inline const Uint64 getMisses() const { return misses; }               // Getter for the number of cache misses
+    inline const size_t getSize() const { return textures.size(); }        // Getter for the number of cached textures
+    inline const size_t getLoadingCount() const { return loading.size(); } // Getter for the number of textures still loading
+};
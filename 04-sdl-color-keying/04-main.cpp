@@ -1,14 +1,28 @@
-#include "MTexture04.hpp"
+#include "MTexture.hpp"
+#include "MScene04.hpp"
+#include "MProfiler.hpp"
+#include "MAllocTracker.hpp"
 #include <iostream>
 
 // Constants for screen dimensions and window title
 constexpr int SCREEN_WIDTH{640};
 constexpr int SCREEN_HEIGHT{480};
 constexpr const char *WINDOW_TITLE{"SDL3 Tutorial 04: Color Keying Example"};
+constexpr bool SHOW_PROFILER_OVERLAY{true};                    // Draw the p50/p99 frame time and the zones of the last frame in the corner
+constexpr const char *PROFILER_TRACE_FILE{"../trace-04.json"}; // Chrome trace of the last frames, written on exit (nullptr to skip it)
+constexpr bool CHECK_FRAME_ALLOCATIONS{true};                  // Log every steady-state frame that allocates on the heap (the tracker is compiled out of NDEBUG builds)
 
 // Function to initialize SDL and create a window
 bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
 {
+    // Count SDL's heap allocations from the first one: its memory functions cannot be replaced once it has allocated
+    // The blocks SDL frees are pooled, so that each decode takes the blocks of the previous one back instead of the system allocator
+    MAllocTracker::install();
+    MAllocTracker::setPooling(true);
+
+    // Profile this thread, the render thread, from now on: the texture loads are recorded in the first frame
+    MProfiler::start();
+
     // Initialize SDL3
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -30,12 +44,26 @@ bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
 }
 
 // Function to clean up SDL resources
-void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *bg_texture, MTexture *foo_texture)
+void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *bg_texture, MTexture *foo_texture, MSurfaceArena &arena)
 {
+    // Report how many image files were decoded during the whole run
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Image files decoded: %llu\n", (unsigned long long)MTexture::getLoadCount());
+
+    // Write the profile of the last frames (open it in chrome://tracing or ui.perfetto.dev)
+    if (MPROFILER_ENABLED && PROFILER_TRACE_FILE != nullptr && MProfiler::exportTrace(PROFILER_TRACE_FILE))
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frame time p50 %.2f ms, p99 %.2f ms, trace written to %s\n", MProfiler::getFrameTimePercentile(50.0), MProfiler::getFrameTimePercentile(99.0), PROFILER_TRACE_FILE);
+    }
 
-    // Clear the texture resources
+    // Report how many pixels the background swap uploaded, out of the whole background
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Streaming texture pixels uploaded: %llu (background: %d)\n", (unsigned long long)MTexture::getUploadedPixels(),
+                (int)(bg_texture->getWidth() * bg_texture->getHeight()));
+
+    // Clear the texture resources and the surfaces kept in the arena
     bg_texture->clear();
     foo_texture->clear();
+    arena.releaseAll();
+    arena.trim();
 
     // Destroy the renderer
     SDL_DestroyRenderer(pRenderer);
@@ -56,35 +84,46 @@ void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *bg_textur
 }
 
 // Function to check media availability (textures, sounds, etc.)
-bool checkMediaAvailability(MTexture &bg_texture, MTexture &foo_texture, SDL_Renderer *&pRenderer, bool &remove_background_from_sprite)
+bool checkMediaAvailability(MTexture &bg_texture, SDL_Surface *&bg_swap_surface, SDL_Rect &bg_swap_rect, MTexture &foo_texture, MSurfaceArena &arena, SDL_Renderer *&pRenderer)
 {
     bool success{true};
 
-    if (!remove_background_from_sprite)
+    // Background shown while the sprite still has its cyan background, and background without text ("Press a key to remove background from sprite")
+    SDL_Surface *bg_surface = arena.load("../assets/04background0.png");
+    bg_swap_surface = arena.load("../assets/04background1.png");
+
+    // One streaming texture for both: the swap only uploads the pixels that differ (the text), the second surface is kept in the arena until then
+    if (bg_surface == nullptr || bg_swap_surface == nullptr || !bg_texture.loadStreaming(bg_surface, pRenderer))
     {
-        if (!bg_texture.loadTexture("../assets/04background0.png", pRenderer, remove_background_from_sprite))
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load background texture!\n");
-            success = false;
-        }
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load background texture!\n");
+        success = false;
+    }
+    else if (!MScene04::findChangedRect(bg_surface, bg_swap_surface, bg_swap_rect))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The two backgrounds differ in size or format!\n");
+        success = false;
     }
     else
     {
-        // Change background texture if remove_background_from_sprite is true.
-        // New texture without text: "Press a key to remove background from sprite"
-        if (!bg_texture.loadTexture("../assets/04background1.png", pRenderer, remove_background_from_sprite))
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load background texture with color key!\n");
-            success = false;
-        }
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Background swap region: %dx%d at (%d, %d).\n", bg_swap_rect.w, bg_swap_rect.h, bg_swap_rect.x, bg_swap_rect.y);
     }
+    arena.release(bg_surface);
 
-    if (!foo_texture.loadTexture("../assets/04sprite.png", pRenderer, remove_background_from_sprite))
+    // Keep the sprite with and without its cyan background (0x00, 0xFF, 0xFF), so the key can be toggled at runtime
+    const SDL_Color cyan{0x00, 0xFF, 0xFF, 0xFF};
+    if (!foo_texture.loadTexture("../assets/04sprite.png", pRenderer, arena, &cyan, true))
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load sprite texture!\n");
         success = false;
     }
 
+    // The textures are uploaded: the sprite reused the buffers given back so far, the second background stays in the arena until the swap
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Surface arena: %llu buffers allocated, %llu reused, %llu bytes reserved.\n", (unsigned long long)arena.getSystemAllocations(),
+                (unsigned long long)arena.getReuses(), (unsigned long long)arena.getReservedBytes());
+
+    // The loading phase is over: the decode blocks left in the pool go back to the system
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "SDL allocation pool: %llu allocations served, %llu bytes trimmed.\n", (unsigned long long)MAllocTracker::getPoolReuses(),
+                (unsigned long long)MAllocTracker::trimPool());
     return success;
 }
 
@@ -94,9 +133,13 @@ int main()
     SDL_Window *pWindow{nullptr};
     SDL_Renderer *pRenderer{nullptr};
 
-    // The texture to be rendered
-    MTexture bg_texture{};
+    // The textures to be rendered: the background and the sprite are loaded only once
+    MTexture bg_texture{};                                                // Streaming texture: the background swap rewrites the changed pixels in place
+    SDL_Surface *bg_swap_surface{};                                       // Pixels of the second background, owned by the arena
+    SDL_Rect bg_swap_rect{};                                              // Rectangle where the two backgrounds differ
     MTexture foo_texture{};
+    MSurfaceArena arena{};                                                // Arena the images are decoded into
+    MScene04 scene(bg_texture, foo_texture, SCREEN_WIDTH, SCREEN_HEIGHT); // The composited scene, replayed from its cached layer with a single draw
 
     bool quit = {false}; // Flag to indicate when the application should exit
     int exit_code = {0}; // Exit code
@@ -108,52 +151,84 @@ int main()
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Initialization failed.\n");
     }
 
+    // Load every texture before entering the main loop
+    if (!checkMediaAvailability(bg_texture, bg_swap_surface, bg_swap_rect, foo_texture, arena, pRenderer))
+    {
+        exit_code = 2; // Exit if media availability check fails
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Media availability check failed.\n");
+    }
+    scene.setBackgroundSwap(bg_swap_surface, bg_swap_rect);
+
     // Create an event structure to handle events
     SDL_Event event;
     SDL_zero(event); // Initialize the event structure
 
     bool remove_background_from_sprite = false; // Flag to indicate if the background should be removed
 
+    // Every frame after the first one (which grows the draw buffers) must draw without allocating
+    MAllocTracker::setStrict(CHECK_FRAME_ALLOCATIONS, 1);
+
     // Main loop: keep running until the quit flag is set
     while (!quit)
     {
-        while (SDL_PollEvent(&event)) // Events Loop: Poll for events
+        // The frame time is measured from the start of the iteration that renders, idle iterations are not counted
+        MProfiler::beginFrame();
+        MAllocTracker::beginFrame();
+        bool redraw{false}; // Flag to indicate that an event changed what is on screen
+
         {
-            // Check if the quit event is triggered
-            if (event.type == SDL_EVENT_QUIT)
-            {
-                quit = true; // Set the quit flag to true
-            }
-            else
+            MPROFILE_ZONE("poll events");
+            while (SDL_PollEvent(&event)) // Events Loop: Poll for events
             {
-                if (event.type == SDL_EVENT_KEY_DOWN) // Check if a key is pressed
+                // Check if the quit event is triggered
+                if (event.type == SDL_EVENT_QUIT)
                 {
-                    remove_background_from_sprite = true; // Set the flag to remove background
+                    quit = true; // Set the quit flag to true
                 }
-
-                // Set the texture based on the key pressed
-                if (!checkMediaAvailability(bg_texture, foo_texture, pRenderer, remove_background_from_sprite))
+                else
                 {
-                    exit_code = 2; // Exit if media availability check fails
-                    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Media availability check failed.\n");
+                    scene.handleEvent(event, remove_background_from_sprite); // A key press removes the background from the sprite
+                    redraw = true; // Every other event is answered with one frame, after the events pending are handled
                 }
+            }
+        }
 
-                // Set the default background color to white (inline color setting)
-                SDL_SetRenderDrawColor(pRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-                SDL_RenderClear(pRenderer);
+        if (redraw && !quit)
+        {
+            // Toggle the color key, swap the background once, and draw the cached layer (composited again when the key state changed)
+            scene.render(pRenderer, remove_background_from_sprite);
 
-                // Render the texture at the center of the screen
-                bg_texture.renderTexture(0, 0, pRenderer);
-                foo_texture.renderTexture((SCREEN_WIDTH - foo_texture.getWidth()) / 2, (SCREEN_HEIGHT - foo_texture.getHeight()) / 2, pRenderer);
+            // Draw the profiler statistics of the previous frames on top (the draw state is restored afterwards)
+            if (SHOW_PROFILER_OVERLAY)
+            {
+                MProfiler::renderOverlay(pRenderer, 8.f, 8.f);
+            }
+
+            {
+                MPROFILE_ZONE("present");
 
                 // Present the rendered content to the window
                 SDL_RenderPresent(pRenderer);
             }
+            MProfiler::endFrame();
+            MAllocTracker::endFrame();
         }
     }
 
+    // Report how many draws were queued and how many SDL draw calls they needed
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Draws queued: %llu, draw calls issued: %llu\n", (unsigned long long)scene.getQueue().getCommandsSubmitted(), (unsigned long long)scene.getDrawCalls());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Layer renders: %llu, layer replays: %llu\n", (unsigned long long)scene.getLayers().getRenders(), (unsigned long long)scene.getLayers().getReplays());
+
+    // Report how many frames allocated on the heap (in strict mode the steady-state ones were logged as they happened)
+    if (MALLOC_TRACKER_ENABLED)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames that allocated: %llu of %llu (at most %llu allocations), steady-state violations: %llu\n", (unsigned long long)MAllocTracker::getAllocatingFrames(),
+                    (unsigned long long)MAllocTracker::getFrameCount(), (unsigned long long)MAllocTracker::getMaxFrameAllocations(), (unsigned long long)MAllocTracker::getViolationCount());
+    }
+
     // Clean up
-    cleanup(pWindow, pRenderer, &bg_texture, &foo_texture);
+    scene.clear(); // The layer textures belong to the renderer: destroy them first
+    cleanup(pWindow, pRenderer, &bg_texture, &foo_texture, arena);
 
     // Return the exit code: 0 for success, non-zero for failure
     return exit_code;
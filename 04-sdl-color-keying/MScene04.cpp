@@ -0,0 +1,106 @@
+#include "MScene04.hpp"
+#include "MProfiler.hpp"
+
+// ############################################################################################
+// Scene04's constructor keeps the textures to draw, without a background swap
+MScene04::MScene04(MTexture &background, MTexture &sprite, const int width, const int height)
+    : background(background), sprite(sprite), swap_surface(nullptr), swap_rect{0, 0, 0, 0}, background_swapped(false), width(width), height(height)
+{
+}
+
+// ############################################################################################
+// Scene04's setBackgroundSwap function keeps the second background until the key is removed
+void MScene04::setBackgroundSwap(SDL_Surface *surface, const SDL_Rect &rect)
+{
+    this->swap_surface = surface;
+    this->swap_rect = rect;
+    this->background_swapped = false;
+}
+
+// ############################################################################################
+// Scene04's handleEvent function updates the key state and the cached layer for an event
+void MScene04::handleEvent(const SDL_Event &event, bool &remove_background)
+{
+    if (event.type == SDL_EVENT_KEY_DOWN) // Check if a key is pressed
+    {
+        remove_background = true; // Set the flag to remove background
+    }
+    this->layers.handleEvent(event); // A render device reset loses the content of the cached layer
+}
+
+// ############################################################################################
+// Scene04's render function records the draws of the frame and flushes them
+void MScene04::render(SDL_Renderer *renderer, const bool remove_background)
+{
+    {
+        MPROFILE_ZONE("record draws");
+
+        // Toggle the color key of the resident sprite texture: no file is decoded here
+        this->sprite.setColorKey(remove_background);
+
+        // Swap the background once, by uploading only the rectangle that differs into the streaming texture
+        if (remove_background && !this->background_swapped && this->swap_surface != nullptr)
+        {
+            this->background.markDirty(this->swap_rect);
+            this->background.uploadDirty(this->swap_surface);
+            this->background_swapped = true;
+        }
+
+        // Composite the scene into the cached layer, cleared to white, only when the key state changed since it was rendered
+        if (this->layers.beginLayer(renderer, SCENE_LAYER, remove_background ? 1 : 0, this->width, this->height, SDL_Color{0xFF, 0xFF, 0xFF, 0xFF}))
+        {
+            // Queue the background on layer 0 and the sprite at the center of the screen on layer 1, above it
+            this->queue.add(this->background, 0, 0, 0);
+            this->queue.add(this->sprite, (this->width - this->sprite.getWidth()) / 2, (this->height - this->sprite.getHeight()) / 2, 1);
+            this->queue.flush(renderer);
+            this->layers.endLayer(renderer);
+        }
+
+        // Queue the cached layer: it covers the whole window, so no clear is needed
+        this->layers.add(this->queue, SCENE_LAYER, 0.f, 0.f);
+    }
+
+    {
+        MPROFILE_ZONE("clear and draw");
+
+        // Issue the single draw of the cached layer
+        this->queue.flush(renderer);
+    }
+}
+
+// ############################################################################################
+// Scene04's findChangedRect function compares the pixels row by row and keeps the bounding box of the differences
+bool MScene04::findChangedRect(const SDL_Surface *before, const SDL_Surface *after, SDL_Rect &changed_rect)
+{
+    // The rows of both surfaces are read as 32-bit pixels with the size of the second one: they must have the same size and format
+    changed_rect = SDL_Rect{0, 0, 0, 0};
+    if (before == nullptr || after == nullptr || before->pixels == nullptr || after->pixels == nullptr || before->w != after->w || before->h != after->h ||
+        before->format != after->format || SDL_BYTESPERPIXEL(after->format) != 4)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to compare surfaces: they must be 32-bit surfaces of the same size and format\n");
+        return false;
+    }
+
+    int min_x{after->w}, min_y{after->h}, max_x{-1}, max_y{-1};
+    for (int y = 0; y < after->h; y++)
+    {
+        const Uint32 *row_before = (const Uint32 *)((const Uint8 *)before->pixels + (size_t)y * before->pitch);
+        const Uint32 *row_after = (const Uint32 *)((const Uint8 *)after->pixels + (size_t)y * after->pitch);
+        for (int x = 0; x < after->w; x++)
+        {
+            if (row_before[x] != row_after[x])
+            {
+                min_x = SDL_min(min_x, x);
+                max_x = SDL_max(max_x, x);
+                min_y = SDL_min(min_y, y);
+                max_y = y;
+            }
+        }
+    }
+    if (max_x >= 0)
+    {
+        changed_rect = SDL_Rect{min_x, min_y, max_x - min_x + 1, max_y - min_y + 1};
+    }
+    return true;
+}
+// ############################################################################################
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MTexture.hpp"
+#include "MRenderQueue.hpp"
+#include "MLayerCache.hpp"
+
+// Frame of tutorial 04: the background and the color keyed sprite composited into a cached layer, replayed with a single draw
+// Shared by 04-main.cpp and benchmarks/bench-scenes.cpp, so that the benchmark measures the frames the tutorial draws
+class MScene04
+{
+public:
+    static constexpr int SCENE_LAYER{0}; // Cached layer holding the background and the sprite, composited when the key state changes
+
+private:
+    MTexture &background;      // Streaming texture of the background (owned by the caller)
+    MTexture &sprite;          // Sprite with both color key variants (owned by the caller)
+    SDL_Surface *swap_surface; // Pixels of the second background (owned by the caller), nullptr without a swap
+    SDL_Rect swap_rect;        // Rectangle where the two backgrounds differ
+    bool background_swapped;   // Flag set once the second background is uploaded
+    int width;                 // Width of the window
+    int height;                // Height of the window
+    MRenderQueue queue;        // Queue that records the draws of a frame until they are flushed
+    MLayerCache layers;        // Cache of the composited scene
+
+public:
+    // Constructor to draw the textures into a window of the given size
+    MScene04(MTexture &background, MTexture &sprite, const int width, const int height);
+
+    // Function to set the second background, uploaded in place into the background texture the first time the key is removed
+    void setBackgroundSwap(SDL_Surface *surface, const SDL_Rect &rect);
+
+    // Function to handle an event of the tutorial loop (other than quit): a key press removes the background from the sprite, a render device
+    // reset loses the content of the cached layer, and every other event (mouse motion included) changes nothing and loads no file
+    void handleEvent(const SDL_Event &event, bool &remove_background);
+
+    // Function to draw the frame (without presenting it): the layer is composited again only when the key state changed
+    void render(SDL_Renderer *renderer, const bool remove_background);
+
+    // Function to destroy the layer textures (before the renderer they belong to)
+    inline void clear() { layers.clear(); }
+
+    // Function to find the bounding box of the pixels that differ between two surfaces (empty when they are equal): returns false when
+    // they cannot be compared, i.e. they are not 32-bit surfaces of the same size and format
+    static bool findChangedRect(const SDL_Surface *before, const SDL_Surface *after, SDL_Rect &changed_rect);
+
+    // Getters for the scene state inline for efficiency
+    inline const MRenderQueue &getQueue() const { return queue; }                                   // Getter for the queue statistics
+    inline const MLayerCache &getLayers() const { return layers; }                                  // Getter for the layer statistics
+    inline const Uint64 getDrawCalls() const { return queue.getDrawCalls() + layers.getRenders(); } // Getter for the SDL draw calls (queued draws and layer clears)
+};
@@ -1,14 +1,23 @@
-#include "MTexture05.hpp"
+#include "MTexture.hpp"
+#include "MRenderScheduler.hpp"
+#include "MAtlasPacker.hpp"
+#include "MScene05.hpp"
+#include "MAllocTracker.hpp"
 #include <iostream>
 
 // Constants for screen dimensions and window title
 constexpr int SCREEN_WIDTH{640};
 constexpr int SCREEN_HEIGHT{480};
 constexpr const char *WINDOW_TITLE{"SDL3 Tutorial 05: Clipping and Stretching Example"};
+constexpr int TARGET_FPS{0};                  // Frame rate of the fixed-rate mode (0 = redraw only when something changes)
+constexpr bool CHECK_FRAME_ALLOCATIONS{true}; // Log every steady-state frame that allocates on the heap (the tracker is compiled out of NDEBUG builds)
 
 // Function to initialize SDL and create a window
 bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
 {
+    // Count SDL's heap allocations from the first one: its memory functions cannot be replaced once it has allocated
+    MAllocTracker::install();
+
     // Initialize SDL3
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -55,48 +64,52 @@ void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *texture)
 }
 
 // Function to check media availability (textures, sounds, etc.)
-bool checkMediaAvailability(MTexture &texture, SDL_Renderer *&pRenderer)
+bool checkMediaAvailability(MTexture &texture, MAtlasRegion &sheet, SDL_Renderer *&pRenderer)
 {
     bool success{true};
 
-    if (!texture.loadTexture("../assets/05dots.png", pRenderer))
+    // Pack the sprite sheet into an atlas page, keying out white (0xFF, 0xFF, 0xFF)
+    MAtlasPacker atlas{512};
+    const SDL_Color white_key{0xFF, 0xFF, 0xFF, 0xFF};
+    if (!atlas.addImage("../assets/05dots.png", &white_key) || !atlas.pack())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to pack sprite sheet into the atlas!\n");
+        return false;
+    }
+    const MAtlasRegion *sheet_region = atlas.findRegion("../assets/05dots.png");
+    if (sheet_region == nullptr)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load background texture with color key!\n");
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to find the sprite sheet in the atlas!\n");
+        return false;
+    }
+    sheet = *sheet_region;
+
+    // Upload the atlas page as the texture: the sprites are clipped from the sheet region
+    if (!texture.loadTexture(atlas.getPage(sheet.page), pRenderer))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load atlas page texture!\n");
         success = false;
     }
 
     return success;
 }
 
-void clipTexture(float sprite_pos_x, float sprite_pos_y, const float SPRITE_SIZE, float pos_x, float pos_y, MTexture &texture, SDL_Renderer *&pRenderer)
-{
-    // Initialize the clip rectangle with the specified dimensions for clipping
-    SDL_FRect clipRect{sprite_pos_x, sprite_pos_y, SPRITE_SIZE, SPRITE_SIZE};
-
-    // Render the texture at the specified position with the clip rectangle
-    texture.renderTexture(pos_x, pos_y, pRenderer, &clipRect);
-}
-
-void stretchTexture(float sprite_pos_x, float sprite_pos_y, const float SPRITE_SIZE, float pos_x, float pos_y, float stretch_w, float stretch_h, MTexture &texture, SDL_Renderer *&pRenderer)
-{
-    // Initialize the clip rectangle with the specified dimensions for clipping
-    SDL_FRect clipRect{sprite_pos_x, sprite_pos_y, SPRITE_SIZE, SPRITE_SIZE};
-
-    // Render the texture at the specified position with the clip rectangle
-    texture.renderTexture(pos_x, pos_y, stretch_w, stretch_h, pRenderer, &clipRect);
-}
-
 int main()
 {
     // Declare pointers for the window and renderer
     SDL_Window *pWindow{nullptr};
     SDL_Renderer *pRenderer{nullptr};
 
-    MTexture texture{}; // The texture to be rendered
+    MTexture texture{};                          // The texture to be rendered
+    MAtlasRegion sheet{};                        // The region of the atlas page that holds the sprite sheet
+    MScene05 scene(SCREEN_WIDTH, SCREEN_HEIGHT); // The frame: the cached layer of the sprites and the queue that draws it
 
     SDL_Event event; // Create an event structure to handle events
     SDL_zero(event); // Initialize the event structure
 
+    MRenderScheduler scheduler{}; // Scheduler that decides when a frame has to be redrawn
+    scheduler.setFixedRate(TARGET_FPS);
+
     bool quit = {false}; // Flag to indicate when the application should exit
     int exit_code = {0}; // Exit code
 
@@ -111,7 +124,7 @@ int main()
     else
     {
         // Check if the media loading is successful
-        if (!checkMediaAvailability(texture, pRenderer))
+        if (!checkMediaAvailability(texture, sheet, pRenderer))
         {
             exit_code = 2; // Exit if media availability check fails
             quit = true;   // Set quit flag to true
@@ -120,88 +133,64 @@ int main()
         }
         else
         {
+            // Every frame after the first one (which grows the draw buffers) must draw without allocating
+            MAllocTracker::setStrict(CHECK_FRAME_ALLOCATIONS, 1);
+
             // Main loop: keep running until the quit flag is set
             while (!quit)
             {
-                while (SDL_PollEvent(&event)) // Events Loop: Poll for events
+                // Allocations are counted from the start of the iteration that presents, idle iterations are not counted
+                MAllocTracker::beginFrame();
+
+                // Wait for the next event: blocks while nothing has to be redrawn
+                if (scheduler.waitEvent(&event))
                 {
-                    // Check if the quit event is triggered
-                    if (event.type == SDL_EVENT_QUIT)
+                    do // Events Loop: handle the event and any other pending one
                     {
-                        quit = true; // Set quit flag to true
-                    }
+                        // Window events (expose, resize, ...) always require a redraw
+                        scheduler.handleEvent(event);
+
+                        // A render device reset loses the content of the cached layer
+                        scene.handleEvent(event);
+
+                        // Check if the quit event is triggered
+                        if (event.type == SDL_EVENT_QUIT)
+                        {
+                            quit = true; // Set quit flag to true
+                        }
+                    } while (SDL_PollEvent(&event));
+                }
+
+                // Skip the frame if nothing changed since the last present
+                if (!scheduler.shouldRender())
+                {
+                    continue;
                 }
 
-                // Set the default background color to white (inline color setting)
-                SDL_SetRenderDrawColor(pRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-                SDL_RenderClear(pRenderer);
-
-                constexpr float SPRITE_SIZE = 100.f;
-                float sprite_pos_x = 0.f; // Sprite position X
-                float sprite_pos_y = 0.f; // Sprite position Y
-                float rect_pos_x = 0.f;   // Rectangle position X
-                float rect_pos_y = 0.f;   // Rectangle position Y
-                float stretch_w = 0.f;    // Stretch width
-                float stretch_h = 0.f;    // Stretch height
-
-                // Top-left sprite without stretching
-                sprite_pos_x = 0.f; // Sprite position X
-                sprite_pos_y = 0.f; // Sprite position Y
-                rect_pos_x = 0.f;   // Rectangle position X
-                rect_pos_y = 0.f;   // Rectangle position Y
-                clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, texture, pRenderer);
-                // Top-left sprite with stretching
-                stretch_w = SPRITE_SIZE * 0.5; // Stretch width
-                stretch_h = SPRITE_SIZE * 1.0; // Stretch height
-                rect_pos_x = 0.f;              // Rectangle position X
-                rect_pos_y = stretch_h;        // Rectangle position Y
-                stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, texture, pRenderer);
-
-                // Top-right sprite without stretching
-                sprite_pos_x = SPRITE_SIZE;              // Sprite position X
-                sprite_pos_y = 0.f;                      // Sprite position Y
-                rect_pos_x = SCREEN_WIDTH - SPRITE_SIZE; // Rectangle position X
-                rect_pos_y = 0.f;                        // Rectangle position Y
-                clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, texture, pRenderer);
-                // Top-right sprite with stretching
-                stretch_w = SPRITE_SIZE * 0.5;         // Stretch width
-                stretch_h = SPRITE_SIZE * 1.0;         // Stretch height
-                rect_pos_x = SCREEN_WIDTH - stretch_w; // Rectangle position X
-                rect_pos_y = stretch_h;                // Rectangle position Y
-                stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, texture, pRenderer);
-
-                // Bottom-left sprite without stretching
-                sprite_pos_x = 0.f;                       // Sprite position X
-                sprite_pos_y = SPRITE_SIZE;               // Sprite position Y
-                rect_pos_x = 0.f;                         // Rectangle position X
-                rect_pos_y = SCREEN_HEIGHT - SPRITE_SIZE; // Rectangle position Y
-                clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, texture, pRenderer);
-                // Bottom-left sprite with stretching
-                stretch_w = SPRITE_SIZE * 0.5;              // Stretch width
-                stretch_h = SPRITE_SIZE * 1.0;              // Stretch height
-                rect_pos_x = 0.f;                           // Rectangle position X
-                rect_pos_y = SCREEN_HEIGHT - 2 * stretch_h; // Rectangle position Y
-                stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, texture, pRenderer);
-
-                // Bottom-right sprite without stretching
-                sprite_pos_x = SPRITE_SIZE;               // Sprite position X
-                sprite_pos_y = SPRITE_SIZE;               // Sprite position Y
-                rect_pos_x = SCREEN_WIDTH - SPRITE_SIZE;  // Rectangle position X
-                rect_pos_y = SCREEN_HEIGHT - SPRITE_SIZE; // Rectangle position Y
-                clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, texture, pRenderer);
-                // Bottom-right sprite with stretching
-                stretch_w = SPRITE_SIZE * 0.5;              // Stretch width
-                stretch_h = SPRITE_SIZE * 1.0;              // Stretch height
-                rect_pos_x = SCREEN_WIDTH - stretch_w;      // Rectangle position X
-                rect_pos_y = SCREEN_HEIGHT - 2 * stretch_h; // Rectangle position Y
-                stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, texture, pRenderer);
+                // Draw the static sprites: rendered into the cached layer once, every later frame replays it with a single draw
+                scene.render(pRenderer, sheet, texture.getTexture());
 
                 // Present the rendered content to the window
                 SDL_RenderPresent(pRenderer);
+                MAllocTracker::endFrame();
             }
         }
     }
-    // Clean up
+
+    // Report how many frames were redrawn and how many were skipped
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames rendered: %llu, frames skipped: %llu\n", (unsigned long long)scheduler.getFramesRendered(), (unsigned long long)scheduler.getFramesSkipped());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Draws queued: %llu, draw calls issued: %llu\n", (unsigned long long)scene.getQueue().getCommandsSubmitted(), (unsigned long long)scene.getDrawCalls());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Layer renders: %llu, layer replays: %llu\n", (unsigned long long)scene.getLayers().getRenders(), (unsigned long long)scene.getLayers().getReplays());
+
+    // Report how many frames allocated on the heap (in strict mode the steady-state ones were logged as they happened)
+    if (MALLOC_TRACKER_ENABLED)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames that allocated: %llu of %llu (at most %llu allocations), steady-state violations: %llu\n", (unsigned long long)MAllocTracker::getAllocatingFrames(),
+                    (unsigned long long)MAllocTracker::getFrameCount(), (unsigned long long)MAllocTracker::getMaxFrameAllocations(), (unsigned long long)MAllocTracker::getViolationCount());
+    }
+
+    // Clean up (the layer textures belong to the renderer: destroy them first)
+    scene.clear();
     cleanup(pWindow, pRenderer, &texture);
 
     // Return the exit code: 0 for success, non-zero for failure
@@ -0,0 +1,106 @@
+#include "MScene05.hpp"
+
+// ############################################################################################
+// Function to queue a sprite clipped from the sheet at its original size
+static void clipTexture(float sprite_pos_x, float sprite_pos_y, const float SPRITE_SIZE, float pos_x, float pos_y, const MAtlasRegion &sheet, SDL_Texture *texture, MRenderQueue &queue)
+{
+    // Initialize the clip rectangle with the specified dimensions for clipping, inside the sheet region of the atlas
+    SDL_FRect clipRect{sheet.rect.x + sprite_pos_x, sheet.rect.y + sprite_pos_y, SPRITE_SIZE, SPRITE_SIZE};
+
+    // Queue the clipped sprite at the specified position with its original size
+    queue.add(texture, &clipRect, SDL_FRect{pos_x, pos_y, SPRITE_SIZE, SPRITE_SIZE});
+}
+
+// ############################################################################################
+// Function to queue a sprite clipped from the sheet, stretched to a size
+static void stretchTexture(float sprite_pos_x, float sprite_pos_y, const float SPRITE_SIZE, float pos_x, float pos_y, float stretch_w, float stretch_h, const MAtlasRegion &sheet, SDL_Texture *texture, MRenderQueue &queue)
+{
+    // Initialize the clip rectangle with the specified dimensions for clipping, inside the sheet region of the atlas
+    SDL_FRect clipRect{sheet.rect.x + sprite_pos_x, sheet.rect.y + sprite_pos_y, SPRITE_SIZE, SPRITE_SIZE};
+
+    // Queue the clipped sprite at the specified position with the stretched size
+    queue.add(texture, &clipRect, SDL_FRect{pos_x, pos_y, stretch_w, stretch_h});
+}
+
+// ############################################################################################
+// Function to queue the 8 static sprites of the scene: the 4 corners, each one clipped and stretched
+static void queueStaticSprites(const int width, const int height, const MAtlasRegion &sheet, SDL_Texture *texture, MRenderQueue &queue)
+{
+    constexpr float SPRITE_SIZE = 100.f;
+    float sprite_pos_x = 0.f; // Sprite position X
+    float sprite_pos_y = 0.f; // Sprite position Y
+    float rect_pos_x = 0.f;   // Rectangle position X
+    float rect_pos_y = 0.f;   // Rectangle position Y
+    float stretch_w = 0.f;    // Stretch width
+    float stretch_h = 0.f;    // Stretch height
+
+    // Top-left sprite without stretching
+    sprite_pos_x = 0.f; // Sprite position X
+    sprite_pos_y = 0.f; // Sprite position Y
+    rect_pos_x = 0.f;   // Rectangle position X
+    rect_pos_y = 0.f;   // Rectangle position Y
+    clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, sheet, texture, queue);
+    // Top-left sprite with stretching
+    stretch_w = SPRITE_SIZE * 0.5; // Stretch width
+    stretch_h = SPRITE_SIZE * 1.0; // Stretch height
+    rect_pos_x = 0.f;              // Rectangle position X
+    rect_pos_y = stretch_h;        // Rectangle position Y
+    stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, sheet, texture, queue);
+
+    // Top-right sprite without stretching
+    sprite_pos_x = SPRITE_SIZE;       // Sprite position X
+    sprite_pos_y = 0.f;               // Sprite position Y
+    rect_pos_x = width - SPRITE_SIZE; // Rectangle position X
+    rect_pos_y = 0.f;                 // Rectangle position Y
+    clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, sheet, texture, queue);
+    // Top-right sprite with stretching
+    stretch_w = SPRITE_SIZE * 0.5;  // Stretch width
+    stretch_h = SPRITE_SIZE * 1.0;  // Stretch height
+    rect_pos_x = width - stretch_w; // Rectangle position X
+    rect_pos_y = stretch_h;         // Rectangle position Y
+    stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, sheet, texture, queue);
+
+    // Bottom-left sprite without stretching
+    sprite_pos_x = 0.f;                // Sprite position X
+    sprite_pos_y = SPRITE_SIZE;        // Sprite position Y
+    rect_pos_x = 0.f;                  // Rectangle position X
+    rect_pos_y = height - SPRITE_SIZE; // Rectangle position Y
+    clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, sheet, texture, queue);
+    // Bottom-left sprite with stretching
+    stretch_w = SPRITE_SIZE * 0.5;       // Stretch width
+    stretch_h = SPRITE_SIZE * 1.0;       // Stretch height
+    rect_pos_x = 0.f;                    // Rectangle position X
+    rect_pos_y = height - 2 * stretch_h; // Rectangle position Y
+    stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, sheet, texture, queue);
+
+    // Bottom-right sprite without stretching
+    sprite_pos_x = SPRITE_SIZE;        // Sprite position X
+    sprite_pos_y = SPRITE_SIZE;        // Sprite position Y
+    rect_pos_x = width - SPRITE_SIZE;  // Rectangle position X
+    rect_pos_y = height - SPRITE_SIZE; // Rectangle position Y
+    clipTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, sheet, texture, queue);
+    // Bottom-right sprite with stretching
+    stretch_w = SPRITE_SIZE * 0.5;       // Stretch width
+    stretch_h = SPRITE_SIZE * 1.0;       // Stretch height
+    rect_pos_x = width - stretch_w;      // Rectangle position X
+    rect_pos_y = height - 2 * stretch_h; // Rectangle position Y
+    stretchTexture(sprite_pos_x, sprite_pos_y, SPRITE_SIZE, rect_pos_x, rect_pos_y, stretch_w, stretch_h, sheet, texture, queue);
+}
+
+// ############################################################################################
+// Scene05's render function renders the static sprites into the cached layer once, then replays it
+void MScene05::render(SDL_Renderer *renderer, const MAtlasRegion &sheet, SDL_Texture *texture)
+{
+    // Render the static sprites into the cached layer once, cleared to white: every later frame replays it with a single draw
+    if (this->layers.beginLayer(renderer, STATIC_LAYER, 0, this->width, this->height, SDL_Color{0xFF, 0xFF, 0xFF, 0xFF}))
+    {
+        queueStaticSprites(this->width, this->height, sheet, texture, this->queue);
+        this->queue.flush(renderer);
+        this->layers.endLayer(renderer);
+    }
+
+    // Issue the cached layer: it covers the whole window, so no clear is needed
+    this->layers.add(this->queue, STATIC_LAYER, 0.f, 0.f);
+    this->queue.flush(renderer);
+}
+// ############################################################################################
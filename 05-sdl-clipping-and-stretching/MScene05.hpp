@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MRenderQueue.hpp"
+#include "MLayerCache.hpp"
+#include "MAtlasPacker.hpp"
+
+// Frame of tutorial 05: the 8 clipped and stretched sprites of the sheet, rendered once into a cached layer and replayed with a single draw
+// Shared by 05-main.cpp and benchmarks/bench-scenes.cpp, so that the benchmark measures the frames the tutorial draws
+class MScene05
+{
+public:
+    static constexpr int STATIC_LAYER{0}; // Cached layer holding the white background and the 8 sprites, which never change
+
+private:
+    int width;          // Width of the window
+    int height;         // Height of the window
+    MRenderQueue queue; // Queue that sorts the draws of a frame and merges them into batched geometry
+    MLayerCache layers; // Cache of the composited static layer
+
+public:
+    // Constructor to draw into a window of the given size
+    MScene05(const int width, const int height) : width(width), height(height) {};
+
+    // Function to invalidate the cached layer for events that lose the content of target textures
+    inline void handleEvent(const SDL_Event &event) { layers.handleEvent(event); }
+
+    // Function to draw the frame (without presenting it) from the sheet region of an atlas page texture
+    void render(SDL_Renderer *renderer, const MAtlasRegion &sheet, SDL_Texture *texture);
+
+    // Function to destroy the layer textures (before the renderer they belong to)
+    inline void clear() { layers.clear(); }
+
+    // Getters for the scene state inline for efficiency
+    inline const MRenderQueue &getQueue() const { return queue; }                                   // Getter for the queue statistics
+    inline const MLayerCache &getLayers() const { return layers; }                                  // Getter for the layer statistics
+    inline const Uint64 getDrawCalls() const { return queue.getDrawCalls() + layers.getRenders(); } // Getter for the SDL draw calls (queued draws and layer clears)
+};
@@ -1,14 +1,34 @@
-#include "MTexture06.hpp"
+#include "MTexture.hpp"
+#include "MAssetPack.hpp"
+#include "MRenderScheduler.hpp"
+#include "MSpriteSystem.hpp"
+#include "MRotationCache.hpp"
+#include "MAllocTracker.hpp"
+#include "MFixedTimestep.hpp"
+#include "MScene06.hpp"
+#include <cstring>
 #include <iostream>
 
 // Constants for screen dimensions and window title
 constexpr int SCREEN_WIDTH{640};
 constexpr int SCREEN_HEIGHT{480};
 constexpr const char *WINDOW_TITLE{"SDL3 Tutorial 06: Rotation and Flipping Example"};
+constexpr int TARGET_FPS{0}; // Frame rate of the fixed-rate mode (0 = redraw only when something changes)
+constexpr bool USE_VSYNC{true};         // Wait for the display refresh at present: the animated frames do not spin the CPU
+constexpr float ARROW_TURN_SPEED{360.f}; // Speed at which the arrow turns to the angle set by the keys, in degrees per second
+constexpr int SWARM_COUNT{100000};      // Number of small rotating arrows shown with the space key
+constexpr float SWARM_ARROW_SIZE{12.f}; // Size of one arrow of the swarm
+constexpr float SWARM_MAX_SPIN{180.f};  // Highest rotation speed of the swarm arrows, in degrees per second
+constexpr bool USE_ROTATION_CACHE{true}; // Draw the big arrow from pre-rotated textures when the renderer rotates on the CPU (software renderer)
+constexpr int ROTATION_BUCKETS{12};      // Angles cached in a turn: 12 holds the 30 degree steps the arrow rests on (it is rotated by the renderer while turning)
+constexpr bool CHECK_FRAME_ALLOCATIONS{true}; // Log every steady-state frame that allocates on the heap (the tracker is compiled out of NDEBUG builds)
 
 // Function to initialize SDL and create a window
 bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
 {
+    // Count SDL's heap allocations from the first one: its memory functions cannot be replaced once it has allocated
+    MAllocTracker::install();
+
     // Initialize SDL3
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -26,6 +46,12 @@ bool init(SDL_Window *&pWindow, SDL_Renderer *&pRenderer)
     }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Window created and renderer initialized successfully.\n");
 
+    // Without vsync (e.g. the software renderer), the animated frames are only limited by the render time
+    if (USE_VSYNC && !SDL_SetRenderVSync(pRenderer, 1))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Could not enable vsync: %s\n", SDL_GetError());
+    }
+
     return true; // Return success
 }
 
@@ -54,36 +80,97 @@ void cleanup(SDL_Window *&pWindow, SDL_Renderer *&pRenderer, MTexture *texture)
     texture = nullptr;
 }
 
-// Function to check media availability (textures, sounds, etc.)
-bool checkMediaAvailability(MTexture &texture, SDL_Renderer *&pRenderer)
+// Function to check media availability (textures, sounds, etc.), rotation_cache = nullptr when the renderer rotates for free
+bool checkMediaAvailability(MTexture &texture, MRotationCache *rotation_cache, SDL_Renderer *&pRenderer)
 {
     bool success{true};
 
-    if (!texture.loadTexture("../assets/06arrow.png", pRenderer))
+    // Use the pre-baked asset pack when it has been built with tools/pack-assets, the PNG file otherwise
+    MAssetPack pack{};
+    if (pack.open("../assets/tutorials.mpak"))
+    {
+        // The mapped pixels are already decoded and color keyed: the surface only wraps them
+        SDL_Surface *mapped_surface = pack.createSurface("06arrow.png");
+        const bool loaded = mapped_surface != nullptr && texture.loadTexture(mapped_surface, pRenderer) && (rotation_cache == nullptr || rotation_cache->load(mapped_surface));
+        SDL_DestroySurface(mapped_surface);
+        if (loaded)
+        {
+            return success;
+        }
+    }
+
+    // Set the color key for transparency: this example uses white (0xFF, 0xFF, 0xFF)
+    const SDL_Color white{0xFF, 0xFF, 0xFF, 0xFF};
+    if (!texture.loadTexture("../assets/06arrow.png", pRenderer, &white))
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load background texture with color key!\n");
         success = false;
     }
 
+    // The rotation cache rotates the pixels itself: it needs the keyed surface, not the texture (rotated up front by main)
+    if (success && rotation_cache != nullptr)
+    {
+        SDL_Surface *keyed_surface = IMG_Load("../assets/06arrow.png");
+        success = keyed_surface != nullptr && SDL_SetSurfaceColorKey(keyed_surface, true, SDL_MapSurfaceRGB(keyed_surface, white.r, white.g, white.b)) && rotation_cache->load(keyed_surface);
+        SDL_DestroySurface(keyed_surface);
+        if (!success)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load the arrow into the rotation cache!\n");
+        }
+    }
+
     return success;
 }
 
+// Function to fill the sprite system with arrows at random positions, rotations, flips and speeds
+bool createSwarm(MSpriteSystem &swarm, const MTexture &texture)
+{
+    const int texture_id = swarm.addTexture(texture.getTexture());
+    if (texture_id < 0)
+    {
+        return false;
+    }
+
+    // Every array is allocated once, before the sprites are added
+    swarm.reserve(SWARM_COUNT);
+    for (int i = 0; i < SWARM_COUNT; i++)
+    {
+        const SDL_FRect dstRect{SDL_randf() * (SCREEN_WIDTH - SWARM_ARROW_SIZE), SDL_randf() * (SCREEN_HEIGHT - SWARM_ARROW_SIZE), SWARM_ARROW_SIZE, SWARM_ARROW_SIZE};
+        const SDL_FlipMode flip_mode = (i % 3 == 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        swarm.add(texture_id, dstRect, nullptr, SDL_randf() * 360.f, flip_mode, (SDL_randf() * 2.f - 1.f) * SWARM_MAX_SPIN);
+    }
+    return true;
+}
+
 int main()
 {
     // Declare pointers for the window and renderer
     SDL_Window *pWindow{nullptr};
     SDL_Renderer *pRenderer{nullptr};
 
-    MTexture texture{}; // The texture to be rendered
+    MTexture texture{};                                            // The texture to be rendered
+    MSpriteSystem swarm{};                                         // The rotating arrows drawn behind the big one, all with one draw call
+    MRotationCache rotation_cache{ROTATION_BUCKETS};               // The big arrow pre-rotated into angle buckets, used on the software renderer
+    bool use_rotation_cache{false};                                // Flag to draw the big arrow from the rotation cache
+    MScene06 scene(texture, nullptr, SCREEN_WIDTH, SCREEN_HEIGHT); // The frame: the arrow over the swarm, cleared to white
 
     SDL_Event event; // Create an event structure to handle events
     SDL_zero(event); // Initialize the event structure
 
+    MRenderScheduler scheduler{}; // Scheduler that decides when a frame has to be redrawn
+    scheduler.setFixedRate(TARGET_FPS);
+
     bool quit = {false}; // Flag to indicate when the application should exit
     int exit_code = {0}; // Exit code
 
-    double degrees = 0.0;                   // Initialize rotation angle
+    MFixedTimestep timestep{}; // Fixed-timestep clock of the simulation: the arrow and the swarm turn in 60 steps per second
+
+    float target_degrees = 0.f;             // Rotation angle set by the keys
+    float degrees = 0.f;                    // Rotation angle at the last simulation step, turning toward target_degrees
+    float previous_degrees = 0.f;           // Rotation angle at the step before, to interpolate the rendered angle
     SDL_FlipMode flip_mode = SDL_FLIP_NONE; // Initialize flip mode
+    bool swarm_visible = false;             // Flag to show the swarm of rotating arrows
+    bool animating = false;                 // Flag to indicate that the simulation changes the frame at every step
 
     // Initialize SDL and create a window and get the screen surface
     if (!init(pWindow, pRenderer))
@@ -95,8 +182,12 @@ int main()
     }
     else
     {
+        // Only the software renderer rotates on the CPU: the other renderers rotate for free on the GPU
+        use_rotation_cache = USE_ROTATION_CACHE && std::strcmp(SDL_GetRendererName(pRenderer), SDL_SOFTWARE_RENDERER) == 0;
+        scene.setRotationCache(use_rotation_cache ? &rotation_cache : nullptr);
+
         // Check if the media loading is successful
-        if (!checkMediaAvailability(texture, pRenderer))
+        if (!checkMediaAvailability(texture, use_rotation_cache ? &rotation_cache : nullptr, pRenderer))
         {
             exit_code = 2; // Exit if media availability check fails
             quit = true;   // Set quit flag to true
@@ -105,58 +196,145 @@ int main()
         }
         else
         {
+            // The swarm is optional: the tutorial still runs without it
+            if (!createSwarm(swarm, texture))
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create the arrow swarm!\n");
+            }
+
+            // Rotate every bucket now: a key press then only picks a texture, without rotating nor allocating in the frame
+            if (use_rotation_cache && !rotation_cache.buildAll(pRenderer))
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to pre-rotate the arrow, rotations are built on first use!\n");
+            }
+
+            // Every frame after the first one (which grows the draw buffers) must draw without allocating
+            MAllocTracker::setStrict(CHECK_FRAME_ALLOCATIONS, 1);
+
             // Main loop: keep running until the quit flag is set
             while (!quit)
             {
-                while (SDL_PollEvent(&event)) // Events Loop: Poll for events
+                // Allocations are counted from the start of the iteration that presents, idle iterations are not counted
+                MAllocTracker::beginFrame();
+
+                // Wait for the next event: blocks while nothing has to be redrawn
+                if (scheduler.waitEvent(&event))
                 {
-                    // Check if the quit event is triggered
-                    if (event.type == SDL_EVENT_QUIT)
+                    do // Events Loop: handle the event and any other pending one
                     {
-                        quit = true; // Set quit flag to true
-                    }
-                    else if (event.type == SDL_EVENT_KEY_DOWN) // Check for key down events
-                    {
-                        // Handle key presses for rotation and flipping
-                        switch (event.key.key)
+                        // Window events (expose, resize, ...) always require a redraw
+                        scheduler.handleEvent(event);
+
+                        // Check if the quit event is triggered
+                        if (event.type == SDL_EVENT_QUIT)
+                        {
+                            quit = true; // Set quit flag to true
+                        }
+                        else if (event.type == SDL_EVENT_KEY_DOWN) // Check for key down events
                         {
-                        case SDLK_LEFT:       // Rotate left
-                            degrees -= 30.0f; // Rotate left by 30 degrees
-                            break;
-                        case SDLK_RIGHT:      // Rotate right
-                            degrees += 30.0f; // Rotate right by 30 degrees
-                            break;
-
-                        case SDLK_UP: // Flip vertically
-                            flip_mode = SDL_FLIP_VERTICAL;
-                            break;
-
-                        case SDLK_DOWN: // Flip horizontally
-                            flip_mode = SDL_FLIP_HORIZONTAL;
-                            break;
-
-                        default:
-                            degrees = 0.0;             // Reset rotation angle
-                            flip_mode = SDL_FLIP_NONE; // Reset flip mode
-                            break;
+                            scheduler.invalidate(); // Every key changes the rotation or the flip mode
+
+                            // Handle key presses for rotation and flipping
+                            switch (event.key.key)
+                            {
+                            case SDLK_LEFT:              // Rotate left
+                                target_degrees -= 30.0f; // Turn left by 30 degrees
+                                break;
+                            case SDLK_RIGHT:             // Rotate right
+                                target_degrees += 30.0f; // Turn right by 30 degrees
+                                break;
+
+                            case SDLK_UP: // Flip vertically
+                                flip_mode = SDL_FLIP_VERTICAL;
+                                break;
+
+                            case SDLK_DOWN: // Flip horizontally
+                                flip_mode = SDL_FLIP_HORIZONTAL;
+                                break;
+
+                            case SDLK_SPACE: // Show or hide the swarm
+                                swarm_visible = !swarm_visible;
+                                MAllocTracker::expectAllocations(); // The first swarm frame grows the vertex buffer of the renderer
+                                break;
+
+                            default:
+                                target_degrees = degrees = previous_degrees = 0.f; // Reset rotation angle at once
+                                flip_mode = SDL_FLIP_NONE;                         // Reset flip mode
+                                break;
+                            }
                         }
+                    } while (SDL_PollEvent(&event));
+                }
+
+                // Skip the frame if nothing changed since the last present
+                if (!scheduler.shouldRender())
+                {
+                    continue;
+                }
+
+                // Advance the simulation in whole fixed steps: after an idle wait the clock restarts instead of catching up
+                if (!animating)
+                {
+                    timestep.reset();
+                }
+                const int steps = timestep.advance();
+                const float step_seconds = timestep.getStepSeconds();
+                for (int step = 0; step < steps; step++)
+                {
+                    // The arrow turns toward the angle of the keys at a constant speed
+                    previous_degrees = degrees;
+                    const float turn = ARROW_TURN_SPEED * step_seconds;
+                    degrees = target_degrees > degrees ? SDL_min(degrees + turn, target_degrees) : SDL_max(degrees - turn, target_degrees);
+
+                    if (swarm_visible)
+                    {
+                        swarm.update(step_seconds);
                     }
                 }
 
-                // Set the default background color to white (inline color setting)
-                SDL_SetRenderDrawColor(pRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-                SDL_RenderClear(pRenderer);
+                // Render the state between the last two steps: the motion is smooth whatever the refresh rate
+                const float alpha = timestep.getAlpha();
+                animating = swarm_visible || degrees != target_degrees || previous_degrees != degrees;
+                if (animating)
+                {
+                    scheduler.invalidate(); // The next frame is due right away
+                }
 
-                float pos_center_x = (SCREEN_WIDTH - texture.getWidth()) / 2.0f;
-                float pos_center_y = (SCREEN_HEIGHT - texture.getHeight()) / 2.0f;
-                texture.renderTexture(pos_center_x, pos_center_y, degrees, flip_mode, pRenderer);
+                // Draw the arrow and the swarm at the state between the last two steps: the swarm rotations are interpolated back from the last step
+                const float render_degrees = MFixedTimestep::interpolate(previous_degrees, degrees, alpha);
+                scene.render(pRenderer, render_degrees, flip_mode, swarm_visible ? &swarm : nullptr, (alpha - 1.f) * step_seconds);
+                if (use_rotation_cache && !scene.isCachedAngle(render_degrees))
+                {
+                    MAllocTracker::expectAllocations(); // Between two buckets the software renderer rotates the arrow into a temporary surface
+                }
 
                 // Present the rendered content to the window
                 SDL_RenderPresent(pRenderer);
+                MAllocTracker::endFrame();
             }
         }
     }
-    // Clean up
+
+    // Report how many frames were redrawn and how many were skipped
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames rendered: %llu, frames skipped: %llu\n", (unsigned long long)scheduler.getFramesRendered(), (unsigned long long)scheduler.getFramesSkipped());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Draws queued: %llu, draw calls issued: %llu\n", (unsigned long long)scene.getQueue().getCommandsSubmitted(), (unsigned long long)scene.getDrawCalls());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Simulation steps: %llu, time dropped by the step limit: %llu ms in %llu frames\n", (unsigned long long)timestep.getSteps(),
+                (unsigned long long)SDL_NS_TO_MS(timestep.getDroppedNS()), (unsigned long long)timestep.getDroppedFrames());
+
+    if (use_rotation_cache)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Rotations built: %llu, pre-rotated draws: %llu\n", (unsigned long long)rotation_cache.getBuildCount(), (unsigned long long)rotation_cache.getHitCount());
+    }
+
+    // Report how many frames allocated on the heap (in strict mode the steady-state ones were logged as they happened)
+    if (MALLOC_TRACKER_ENABLED)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames that allocated: %llu of %llu (at most %llu allocations), steady-state violations: %llu\n", (unsigned long long)MAllocTracker::getAllocatingFrames(),
+                    (unsigned long long)MAllocTracker::getFrameCount(), (unsigned long long)MAllocTracker::getMaxFrameAllocations(), (unsigned long long)MAllocTracker::getViolationCount());
+    }
+
+    // Clean up (the rotated textures belong to the renderer)
+    rotation_cache.clear();
     cleanup(pWindow, pRenderer, &texture);
 
     // Return the exit code: 0 for success, non-zero for failure
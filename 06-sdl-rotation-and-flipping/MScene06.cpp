@@ -0,0 +1,56 @@
+#include "MScene06.hpp"
+#include <cmath>
+
+// ############################################################################################
+// Scene06's constructor keeps the arrow and its rotation cache
+MScene06::MScene06(MTexture &texture, MRotationCache *rotation_cache, const int width, const int height)
+    : texture(texture), rotation_cache(rotation_cache), width(width), height(height), direct_draw_calls(0)
+{
+}
+
+// ############################################################################################
+// Scene06's isCachedAngle function compares the angle with the nearest bucket angle, a whole turn apart or not
+bool MScene06::isCachedAngle(const float degrees) const
+{
+    if (this->rotation_cache == nullptr)
+    {
+        return false;
+    }
+    const double bucket_degrees = this->rotation_cache->getBucketDegree(this->rotation_cache->getBucket(degrees));
+    return std::fabs(std::remainder(degrees - bucket_degrees, 360.0)) <= BUCKET_TOLERANCE;
+}
+
+// ############################################################################################
+// Scene06's render function clears to white, then draws the swarm and the arrow on top of it
+void MScene06::render(SDL_Renderer *renderer, const float degrees, const SDL_FlipMode flip_mode, MSpriteSystem *swarm, const float swarm_offset_seconds)
+{
+    // Clear to white: the draw color is only set again if it changed
+    this->queue.clear(SDL_Color{0xFF, 0xFF, 0xFF, 0xFF});
+
+    // The swarm is drawn between the clear and the big arrow
+    if (swarm != nullptr)
+    {
+        this->queue.flush(renderer); // Issue the clear before the swarm
+        const Uint64 swarm_draw_calls = swarm->getDrawCalls();
+        swarm->render(renderer, swarm_offset_seconds);
+        this->direct_draw_calls += swarm->getDrawCalls() - swarm_draw_calls;
+    }
+
+    float pos_center_x = (this->width - this->texture.getWidth()) / 2.0f;
+    float pos_center_y = (this->height - this->texture.getHeight()) / 2.0f;
+    if (this->isCachedAngle(degrees))
+    {
+        // Issue the queued clear, then copy the arrow pre-rotated at the angle instead of rotating it every frame
+        this->queue.flush(renderer);
+        this->direct_draw_calls += this->rotation_cache->render(renderer, pos_center_x, pos_center_y, degrees, flip_mode) ? 1 : 0;
+    }
+    else
+    {
+        // Rotated at the exact angle: snapping the interpolated angles of a turn to the buckets would make the arrow jump between them
+        this->queue.add(this->texture, pos_center_x, pos_center_y, degrees, flip_mode);
+
+        // Issue the queued clear and draw before presenting
+        this->queue.flush(renderer);
+    }
+}
+// ############################################################################################
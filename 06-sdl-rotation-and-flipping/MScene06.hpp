@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MTexture.hpp"
+#include "MRenderQueue.hpp"
+#include "MSpriteSystem.hpp"
+#include "MRotationCache.hpp"
+
+// Frame of tutorial 06: the arrow rotated and flipped in the center of the window, over the optional swarm of rotating arrows
+// Shared by 06-main.cpp and benchmarks/bench-scenes.cpp, so that the benchmark measures the frames the tutorial draws
+class MScene06
+{
+public:
+    static constexpr double BUCKET_TOLERANCE{0.001}; // Largest difference with a bucket angle drawn from the rotation cache, in degrees
+
+private:
+    MTexture &texture;              // Texture of the arrow (owned by the caller)
+    MRotationCache *rotation_cache; // Arrow pre-rotated into angle buckets (owned by the caller), nullptr when the renderer rotates for free
+    int width;                      // Width of the window
+    int height;                     // Height of the window
+    MRenderQueue queue;             // Queue that records the draws of a frame until they are flushed
+    Uint64 direct_draw_calls;       // Number of draw calls issued outside the queue (swarm and pre-rotated arrow)
+
+public:
+    // Constructor to draw the arrow into a window of the given size, from the rotation cache when there is one
+    MScene06(MTexture &texture, MRotationCache *rotation_cache, const int width, const int height);
+
+    // Function to draw the arrow from a rotation cache (owned by the caller), or rotated by the renderer with nullptr
+    inline void setRotationCache(MRotationCache *cache) { rotation_cache = cache; }
+
+    // Function to check if an angle is drawn from the rotation cache: only the bucket angles are, the angles between them are rotated by the renderer
+    bool isCachedAngle(const float degrees) const;
+
+    // Function to draw the frame (without presenting it): the swarm is drawn when given, its rotations advanced by swarm_offset_seconds
+    void render(SDL_Renderer *renderer, const float degrees, const SDL_FlipMode flip_mode, MSpriteSystem *swarm = nullptr, const float swarm_offset_seconds = 0.f);
+
+    // Getters for the scene state inline for efficiency
+    inline const MRenderQueue &getQueue() const { return queue; }                                  // Getter for the queue statistics
+    inline const Uint64 getDrawCalls() const { return queue.getDrawCalls() + direct_draw_calls; } // Getter for the SDL draw calls (queued and direct)
+};
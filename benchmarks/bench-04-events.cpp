@@ -0,0 +1,149 @@
+#include "MTexture.hpp"
+#include "MSurfaceArena.hpp"
+#include "MScene04.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Constants for the render target and the benchmark workload
+constexpr int SCREEN_WIDTH{640};     // Same window size as the tutorial
+constexpr int SCREEN_HEIGHT{480};
+constexpr int DEFAULT_EVENTS{10000}; // Number of mouse motion events pushed in one burst, unless given on the command line
+
+// Function to load the 04 backgrounds into one streaming texture and the sprite with both color key variants, as 04-main.cpp does
+bool loadScene(MTexture &background, MTexture &sprite, MScene04 &scene, MSurfaceArena &arena, SDL_Renderer *renderer, const std::string &assets_dir)
+{
+    SDL_Surface *background_surface = arena.load(assets_dir + "/04background0.png");
+    SDL_Surface *swap_surface = arena.load(assets_dir + "/04background1.png");
+    SDL_Rect swap_rect{};
+    const bool loaded = background_surface != nullptr && swap_surface != nullptr && background.loadStreaming(background_surface, renderer) &&
+                        MScene04::findChangedRect(background_surface, swap_surface, swap_rect);
+    if (loaded)
+    {
+        scene.setBackgroundSwap(swap_surface, swap_rect);
+    }
+    arena.release(background_surface);
+
+    const SDL_Color cyan{0x00, 0xFF, 0xFF, 0xFF};
+    return loaded && sprite.loadTexture(assets_dir + "/04sprite.png", renderer, arena, &cyan, true);
+}
+
+// Function to push a burst of mouse motion events over the window, as a mouse moved across it would; returns the number of events queued
+int pushMotionEvents(SDL_Window *window, const int count)
+{
+    int pushed{0};
+    for (int i = 0; i < count; i++)
+    {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.windowID = SDL_GetWindowID(window);
+        event.motion.x = (float)(i % SCREEN_WIDTH);
+        event.motion.y = (float)((i / SCREEN_WIDTH) % SCREEN_HEIGHT);
+        event.motion.xrel = 1.f;
+        pushed += SDL_PushEvent(&event) ? 1 : 0;
+    }
+    return pushed;
+}
+
+int main(int argc, char *argv[])
+{
+    const int count = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_EVENTS;
+    const std::string assets_dir = argc > 2 ? argv[2] : "../assets";
+
+    // The offscreen driver needs no display: the environment (SDL_VIDEO_DRIVER) can still select another one
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window *window = SDL_CreateWindow("bench-04-events", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = window != nullptr ? SDL_CreateRenderer(window, "software") : nullptr;
+    if (renderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the offscreen window: %s\n", SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    // The textures are loaded once before the loop, and the first frame is drawn, as 04-main.cpp does
+    MSurfaceArena arena{};
+    MTexture background{};
+    MTexture sprite{};
+    MScene04 scene(background, sprite, SCREEN_WIDTH, SCREEN_HEIGHT);
+    bool remove_background{false};
+    int failures{0};
+    if (!loadScene(background, sprite, scene, arena, renderer, assets_dir))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load the 04 scene from %s\n", assets_dir.c_str());
+        failures++;
+    }
+    else
+    {
+        scene.render(renderer, remove_background);
+        SDL_RenderPresent(renderer);
+
+        // The events of the window creation are dropped, so that only the burst is handled
+        SDL_PumpEvents();
+        SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+        const Uint64 loads_before = MTexture::getLoadCount();
+        const int pushed = pushMotionEvents(window, count);
+        const Uint64 start = SDL_GetPerformanceCounter();
+
+        // Event loop of 04-main.cpp: the pending events are handled, then one frame is rendered for all of them, until the queue is empty
+        SDL_Event event;
+        SDL_zero(event);
+        int handled{0};
+        int frames{0};
+        bool quit{false};
+        while (!quit && handled < pushed)
+        {
+            bool redraw{false};
+            while (SDL_PollEvent(&event))
+            {
+                if (event.type == SDL_EVENT_QUIT)
+                {
+                    quit = true;
+                }
+                else
+                {
+                    scene.handleEvent(event, remove_background);
+                    redraw = true;
+                }
+                handled += event.type == SDL_EVENT_MOUSE_MOTION ? 1 : 0;
+            }
+            if (!redraw)
+            {
+                break; // Every event left the queue without being handled
+            }
+            scene.render(renderer, remove_background);
+            SDL_RenderPresent(renderer);
+            frames++;
+        }
+        const double elapsed_ms = (double)(SDL_GetPerformanceCounter() - start) * 1e3 / (double)SDL_GetPerformanceFrequency();
+        const Uint64 loads = MTexture::getLoadCount() - loads_before;
+
+        // Every motion event must be handled without decoding a file or removing the color key (the loop reloaded 3 images per event before)
+        const bool passed = pushed == count && handled == count && loads == 0 && !remove_background;
+        std::printf("mouse motion events: %d pushed, %d handled in %d frames, %.2f ms (%.3f us per event)\n", pushed, handled, frames, elapsed_ms,
+                    handled > 0 ? elapsed_ms * 1e3 / handled : 0.0);
+        std::printf("image files decoded: %llu, expected 0 (%d before textures were kept resident): %s\n", (unsigned long long)loads, 3 * count,
+                    passed ? "ok" : "FAILED");
+        failures += passed ? 0 : 1;
+    }
+
+    // Clean up (the layer textures belong to the renderer: destroy them first)
+    scene.clear();
+    background.clear();
+    sprite.clear();
+    arena.releaseAll();
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return failures == 0 ? 0 : 1;
+}
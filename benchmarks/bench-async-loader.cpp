@@ -0,0 +1,180 @@
+#include "MAsyncLoader.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Constants for the render target and the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr int LOAD_COUNT{100};          // Number of image loads, cycling over the tutorial assets
+constexpr int MAX_UPLOADS_PER_FRAME{1}; // Upload budget of the asynchronous path (like 03-main.cpp)
+constexpr const char *ASSET_NAMES[]{"02img.png", "03img.png", "03up.png", "03down.png", "03left.png", "03right.png",
+                                    "04background0.png", "04background1.png", "04sprite.png", "05dots.png", "06arrow.png"};
+
+// Structure to hold the frame time statistics of one run
+struct FrameStats
+{
+    int frames;      // Number of frames rendered until every texture was uploaded
+    double total_ms; // Time until every texture was uploaded
+    double mean_ms;  // Mean frame time
+    double p99_ms;   // 99th percentile frame time
+    double max_ms;   // Worst frame time
+};
+
+// Function to compute the statistics of a list of frame times
+FrameStats computeStats(std::vector<double> &frame_times_ms)
+{
+    FrameStats stats{(int)frame_times_ms.size(), 0.0, 0.0, 0.0, 0.0};
+    if (frame_times_ms.empty())
+    {
+        return stats;
+    }
+
+    for (const double frame_time_ms : frame_times_ms)
+    {
+        stats.total_ms += frame_time_ms;
+    }
+    std::sort(frame_times_ms.begin(), frame_times_ms.end());
+    stats.mean_ms = stats.total_ms / frame_times_ms.size();
+    stats.p99_ms = frame_times_ms[(frame_times_ms.size() * 99) / 100];
+    stats.max_ms = frame_times_ms.back();
+    return stats;
+}
+
+// Function to render one frame that draws the most recently uploaded texture
+void renderFrame(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    SDL_RenderClear(renderer);
+    if (texture != nullptr)
+    {
+        SDL_RenderTexture(renderer, texture, nullptr, nullptr);
+    }
+    SDL_RenderPresent(renderer);
+}
+
+// Function to measure the synchronous path: every frame decodes and uploads one image on the render thread
+FrameStats runSynchronous(SDL_Renderer *renderer, const std::vector<std::string> &file_paths, std::vector<SDL_Texture *> &textures)
+{
+    std::vector<double> frame_times_ms{};
+    for (const std::string &file_path : file_paths)
+    {
+        const Uint64 start = SDL_GetPerformanceCounter();
+
+        // The same work as MTexture::loadTexture: decode then upload
+        SDL_Surface *loaded_surface = IMG_Load(file_path.c_str());
+        if (loaded_surface != nullptr)
+        {
+            textures.push_back(SDL_CreateTextureFromSurface(renderer, loaded_surface));
+            SDL_DestroySurface(loaded_surface);
+        }
+        renderFrame(renderer, textures.empty() ? nullptr : textures.back());
+
+        frame_times_ms.push_back((double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    }
+    return computeStats(frame_times_ms);
+}
+
+// Function to measure the asynchronous path: the workers decode, the render thread only uploads a bounded number of surfaces per frame
+FrameStats runAsynchronous(SDL_Renderer *renderer, const std::vector<std::string> &file_paths, std::vector<SDL_Texture *> &textures)
+{
+    MAsyncLoader loader{};
+    if (!loader.start())
+    {
+        return FrameStats{};
+    }
+
+    std::vector<double> frame_times_ms{};
+    const Uint64 requests_start = SDL_GetPerformanceCounter();
+    for (const std::string &file_path : file_paths)
+    {
+        loader.request(file_path);
+    }
+    const double requests_ms = (double)(SDL_GetPerformanceCounter() - requests_start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    // The frame that queues the loads pays for the requests only
+    bool first_frame{true};
+    while (loader.getPendingCount() > 0)
+    {
+        const Uint64 start = SDL_GetPerformanceCounter();
+
+        for (int uploads = 0; uploads < MAX_UPLOADS_PER_FRAME; uploads++)
+        {
+            std::shared_ptr<MAsyncLoad> load = loader.popCompleted();
+            if (load == nullptr)
+            {
+                break; // Nothing else is ready this frame
+            }
+            SDL_Surface *decoded_surface = load->takeSurface();
+            if (decoded_surface != nullptr)
+            {
+                textures.push_back(SDL_CreateTextureFromSurface(renderer, decoded_surface));
+                SDL_DestroySurface(decoded_surface);
+            }
+        }
+        renderFrame(renderer, textures.empty() ? nullptr : textures.back());
+
+        double frame_time_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        if (first_frame)
+        {
+            frame_time_ms += requests_ms;
+            first_frame = false;
+        }
+        frame_times_ms.push_back(frame_time_ms);
+    }
+
+    loader.stop();
+    return computeStats(frame_times_ms);
+}
+
+// Function to destroy the textures created by a run
+void destroyTextures(std::vector<SDL_Texture *> &textures)
+{
+    for (SDL_Texture *texture : textures)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    textures.clear();
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string assets_dir = argc > 1 ? argv[1] : "../assets";
+
+    // The software renderer draws into a plain surface: no window or GPU is needed
+    SDL_Surface *pTarget = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *pRenderer = pTarget != nullptr ? SDL_CreateSoftwareRenderer(pTarget) : nullptr;
+    if (pRenderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // Cycle over the tutorial assets until the requested number of loads is reached
+    std::vector<std::string> file_paths{};
+    for (int i = 0; i < LOAD_COUNT; i++)
+    {
+        file_paths.push_back(assets_dir + "/" + ASSET_NAMES[i % SDL_arraysize(ASSET_NAMES)]);
+    }
+
+    std::vector<SDL_Texture *> textures{};
+    const FrameStats sync_stats = runSynchronous(pRenderer, file_paths, textures);
+    const size_t sync_uploads = textures.size();
+    destroyTextures(textures);
+    const FrameStats async_stats = runAsynchronous(pRenderer, file_paths, textures);
+    const size_t async_uploads = textures.size();
+    destroyTextures(textures);
+
+    std::printf("%d loads from %s\n", LOAD_COUNT, assets_dir.c_str());
+    std::printf("%14s %8s %8s %12s %10s %10s %10s\n", "path", "uploads", "frames", "total ms", "mean ms", "p99 ms", "max ms");
+    std::printf("%14s %8zu %8d %12.2f %10.3f %10.3f %10.3f\n", "synchronous", sync_uploads, sync_stats.frames, sync_stats.total_ms, sync_stats.mean_ms, sync_stats.p99_ms, sync_stats.max_ms);
+    std::printf("%14s %8zu %8d %12.2f %10.3f %10.3f %10.3f\n", "asynchronous", async_uploads, async_stats.frames, async_stats.total_ms, async_stats.mean_ms, async_stats.p99_ms, async_stats.max_ms);
+
+    // Clean up
+    SDL_DestroyRenderer(pRenderer);
+    SDL_DestroySurface(pTarget);
+    SDL_Quit();
+
+    return 0;
+}
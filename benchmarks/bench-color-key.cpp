@@ -0,0 +1,208 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include "MColorKeyConverter.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Constants for the benchmark workload
+constexpr int SHEET_WIDTH{3840};                  // Width of the sprite sheet (4K)
+constexpr int SHEET_HEIGHT{2160};                 // Height of the sprite sheet
+constexpr int DEFAULT_CONVERSIONS{20};            // Conversions timed for each path
+constexpr int TOLERANCE{16};                      // Tolerance of the measurement with a threshold
+constexpr SDL_Color CYAN{0x00, 0xFF, 0xFF, 0xFF}; // Color key of the 04 sprite
+
+// Options measured for each kernel: exact key, key with a tolerance, exact key with premultiplied output
+constexpr MColorKeyOptions OPTION_SETS[]{{0, false}, {TOLERANCE, false}, {0, true}};
+constexpr const char *OPTION_NAMES[]{"exact", "tolerance", "premultiplied"};
+
+// Function to create the sprite sheet: the 04 sprite tiled over the sheet, or generated sprites on a cyan background when it is not available
+SDL_Surface *createSheet(const std::string &assets_dir)
+{
+    SDL_Surface *sheet = SDL_CreateSurface(SHEET_WIDTH, SHEET_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    if (sheet == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the sprite sheet: %s\n", SDL_GetError());
+        return nullptr;
+    }
+    SDL_FillSurfaceRect(sheet, nullptr, SDL_MapSurfaceRGB(sheet, CYAN.r, CYAN.g, CYAN.b));
+
+    SDL_Surface *sprite = IMG_Load((assets_dir + "/04sprite.png").c_str());
+    if (sprite != nullptr)
+    {
+        SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_NONE);
+        for (int y = 0; y < SHEET_HEIGHT; y += sprite->h)
+        {
+            for (int x = 0; x < SHEET_WIDTH; x += sprite->w)
+            {
+                SDL_Rect position{x, y, sprite->w, sprite->h};
+                SDL_BlitSurface(sprite, nullptr, sheet, &position);
+            }
+        }
+        SDL_DestroySurface(sprite);
+        return sheet;
+    }
+
+    // Generated sprites: shaded discs with a few semi-transparent pixels, and a cyan background with some noise for the tolerance
+    std::printf("04sprite.png not found in %s: using generated sprites\n", assets_dir.c_str());
+    for (int y = 0; y < SHEET_HEIGHT; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)sheet->pixels + (size_t)y * sheet->pitch);
+        for (int x = 0; x < SHEET_WIDTH; x++)
+        {
+            const int dx = x % 64 - 32;
+            const int dy = y % 64 - 32;
+            const Uint32 noise = ((Uint32)x * 2654435761u) ^ ((Uint32)y * 40503u);
+            if (dx * dx + dy * dy < 28 * 28)
+            {
+                row[x] = SDL_MapSurfaceRGBA(sheet, (Uint8)(x * 255 / SHEET_WIDTH), (Uint8)(y * 255 / SHEET_HEIGHT), 0x40, (noise >> 28) == 0 ? 0x80 : 0xFF);
+            }
+            else
+            {
+                row[x] = SDL_MapSurfaceRGB(sheet, 0x00, (Uint8)(0xFF - (noise >> 29)), 0xFF);
+            }
+        }
+    }
+    return sheet;
+}
+
+// Function to copy the pixels of a surface into another of the same size and format
+void copyPixels(const SDL_Surface *source, SDL_Surface *destination)
+{
+    std::memcpy(destination->pixels, source->pixels, (size_t)source->pitch * source->h);
+}
+
+// Function to count the pixels that differ between two surfaces of the same size and format
+int countDifferences(const SDL_Surface *a, const SDL_Surface *b)
+{
+    int differences{0};
+    for (int y = 0; y < a->h; y++)
+    {
+        const Uint32 *row_a = (const Uint32 *)((const Uint8 *)a->pixels + (size_t)y * a->pitch);
+        const Uint32 *row_b = (const Uint32 *)((const Uint8 *)b->pixels + (size_t)y * b->pitch);
+        for (int x = 0; x < a->w; x++)
+        {
+            differences += row_a[x] != row_b[x];
+        }
+    }
+    return differences;
+}
+
+// Function to key the sheet out the way SDL does: a keyed blit into a transparent ARGB8888 surface (keyed pixels are skipped and stay 0)
+void keyWithSDL(SDL_Surface *sheet, SDL_Surface *destination)
+{
+    SDL_FillSurfaceRect(destination, nullptr, 0);
+    SDL_SetSurfaceBlendMode(sheet, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorKey(sheet, true, SDL_MapSurfaceRGB(sheet, CYAN.r, CYAN.g, CYAN.b));
+    SDL_BlitSurface(sheet, nullptr, destination, nullptr);
+    SDL_SetSurfaceColorKey(sheet, false, 0);
+}
+
+// Function to check every kernel against the scalar one, and the scalar one against SDL; returns the number of failed checks
+int checkKernels(SDL_Surface *sheet, SDL_Surface *reference, SDL_Surface *work)
+{
+    int failures{0};
+    for (size_t option = 0; option < SDL_arraysize(OPTION_SETS); option++)
+    {
+        copyPixels(sheet, reference);
+        MColorKeyConverter(MColorKeyConverter::KERNEL_SCALAR).convert(reference, CYAN, OPTION_SETS[option]);
+        for (const MColorKeyConverter::Kernel kernel : {MColorKeyConverter::KERNEL_SSE2, MColorKeyConverter::KERNEL_AVX2})
+        {
+            if (!MColorKeyConverter::isSupported(kernel))
+            {
+                continue;
+            }
+            copyPixels(sheet, work);
+            MColorKeyConverter(kernel).convert(work, CYAN, OPTION_SETS[option]);
+            const int differences = countDifferences(reference, work);
+            std::printf("%s %s: %d pixels differ from scalar, %s\n", MColorKeyConverter::getKernelName(kernel), OPTION_NAMES[option], differences, differences == 0 ? "ok" : "FAILED");
+            failures += differences == 0 ? 0 : 1;
+        }
+    }
+
+    // With an exact key, SDL skips the keyed pixels (left at 0) where the converter only clears their alpha: every other pixel must be equal
+    copyPixels(sheet, reference);
+    MColorKeyConverter(MColorKeyConverter::KERNEL_SCALAR).convert(reference, CYAN, MColorKeyOptions{});
+    keyWithSDL(sheet, work);
+    const Uint32 key = SDL_MapSurfaceRGB(sheet, CYAN.r, CYAN.g, CYAN.b) & 0x00FFFFFF;
+    int keyed_differences{0};
+    for (int y = 0; y < sheet->h; y++)
+    {
+        const Uint32 *row_sheet = (const Uint32 *)((const Uint8 *)sheet->pixels + (size_t)y * sheet->pitch);
+        const Uint32 *row_converted = (const Uint32 *)((const Uint8 *)reference->pixels + (size_t)y * reference->pitch);
+        const Uint32 *row_sdl = (const Uint32 *)((const Uint8 *)work->pixels + (size_t)y * work->pitch);
+        for (int x = 0; x < sheet->w; x++)
+        {
+            const bool keyed = (row_sheet[x] & 0x00FFFFFF) == key;
+            keyed_differences += keyed ? row_sdl[x] != 0 || row_converted[x] != key : row_sdl[x] != row_converted[x];
+        }
+    }
+    std::printf("scalar exact: %d pixels keyed differently from SDL, %s\n", keyed_differences, keyed_differences == 0 ? "ok" : "FAILED");
+    return failures + (keyed_differences == 0 ? 0 : 1);
+}
+
+// Function to measure one path, in milliseconds per conversion (kernel == KERNEL_AUTO measures SDL's keyed blit); the copy of the sheet is not timed
+double measureConversion(const MColorKeyConverter::Kernel kernel, const MColorKeyOptions &options, SDL_Surface *sheet, SDL_Surface *work, const int conversions)
+{
+    const MColorKeyConverter converter{kernel};
+    Uint64 ticks{0};
+    for (int i = 0; i < conversions; i++)
+    {
+        copyPixels(sheet, work);
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (kernel == MColorKeyConverter::KERNEL_AUTO)
+        {
+            keyWithSDL(sheet, work);
+        }
+        else
+        {
+            converter.convert(work, CYAN, options);
+        }
+        ticks += SDL_GetPerformanceCounter() - start;
+    }
+    return (double)ticks * 1000.0 / (double)SDL_GetPerformanceFrequency() / conversions;
+}
+
+int main(int argc, char *argv[])
+{
+    const int conversions = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_CONVERSIONS;
+    const std::string assets_dir = argc > 2 ? argv[2] : "../assets";
+
+    SDL_Surface *sheet = createSheet(assets_dir);
+    SDL_Surface *reference = SDL_CreateSurface(SHEET_WIDTH, SHEET_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *work = SDL_CreateSurface(SHEET_WIDTH, SHEET_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    if (sheet == nullptr || reference == nullptr || work == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the surfaces: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // Correctness first: a faster kernel that keys other pixels is worthless
+    const int failures = checkKernels(sheet, reference, work);
+
+    const double megapixels = (double)SHEET_WIDTH * SHEET_HEIGHT / 1e6;
+    const double sdl_ms = measureConversion(MColorKeyConverter::KERNEL_AUTO, MColorKeyOptions{}, sheet, work, conversions);
+    std::printf("\n%dx%d ARGB8888 sprite sheet, %d conversions per path\n", SHEET_WIDTH, SHEET_HEIGHT, conversions);
+    std::printf("%16s %8s %12s %10s %10s\n", "options", "kernel", "ms/sheet", "MP/s", "speedup");
+    std::printf("%16s %8s %12.2f %10.0f %10s\n", "exact", "sdl", sdl_ms, megapixels * 1000.0 / sdl_ms, "1.00x");
+    for (size_t option = 0; option < SDL_arraysize(OPTION_SETS); option++)
+    {
+        for (const MColorKeyConverter::Kernel kernel : {MColorKeyConverter::KERNEL_SCALAR, MColorKeyConverter::KERNEL_SSE2, MColorKeyConverter::KERNEL_AVX2})
+        {
+            if (!MColorKeyConverter::isSupported(kernel))
+            {
+                continue;
+            }
+            const double ms = measureConversion(kernel, OPTION_SETS[option], sheet, work, conversions);
+            std::printf("%16s %8s %12.2f %10.0f %9.2fx\n", OPTION_NAMES[option], MColorKeyConverter::getKernelName(kernel), ms, megapixels * 1000.0 / ms, sdl_ms / ms);
+        }
+    }
+
+    SDL_DestroySurface(work);
+    SDL_DestroySurface(reference);
+    SDL_DestroySurface(sheet);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+#include <SDL3/SDL.h>
+#include "MDirtyRegion.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Constants for the window and the benchmark workload
+constexpr int SCREEN_WIDTH{640};    // Same window size as tutorial 01
+constexpr int SCREEN_HEIGHT{480};
+constexpr int SPRITE_SIZE{32};      // Size of the moving sprite
+constexpr int DEFAULT_FRAMES{1000}; // Number of frames drawn for each path, unless given on the command line
+
+// Paths of the frame
+enum FramePath
+{
+    PATH_FULL,  // Whole scene redrawn and presented every frame
+    PATH_DIRTY, // Only the old and new sprite rectangles redrawn and presented
+    PATH_STATIC // Dirty rectangles with a sprite that does not move: nothing to redraw
+};
+
+// Structure to hold the surfaces of the scene
+struct Scene
+{
+    SDL_Surface *background; // Static full-screen background
+    SDL_Surface *sprite;     // Small alpha-blended sprite moving over the background
+};
+
+// Function to create the scene: a gradient background and a round sprite with soft edges
+bool createScene(Scene &scene)
+{
+    scene.background = SDL_CreateSurface(SCREEN_WIDTH, SCREEN_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    scene.sprite = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    if (scene.background == nullptr || scene.sprite == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the scene surfaces: %s\n", SDL_GetError());
+        return false;
+    }
+    for (int y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)scene.background->pixels + (size_t)y * scene.background->pitch);
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+        {
+            row[x] = SDL_MapSurfaceRGB(scene.background, (Uint8)(x * 255 / SCREEN_WIDTH), (Uint8)(y * 255 / SCREEN_HEIGHT), (Uint8)((x ^ y) & 0xFF));
+        }
+    }
+    for (int y = 0; y < SPRITE_SIZE; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)scene.sprite->pixels + (size_t)y * scene.sprite->pitch);
+        for (int x = 0; x < SPRITE_SIZE; x++)
+        {
+            const int dx = 2 * x + 1 - SPRITE_SIZE;
+            const int dy = 2 * y + 1 - SPRITE_SIZE;
+            const int alpha = std::clamp(255 - (dx * dx + dy * dy) * 255 / (SPRITE_SIZE * SPRITE_SIZE), 0, 255);
+            row[x] = SDL_MapSurfaceRGBA(scene.sprite, 255, 64, 32, (Uint8)alpha);
+        }
+    }
+    SDL_SetSurfaceBlendMode(scene.sprite, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+// Function to get the sprite rectangle of a frame: the sprite bounces off the window borders
+SDL_Rect getSpriteRect(const FramePath path, const int frame)
+{
+    const int step = path == PATH_STATIC ? 0 : frame;
+    const int range_x = SCREEN_WIDTH - SPRITE_SIZE;
+    const int range_y = SCREEN_HEIGHT - SPRITE_SIZE;
+    const int x = (step * 3) % (2 * range_x);
+    const int y = (step * 2) % (2 * range_y);
+    return {x < range_x ? x : 2 * range_x - x, y < range_y ? y : 2 * range_y - y, SPRITE_SIZE, SPRITE_SIZE};
+}
+
+// Function to draw the scene into the surface, clipped to a rectangle (nullptr = whole surface)
+void drawScene(const Scene &scene, SDL_Surface *screen, const SDL_Rect &sprite_rect, const SDL_Rect *clip_rect)
+{
+    SDL_SetSurfaceClipRect(screen, clip_rect);
+    SDL_BlitSurface(scene.background, nullptr, screen, nullptr);
+    SDL_BlitSurface(scene.sprite, nullptr, screen, &sprite_rect);
+    SDL_SetSurfaceClipRect(screen, nullptr);
+}
+
+// Function to draw one frame of a path: the dirty paths redraw the rectangles the sprite left and entered
+void drawFrame(const FramePath path, const Scene &scene, SDL_Surface *screen, MDirtyRegion &dirty_region, const int frame)
+{
+    const SDL_Rect sprite_rect = getSpriteRect(path, frame);
+    if (path == PATH_FULL)
+    {
+        drawScene(scene, screen, sprite_rect, nullptr);
+        return;
+    }
+
+    // The first frame is entirely dirty, then only the sprite moves
+    if (frame > 0)
+    {
+        const SDL_Rect previous_rect = getSpriteRect(path, frame - 1);
+        if (!SDL_RectsEqual(&previous_rect, &sprite_rect))
+        {
+            dirty_region.add(previous_rect);
+            dirty_region.add(sprite_rect);
+        }
+    }
+    for (const SDL_Rect &dirty_rect : dirty_region.getRects())
+    {
+        drawScene(scene, screen, sprite_rect, &dirty_rect);
+    }
+}
+
+// Function to measure the mean CPU time of a frame of a path, drawn and presented through the window surface
+double runPath(const FramePath path, const Scene &scene, SDL_Window *window, const int frames, Uint64 &pixels_presented)
+{
+    SDL_Surface *screen = SDL_GetWindowSurface(window);
+    MDirtyRegion dirty_region(screen->w, screen->h);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        drawFrame(path, scene, screen, dirty_region, frame);
+        if (path == PATH_FULL)
+        {
+            SDL_UpdateWindowSurface(window);
+            pixels_presented += (Uint64)screen->w * screen->h;
+        }
+        else
+        {
+            dirty_region.present(window);
+        }
+    }
+    const double mean_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames;
+
+    if (path != PATH_FULL)
+    {
+        pixels_presented = dirty_region.getPixelsPresented();
+    }
+    return mean_ms;
+}
+
+// Function to check that the dirty path leaves the same pixels as a full redraw after every frame
+int countMismatchedFrames(const Scene &scene, const int frames)
+{
+    SDL_Surface *full = SDL_CreateSurface(SCREEN_WIDTH, SCREEN_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Surface *dirty = SDL_CreateSurface(SCREEN_WIDTH, SCREEN_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    if (full == nullptr || dirty == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the check surfaces: %s\n", SDL_GetError());
+        SDL_DestroySurface(full);
+        SDL_DestroySurface(dirty);
+        return frames;
+    }
+
+    MDirtyRegion unused_region(SCREEN_WIDTH, SCREEN_HEIGHT);
+    MDirtyRegion dirty_region(SCREEN_WIDTH, SCREEN_HEIGHT);
+    int mismatched_frames{0};
+    for (int frame = 0; frame < frames; frame++)
+    {
+        drawFrame(PATH_FULL, scene, full, unused_region, frame);
+        drawFrame(PATH_DIRTY, scene, dirty, dirty_region, frame);
+        dirty_region.clear(); // What present would do, without a window
+
+        for (int y = 0; y < SCREEN_HEIGHT; y++)
+        {
+            if (std::memcmp((Uint8 *)full->pixels + (size_t)y * full->pitch, (Uint8 *)dirty->pixels + (size_t)y * dirty->pitch, (size_t)SCREEN_WIDTH * 4) != 0)
+            {
+                mismatched_frames++;
+                break;
+            }
+        }
+    }
+
+    SDL_DestroySurface(full);
+    SDL_DestroySurface(dirty);
+    return mismatched_frames;
+}
+
+int main(int argc, char *argv[])
+{
+    const int frames = argc > 1 ? std::max(std::atoi(argv[1]), 2) : DEFAULT_FRAMES;
+
+    // The offscreen driver needs no display: the environment (SDL_VIDEO_DRIVER) can still select another one
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    Scene scene{nullptr, nullptr};
+    SDL_Window *window = SDL_CreateWindow("bench-dirty-rects", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    if (!createScene(scene) || window == nullptr || SDL_GetWindowSurface(window) == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not set up the benchmark: %s\n", SDL_GetError());
+        SDL_DestroySurface(scene.background);
+        SDL_DestroySurface(scene.sprite);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    // Pixel check first: a timing of a wrong output is worthless
+    const int mismatched_frames = countMismatchedFrames(scene, frames);
+    std::printf("pixel check: %d of %d frames differ from a full redraw\n", mismatched_frames, frames);
+
+    const char *path_names[]{"full redraw", "dirty rects", "static"};
+    std::printf("%d frames per path, %dx%d window, %dx%d sprite, video driver %s\n", frames, SCREEN_WIDTH, SCREEN_HEIGHT, SPRITE_SIZE, SPRITE_SIZE, SDL_GetCurrentVideoDriver());
+    std::printf("%14s %12s %10s %18s\n", "path", "mean ms", "speedup", "pixels/frame");
+
+    double full_ms{0.0};
+    for (const FramePath path : {PATH_FULL, PATH_DIRTY, PATH_STATIC})
+    {
+        Uint64 pixels_presented{0};
+        const double mean_ms = runPath(path, scene, window, frames, pixels_presented);
+        if (path == PATH_FULL)
+        {
+            full_ms = mean_ms;
+        }
+        std::printf("%14s %12.4f %9.2fx %18.1f\n", path_names[path], mean_ms, mean_ms > 0.0 ? full_ms / mean_ms : 0.0, (double)pixels_presented / frames);
+    }
+
+    SDL_DestroySurface(scene.background);
+    SDL_DestroySurface(scene.sprite);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return mismatched_frames == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+#include <SDL3/SDL.h>
+#include "MFixedTimestep.hpp"
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// Constants for the benchmark workload
+constexpr Uint64 SIMULATED_NS{2 * SDL_NS_PER_SECOND}; // Simulated time of each refresh rate
+constexpr float SPEED{200.f};                         // Speed of the moving object, in pixels per second
+constexpr float GRAVITY{980.f};                       // Acceleration of the falling object, in pixels per second squared
+constexpr float SMOOTHNESS_TOLERANCE{0.01f};          // Largest difference between the distance rendered in a frame and the distance expected, in pixels
+constexpr Uint64 STALL_NS{SDL_NS_PER_SECOND};         // Frame time of the stall (window drag, breakpoint, ...)
+constexpr Uint64 SLOW_STEP_NS{25 * SDL_NS_PER_MS};    // Cost of one step in the spiral-of-death test, more than the 16.7 ms it simulates
+constexpr int SLOW_FRAMES{30};                        // Frames of the spiral-of-death test
+constexpr int DEFAULT_CALLS{10000000};                // Number of advance calls timed, unless given on the command line
+
+// Refresh rates of the frames: 0 stands for frames of random length (jitter between 4 and 30 ms)
+constexpr int REFRESH_RATES[]{30, 60, 75, 144, 240, 0};
+
+// Fake clock: the tests move the time themselves, so every run gives the same frames
+Uint64 fake_now_ns{0};
+Uint64 SDLCALL getFakeTime(void) { return fake_now_ns; }
+
+// Structure to hold the state simulated by the steps
+struct State
+{
+    float x;       // Position of the object moving at constant speed
+    float y;       // Position of the falling object
+    float y_speed; // Speed of the falling object
+};
+
+// Function to advance the state by one step (explicit Euler integration: its result depends on the step duration)
+void simulate(State &state, const float seconds)
+{
+    state.x += SPEED * seconds;
+    state.y_speed += GRAVITY * seconds;
+    state.y += state.y_speed * seconds;
+}
+
+// Function to get the duration of a frame at a refresh rate
+Uint64 getFrameNS(const int refresh_rate)
+{
+    return refresh_rate > 0 ? SDL_NS_PER_SECOND / refresh_rate : 4 * SDL_NS_PER_MS + (Uint64)(SDL_randf() * 26.f * SDL_NS_PER_MS);
+}
+
+// Function to check that the fixed steps give the same state at every refresh rate and that the interpolated motion is smooth
+int checkRefreshRates()
+{
+    int failures{0};
+    std::printf("%10s %8s %8s %8s %14s %14s %16s %16s\n", "refresh", "frames", "end ms", "steps", "fixed y", "variable y", "interpolated err", "stepped err");
+
+    for (const int refresh_rate : REFRESH_RATES)
+    {
+        // Fixed steps, rendered with interpolation (and without, for comparison)
+        fake_now_ns = 0;
+        SDL_srand(1);
+        MFixedTimestep timestep{MFixedTimestep::DEFAULT_STEP_NS, MFixedTimestep::DEFAULT_MAX_STEPS, getFakeTime};
+        State state{}, previous{};
+        int frames{0};
+        float rendered_x{0.f}, stepped_x{0.f};
+        float interpolated_error{0.f}, stepped_error{0.f};
+        while (fake_now_ns < SIMULATED_NS)
+        {
+            const Uint64 frame_ns = getFrameNS(refresh_rate);
+            fake_now_ns += frame_ns;
+            frames++;
+            for (int steps = timestep.advance(); steps > 0; steps--)
+            {
+                previous = state;
+                simulate(state, timestep.getStepSeconds());
+            }
+
+            // At constant speed, each frame must move the object by the distance covered in the frame time (the interpolated
+            // position trails the time by one step, so the frames of the first step are not measured)
+            const float expected = SPEED * (float)frame_ns / SDL_NS_PER_SECOND;
+            const float next_x = MFixedTimestep::interpolate(previous.x, state.x, timestep.getAlpha());
+            if (fake_now_ns - frame_ns >= timestep.getStepNS())
+            {
+                interpolated_error = SDL_max(interpolated_error, std::fabs(next_x - rendered_x - expected));
+                stepped_error = SDL_max(stepped_error, std::fabs(state.x - stepped_x - expected));
+            }
+            rendered_x = next_x;
+            stepped_x = state.x;
+        }
+
+        // The same number of steps without frames: the fixed-step state only depends on the steps run
+        State reference{};
+        for (Uint64 step = 0; step < timestep.getSteps(); step++)
+        {
+            simulate(reference, timestep.getStepSeconds());
+        }
+
+        // Variable steps: one step of the frame time per frame, as the loop did before
+        fake_now_ns = 0;
+        SDL_srand(1);
+        State variable{};
+        while (fake_now_ns < SIMULATED_NS)
+        {
+            const Uint64 frame_ns = getFrameNS(refresh_rate);
+            fake_now_ns += frame_ns;
+            simulate(variable, (float)frame_ns / SDL_NS_PER_SECOND);
+        }
+
+        const bool passed = state.y == reference.y && state.x == reference.x && interpolated_error < SMOOTHNESS_TOLERANCE && timestep.getDroppedFrames() == 0;
+        failures += passed ? 0 : 1;
+        char label[16];
+        std::snprintf(label, sizeof(label), refresh_rate > 0 ? "%d Hz" : "jitter", refresh_rate);
+        std::printf("%10s %8d %8.1f %8llu %14.3f %14.3f %16.5f %16.5f %s\n", label, frames, (double)fake_now_ns / SDL_NS_PER_MS, (unsigned long long)timestep.getSteps(), state.y, variable.y,
+                    interpolated_error, stepped_error, passed ? "ok" : "FAILED");
+    }
+    return failures;
+}
+
+// Function to check the spiral-of-death protection: a stall and steps slower than real time
+int checkSpiralOfDeath()
+{
+    int failures{0};
+
+    // A one second stall: the next frame runs max_steps steps and drops the rest, the frame after does not catch up
+    fake_now_ns = 0;
+    MFixedTimestep timestep{MFixedTimestep::DEFAULT_STEP_NS, MFixedTimestep::DEFAULT_MAX_STEPS, getFakeTime};
+    fake_now_ns += STALL_NS;
+    const int stall_steps = timestep.advance();
+    const float stall_alpha = timestep.getAlpha();
+    fake_now_ns += MFixedTimestep::DEFAULT_STEP_NS;
+    const int next_steps = timestep.advance();
+    const bool stall_passed = stall_steps == MFixedTimestep::DEFAULT_MAX_STEPS && next_steps <= 2 && stall_alpha >= 0.f && stall_alpha < 1.f && timestep.getDroppedFrames() == 1 &&
+                              timestep.getDroppedNS() == STALL_NS / MFixedTimestep::DEFAULT_STEP_NS * MFixedTimestep::DEFAULT_STEP_NS - MFixedTimestep::DEFAULT_MAX_STEPS * MFixedTimestep::DEFAULT_STEP_NS;
+    std::printf("stall: %d steps after %llu ms, %d steps the frame after, %llu ms dropped, %s\n", stall_steps, (unsigned long long)SDL_NS_TO_MS(STALL_NS), next_steps,
+                (unsigned long long)SDL_NS_TO_MS(timestep.getDroppedNS()), stall_passed ? "ok" : "FAILED");
+    failures += stall_passed ? 0 : 1;
+
+    // Steps that cost more than they simulate: without the limit each frame needs more steps than the last one
+    int last_steps[2]{0, 0};
+    const int max_steps[2]{MFixedTimestep::DEFAULT_MAX_STEPS, INT_MAX};
+    for (int run = 0; run < 2; run++)
+    {
+        fake_now_ns = 0;
+        MFixedTimestep slow_timestep{MFixedTimestep::DEFAULT_STEP_NS, max_steps[run], getFakeTime};
+        fake_now_ns += MFixedTimestep::DEFAULT_STEP_NS;
+        for (int frame = 0; frame < SLOW_FRAMES; frame++)
+        {
+            last_steps[run] = slow_timestep.advance();
+            fake_now_ns += last_steps[run] * SLOW_STEP_NS + SDL_NS_PER_MS; // The steps take their cost, plus 1 ms of rendering
+        }
+    }
+    const bool slow_passed = last_steps[0] <= MFixedTimestep::DEFAULT_MAX_STEPS && last_steps[1] > MFixedTimestep::DEFAULT_MAX_STEPS;
+    std::printf("slow steps: %d steps in frame %d with the limit, %d without, %s\n", last_steps[0], SLOW_FRAMES, last_steps[1], slow_passed ? "ok" : "FAILED");
+    failures += slow_passed ? 0 : 1;
+
+    // A clock going back adds no time, a reset forgets the time elapsed
+    fake_now_ns = 10 * SDL_NS_PER_SECOND;
+    MFixedTimestep reset_timestep{MFixedTimestep::DEFAULT_STEP_NS, MFixedTimestep::DEFAULT_MAX_STEPS, getFakeTime};
+    fake_now_ns -= SDL_NS_PER_SECOND;
+    const int back_steps = reset_timestep.advance();
+    fake_now_ns += SDL_NS_PER_SECOND;
+    reset_timestep.reset();
+    const int reset_steps = reset_timestep.advance();
+    const bool reset_passed = back_steps == 0 && reset_steps == 0 && reset_timestep.getDroppedFrames() == 0;
+    std::printf("clock back and reset: %d and %d steps, %s\n", back_steps, reset_steps, reset_passed ? "ok" : "FAILED");
+    failures += reset_passed ? 0 : 1;
+
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    const int calls = argc > 1 ? std::atoi(argv[1]) : DEFAULT_CALLS;
+    if (calls <= 0)
+    {
+        std::fprintf(stderr, "Usage: %s [calls]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("Fixed steps of %.3f ms (at most %d per frame) over %llu ms of frames\n", (double)MFixedTimestep::DEFAULT_STEP_NS / SDL_NS_PER_MS, MFixedTimestep::DEFAULT_MAX_STEPS,
+                (unsigned long long)SDL_NS_TO_MS(SIMULATED_NS));
+    int failures = checkRefreshRates();
+    std::printf("\n");
+    failures += checkSpiralOfDeath();
+
+    // Cost of the loop itself with the real clock
+    MFixedTimestep timestep{};
+    Uint64 steps{0};
+    float alpha_sum{0.f};
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int call = 0; call < calls; call++)
+    {
+        steps += timestep.advance();
+        alpha_sum += timestep.getAlpha();
+    }
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    std::printf("\nadvance and getAlpha with SDL_GetTicksNS: %.1f ns per frame (%d frames, %llu steps, mean alpha %.3f)\n", seconds * 1e9 / calls, calls,
+                (unsigned long long)steps, alpha_sum / calls);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+#include "MAssetWatcher.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Constants for the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr int ASSET_COUNT{4};                                 // Images written to the temporary directory and watched
+constexpr int IMAGE_SIZE{768};                                // Side of the images, with noisy pixels so that the decode is expensive
+constexpr int RESIZED_IMAGE_SIZE{384};                        // Side of the image saved once, to check that the new pixels are swapped in
+constexpr int BURST_WRITES{5};                                // Saves of one file in a row, merged into one reload by the debounce
+constexpr int BASELINE_FRAMES{120};                           // Frames measured before any file changes
+constexpr Uint64 DEBOUNCE_NS{300 * SDL_NS_PER_MS};            // Debounce delay of the watcher
+constexpr Uint64 RELOAD_TIMEOUT_NS{5 * SDL_NS_PER_SECOND};    // Longest wait for the reloads
+constexpr Uint64 SETTLE_NS{2 * DEBOUNCE_NS};                  // Frames kept running after the reloads, to catch an extra reload
+constexpr int EXPECTED_RELOADS{3};                            // Files saved as valid images: the burst, the resized one and the keyed one
+constexpr SDL_Color KEY_COLOR{0x00, 0x00, 0x00, 0xFF};        // Color key of the last image, loaded with its plain variant kept
+
+// Function to write a square image of noisy pixels as PNG (the seed changes the content of every save)
+bool writeImage(const std::string &file_path, const int size, Uint32 seed)
+{
+    SDL_Surface *surface = SDL_CreateSurface(size, size, SDL_PIXELFORMAT_ARGB8888);
+    if (surface == nullptr)
+    {
+        return false;
+    }
+    for (int y = 0; y < size; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+        for (int x = 0; x < size; x++)
+        {
+            seed = seed * 1664525u + 1013904223u; // Linear congruential generator: same images on every run
+            row[x] = 0xFF000000u | (seed >> 8);
+        }
+    }
+    const bool saved = IMG_SavePNG(surface, file_path.c_str());
+    SDL_DestroySurface(surface);
+    return saved;
+}
+
+// Function to render one frame of the watched textures, swapping in at most one reload first; returns its duration in milliseconds
+double renderFrame(SDL_Renderer *renderer, MAssetWatcher &watcher, const std::vector<std::shared_ptr<MTexture>> &textures)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    watcher.update(renderer);
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    SDL_RenderClear(renderer);
+    for (size_t i = 0; i < textures.size(); i++)
+    {
+        textures[i]->renderTexture((float)(i % 2) * TARGET_WIDTH / 2.f, (float)(i / 2) * TARGET_HEIGHT / 2.f, TARGET_WIDTH / 2.f, TARGET_HEIGHT / 2.f, renderer);
+    }
+    SDL_RenderPresent(renderer);
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// Function to get a percentile of frame times in milliseconds
+double getPercentile(std::vector<double> frame_times, const double percentile)
+{
+    if (frame_times.empty())
+    {
+        return 0.0;
+    }
+    std::sort(frame_times.begin(), frame_times.end());
+    return frame_times[std::min(frame_times.size() - 1, (size_t)(percentile / 100.0 * frame_times.size()))];
+}
+
+int main()
+{
+    // The offscreen driver needs no display: the environment (SDL_VIDEO_DRIVER) can still select another one
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window *window = SDL_CreateWindow("bench-hot-reload", TARGET_WIDTH, TARGET_HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = window != nullptr ? SDL_CreateRenderer(window, "software") : nullptr;
+    if (renderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the offscreen renderer: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    // Temporary directory of the watched images, removed at the end
+    std::error_code error{};
+    const std::filesystem::path directory = std::filesystem::temp_directory_path(error) / ("bench-hot-reload-" + std::to_string(SDL_GetTicksNS()));
+    std::vector<std::string> file_paths{};
+    bool written = std::filesystem::create_directory(directory, error);
+    for (int i = 0; written && i < ASSET_COUNT; i++)
+    {
+        file_paths.push_back((directory / ("asset" + std::to_string(i) + ".png")).string());
+        written = writeImage(file_paths.back(), IMAGE_SIZE, i);
+    }
+
+    // Load the images once, as checkMediaAvailability does, then watch them
+    MAssetWatcher watcher{};
+    std::vector<std::shared_ptr<MTexture>> textures{};
+    bool loaded = written && watcher.start(DEBOUNCE_NS);
+    for (size_t i = 0; loaded && i < file_paths.size(); i++)
+    {
+        // The last image keeps its plain variant next to the keyed one, with the plain one selected: a reload must rebuild both
+        const bool keyed = i == file_paths.size() - 1;
+        textures.push_back(std::make_shared<MTexture>());
+        loaded = textures.back()->loadTexture(file_paths[i], renderer, keyed ? &KEY_COLOR : nullptr, keyed) && watcher.watch(file_paths[i], textures.back(), keyed ? &KEY_COLOR : nullptr);
+    }
+    if (loaded)
+    {
+        textures.back()->setColorKey(false);
+    }
+    if (!loaded)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not write and watch the images in %s\n", directory.string().c_str());
+        watcher.stop();
+        std::filesystem::remove_all(directory, error);
+        SDL_Quit();
+        return 1;
+    }
+
+    // Frames without changes
+    std::vector<double> baseline_times{};
+    for (int frame = 0; frame < BASELINE_FRAMES; frame++)
+    {
+        baseline_times.push_back(renderFrame(renderer, watcher, textures));
+    }
+
+    // What a blind reload on the render thread costs: decode and upload of one image
+    MTexture blind_reload{};
+    const Uint64 blind_start = SDL_GetPerformanceCounter();
+    blind_reload.loadTexture(file_paths[0], renderer);
+    const double blind_ms = (double)(SDL_GetPerformanceCounter() - blind_start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    blind_reload.clear();
+
+    // Edit the files, as an image editor saving them would: a burst of saves of the first one, a single save of the second one with a new size,
+    // a file that is not an image for the third one (its reload fails) and a new image for the keyed one
+    for (int i = 0; i < BURST_WRITES; i++)
+    {
+        writeImage(file_paths[0], IMAGE_SIZE, 100 + i);
+    }
+    writeImage(file_paths[1], RESIZED_IMAGE_SIZE, 200);
+    const MTexture *resized_texture = textures[1].get();
+    const SDL_Texture *broken_texture = textures[2]->getTexture();
+    const char broken_content[]{"not a PNG file"};
+    std::FILE *broken_file = std::fopen(file_paths[2].c_str(), "wb");
+    if (broken_file != nullptr)
+    {
+        std::fwrite(broken_content, 1, std::strlen(broken_content), broken_file);
+        std::fclose(broken_file);
+    }
+    writeImage(file_paths[3], IMAGE_SIZE, 300);
+
+    // Keep rendering until every reload is swapped in or failed, then a while longer
+    std::vector<double> reload_times{};
+    const Uint64 reload_start = SDL_GetTicksNS();
+    Uint64 settle_start{0};
+    while (SDL_GetTicksNS() - reload_start < RELOAD_TIMEOUT_NS && (settle_start == 0 || SDL_GetTicksNS() - settle_start < SETTLE_NS))
+    {
+        reload_times.push_back(renderFrame(renderer, watcher, textures));
+        if (settle_start == 0 && watcher.getReloads() >= EXPECTED_RELOADS && watcher.getFailedReloads() >= 1)
+        {
+            settle_start = SDL_GetTicksNS();
+        }
+    }
+    const double reload_seconds = (double)(SDL_GetTicksNS() - reload_start) / SDL_NS_PER_SECOND;
+
+    // The burst must give one reload, the resized file must show up in the same texture object, the broken file must keep the texture on
+    // screen, the keyed image must keep its plain variant selected, and no frame may wait for a decode
+    // (inotify reports every save, polling may see the saves of the burst as one change)
+    int failures{0};
+    const Uint64 expected_changes = watcher.isUsingNotify() ? BURST_WRITES + 3 : 4;
+    const bool reloads_passed = watcher.getReloads() == EXPECTED_RELOADS && watcher.getFailedReloads() == 1 && watcher.getChangesDetected() >= expected_changes;
+    std::printf("reloads: %llu file changes seen, %llu reloads, %llu failed (expected %d reloads, 1 failed), %s\n", (unsigned long long)watcher.getChangesDetected(),
+                (unsigned long long)watcher.getReloads(), (unsigned long long)watcher.getFailedReloads(), EXPECTED_RELOADS, reloads_passed ? "ok" : "FAILED");
+    failures += reloads_passed ? 0 : 1;
+    const bool swap_passed = textures[1].get() == resized_texture && (int)textures[1]->getWidth() == RESIZED_IMAGE_SIZE;
+    std::printf("swap in place: texture 1 is %dx%d, %s\n", (int)textures[1]->getWidth(), (int)textures[1]->getHeight(), swap_passed ? "ok" : "FAILED");
+    failures += swap_passed ? 0 : 1;
+    const bool kept_passed = textures[2]->getTexture() == broken_texture && (int)textures[2]->getWidth() == IMAGE_SIZE;
+    std::printf("failed reload: texture 2 %s, %s\n", kept_passed ? "kept" : "replaced or destroyed", kept_passed ? "ok" : "FAILED");
+    failures += kept_passed ? 0 : 1;
+    SDL_Texture *plain_texture = textures[3]->getTexture();
+    const bool plain_selected = !textures[3]->isColorKeyEnabled();
+    textures[3]->setColorKey(true);
+    const bool pair_passed = plain_selected && plain_texture != nullptr && textures[3]->getTexture() != plain_texture;
+    std::printf("keyed reload: plain variant %s, keyed variant %s, %s\n", plain_selected ? "still selected" : "lost", textures[3]->getTexture() != plain_texture ? "rebuilt" : "missing",
+                pair_passed ? "ok" : "FAILED");
+    failures += pair_passed ? 0 : 1;
+    const double reload_max_ms = *std::max_element(reload_times.begin(), reload_times.end());
+    const bool stall_passed = reload_max_ms < blind_ms;
+    std::printf("no stall: longest frame while reloading %.2f ms, blind reload %.2f ms, %s\n", reload_max_ms, blind_ms, stall_passed ? "ok" : "FAILED");
+    failures += stall_passed ? 0 : 1;
+
+    std::printf("\n%d watched %dx%d images (%s, %llu ms debounce), %d frames before and %d frames during %.2f s of reloading\n", ASSET_COUNT, IMAGE_SIZE, IMAGE_SIZE,
+                watcher.isUsingNotify() ? "inotify" : "polling", (unsigned long long)SDL_NS_TO_MS(DEBOUNCE_NS), (int)baseline_times.size(), (int)reload_times.size(), reload_seconds);
+    std::printf("%16s %10s %10s %10s\n", "phase", "p50 ms", "p99 ms", "max ms");
+    std::printf("%16s %10.3f %10.3f %10.3f\n", "no change", getPercentile(baseline_times, 50.0), getPercentile(baseline_times, 99.0), getPercentile(baseline_times, 100.0));
+    std::printf("%16s %10.3f %10.3f %10.3f\n", "reloading", getPercentile(reload_times, 50.0), getPercentile(reload_times, 99.0), reload_max_ms);
+    std::printf("%16s %10s %10s %10.3f\n", "blind reload", "", "", blind_ms);
+
+    // Clean up
+    watcher.stop();
+    for (std::shared_ptr<MTexture> &texture : textures)
+    {
+        texture->clear();
+    }
+    std::filesystem::remove_all(directory, error);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
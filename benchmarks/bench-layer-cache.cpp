@@ -0,0 +1,271 @@
+#include "MLayerCache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+// Constants for the render target and the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr float SPRITE_SIZE{100.f}; // Size of the sprites of the 05 sheet
+constexpr int DEFAULT_FRAMES{500};  // Frames rendered for each path
+constexpr int PIXEL_TOLERANCE{2};   // Largest difference per channel between a cached and a direct frame (rounding of the premultiplied blend)
+constexpr int CACHED_LAYER{0};      // Layer of the cache holding the static draws
+
+// Structure to hold the generated textures of the scenes, so that the benchmark does not depend on the assets
+struct SceneTextures
+{
+    SDL_Texture *background; // Opaque gradient covering the target, like 04background0.png
+    SDL_Texture *sprite;     // Disc with a transparent (keyed) background, like 04sprite.png
+    SDL_Texture *sheet;      // 2x2 sheet of dots with transparent corners, like 05dots.png
+};
+
+// Structure to hold a scene: its static draws (cached) and its dynamic draws (recorded every frame)
+struct Scene
+{
+    const char *name;                                                                   // Name printed in the results
+    void (*queueStatic)(const SceneTextures &textures, MRenderQueue &queue);            // Records the draws that never change
+    void (*queueDynamic)(const SceneTextures &textures, MRenderQueue &queue, int frame); // Records the draws of one frame (nullptr if none)
+};
+
+// Structure to hold the measurements of one path
+struct PathResult
+{
+    double mean_ms;          // Mean time of a frame
+    double calls_per_frame;  // SDL draw calls per frame, after the first frame (clears included)
+    SDL_Surface *last_frame; // Pixels of the target after the last frame
+};
+
+// Function to create a texture from generated ARGB8888 pixels: pixel(x, y) gives each one
+SDL_Texture *createTexture(SDL_Renderer *renderer, const int width, const int height, Uint32 (*pixel)(int x, int y))
+{
+    SDL_Surface *surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create texture surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+    for (int y = 0; y < height; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+        for (int x = 0; x < width; x++)
+        {
+            row[x] = pixel(x, y);
+        }
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+
+    // Nearest sampling keeps the stretched sprites free of filtered edges, so the cached and direct frames can be compared
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    return texture;
+}
+
+// Function to record the static draws of the 04 scene: the background, then the keyed sprite at the center
+void queueComposite(const SceneTextures &textures, MRenderQueue &queue)
+{
+    queue.add(textures.background, nullptr, SDL_FRect{0.f, 0.f, (float)TARGET_WIDTH, (float)TARGET_HEIGHT}, 0);
+    queue.add(textures.sprite, nullptr, SDL_FRect{(TARGET_WIDTH - 128) / 2.f, (TARGET_HEIGHT - 128) / 2.f, 128.f, 128.f}, 1);
+}
+
+// Function to record the static draws of the 05 scene: a white clear and 8 sprites of the sheet, clipped and stretched in the 4 corners
+void queueSprites(const SceneTextures &textures, MRenderQueue &queue)
+{
+    queue.clear(SDL_Color{0xFF, 0xFF, 0xFF, 0xFF});
+    for (int corner = 0; corner < 4; corner++)
+    {
+        const float sprite_x = (corner % 2) * SPRITE_SIZE;
+        const float sprite_y = (corner / 2) * SPRITE_SIZE;
+        const SDL_FRect clipRect{sprite_x, sprite_y, SPRITE_SIZE, SPRITE_SIZE};
+        const float right = corner % 2 == 1 ? 1.f : 0.f;
+        const float bottom = corner / 2 == 1 ? 1.f : 0.f;
+        queue.add(textures.sheet, &clipRect, SDL_FRect{right * (TARGET_WIDTH - SPRITE_SIZE), bottom * (TARGET_HEIGHT - SPRITE_SIZE), SPRITE_SIZE, SPRITE_SIZE});
+        queue.add(textures.sheet, &clipRect, SDL_FRect{right * (TARGET_WIDTH - SPRITE_SIZE * 0.5f), SPRITE_SIZE + bottom * (TARGET_HEIGHT - 3 * SPRITE_SIZE), SPRITE_SIZE * 0.5f, SPRITE_SIZE});
+    }
+}
+
+// Function to record the dynamic draw of a frame: the 04 sprite moving over the 05 scene
+void queueMovingSprite(const SceneTextures &textures, MRenderQueue &queue, const int frame)
+{
+    const float x = (float)((frame * 3) % (TARGET_WIDTH - 128));
+    queue.add(textures.sprite, nullptr, SDL_FRect{x, (TARGET_HEIGHT - 128) / 2.f, 128.f, 128.f}, 1);
+}
+
+// Function to render the frames of a scene, with its static draws recorded every frame (direct) or replayed from the layer cache
+PathResult runPath(SDL_Renderer *renderer, const Scene &scene, const SceneTextures &textures, const bool cached, const int frames)
+{
+    MRenderQueue queue{};
+    MLayerCache layers{};
+    Uint64 first_frame_calls{0};
+    SDL_Surface *last_frame{nullptr};
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        if (!cached)
+        {
+            // Every frame starts from a cleared target, as the tutorials do (the 05 scene records its own white clear)
+            queue.clear(SDL_Color{0xFF, 0xFF, 0xFF, 0xFF});
+            scene.queueStatic(textures, queue);
+        }
+        else
+        {
+            // The static draws go into the layer once (same key every frame), the frame replays it: it covers the target, no clear needed
+            if (layers.beginLayer(renderer, CACHED_LAYER, 0, TARGET_WIDTH, TARGET_HEIGHT, SDL_Color{0xFF, 0xFF, 0xFF, 0xFF}))
+            {
+                scene.queueStatic(textures, queue);
+                queue.flush(renderer);
+                layers.endLayer(renderer);
+            }
+            layers.add(queue, CACHED_LAYER, 0.f, 0.f);
+        }
+        if (scene.queueDynamic != nullptr)
+        {
+            scene.queueDynamic(textures, queue, frame);
+        }
+        queue.flush(renderer);
+        if (frame == 0)
+        {
+            first_frame_calls = queue.getDrawCalls();
+        }
+        if (frame == frames - 1)
+        {
+            last_frame = SDL_RenderReadPixels(renderer, nullptr);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    const double elapsed_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    const double calls_per_frame = frames > 1 ? (double)(queue.getDrawCalls() - first_frame_calls) / (frames - 1) : (double)first_frame_calls;
+    return PathResult{elapsed_ms / frames, calls_per_frame, last_frame};
+}
+
+// Function to count the pixels of two surfaces that differ by more than PIXEL_TOLERANCE on a channel (-1 when one is missing)
+int countDifferences(const SDL_Surface *a, const SDL_Surface *b)
+{
+    if (a == nullptr || b == nullptr || a->w != b->w || a->h != b->h || a->format != b->format || SDL_BYTESPERPIXEL(a->format) != 4)
+    {
+        return -1;
+    }
+    int differences{0};
+    for (int y = 0; y < a->h; y++)
+    {
+        const Uint8 *row_a = (const Uint8 *)a->pixels + (size_t)y * a->pitch;
+        const Uint8 *row_b = (const Uint8 *)b->pixels + (size_t)y * b->pitch;
+        for (int x = 0; x < a->w * 4; x += 4)
+        {
+            bool differs{false};
+            for (int channel = 0; channel < 4; channel++)
+            {
+                differs = differs || SDL_abs(row_a[x + channel] - row_b[x + channel]) > PIXEL_TOLERANCE;
+            }
+            differences += differs ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+// Function to check that a layer is rendered on first use, on a new key, after invalidate and on a new size, and replayed otherwise
+int checkInvalidation(SDL_Renderer *renderer)
+{
+    MLayerCache layers{};
+    const struct
+    {
+        Uint64 key;       // Invalidation key passed to beginLayer
+        int width;        // Width of the layer
+        bool invalidated; // Flag to call invalidate before beginLayer
+        bool expected;    // Expected result of beginLayer
+    } steps[]{{1, 64, false, true}, {1, 64, false, false}, {2, 64, false, true}, {2, 64, false, false}, {2, 64, true, true}, {2, 32, false, true}, {2, 32, false, false}};
+
+    bool passed{true};
+    for (const auto &step : steps)
+    {
+        if (step.invalidated)
+        {
+            layers.invalidate(CACHED_LAYER);
+        }
+        const bool rendered = layers.beginLayer(renderer, CACHED_LAYER, step.key, step.width, 64);
+        if (rendered)
+        {
+            layers.endLayer(renderer);
+        }
+        passed = passed && rendered == step.expected;
+    }
+    passed = passed && layers.getRenders() == 4 && SDL_GetRenderTarget(renderer) == nullptr;
+    std::printf("layer invalidation: %llu renders for %d frames, %s\n", (unsigned long long)layers.getRenders(), (int)SDL_arraysize(steps), passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    const int frames = argc > 1 ? std::max(2, std::atoi(argv[1])) : DEFAULT_FRAMES;
+
+    // The offscreen driver needs no display: the environment (SDL_VIDEO_DRIVER) can still select another one
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window *window = SDL_CreateWindow("bench-layer-cache", TARGET_WIDTH, TARGET_HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = window != nullptr ? SDL_CreateRenderer(window, "software") : nullptr;
+    if (renderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the offscreen renderer: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    SceneTextures textures{};
+    textures.background = createTexture(renderer, TARGET_WIDTH, TARGET_HEIGHT, [](int x, int y)
+                                        { return 0xFF000000u | (Uint32)(x * 255 / TARGET_WIDTH) << 16 | (Uint32)(y * 255 / TARGET_HEIGHT) << 8 | 0x80u; });
+    textures.sprite = createTexture(renderer, 128, 128, [](int x, int y)
+                                    { return (x - 64) * (x - 64) + (y - 64) * (y - 64) < 60 * 60 ? 0xFFE04020u | (Uint32)(y * 2) << 8 : 0x0000FFFFu; });
+    textures.sheet = createTexture(renderer, 200, 200, [](int x, int y)
+                                   { return (x % 100 - 50) * (x % 100 - 50) + (y % 100 - 50) * (y % 100 - 50) < 48 * 48 ? 0xFF000000u | (Uint32)(x / 100 * 0xC0) << 16 | (Uint32)(y / 100 * 0xC0) : 0x00FFFFFFu; });
+    if (textures.background == nullptr || textures.sprite == nullptr || textures.sheet == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the scene textures: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    const Scene scenes[]{
+        {"04-composite", queueComposite, nullptr},
+        {"05-sprites", queueSprites, nullptr},
+        {"05+moving-sprite", queueSprites, queueMovingSprite},
+    };
+
+    // Correctness first: the cached frames must show the same pixels, and the static scenes must need a single draw call
+    int failures = checkInvalidation(renderer);
+    PathResult results[SDL_arraysize(scenes)][2]{};
+    for (size_t i = 0; i < SDL_arraysize(scenes); i++)
+    {
+        results[i][0] = runPath(renderer, scenes[i], textures, false, frames);
+        results[i][1] = runPath(renderer, scenes[i], textures, true, frames);
+        const int differences = countDifferences(results[i][0].last_frame, results[i][1].last_frame);
+        const bool single_call = scenes[i].queueDynamic != nullptr || results[i][1].calls_per_frame == 1.0;
+        const bool passed = differences == 0 && single_call;
+        std::printf("%s: %d pixels differ from direct, %.2f draw calls per cached frame, %s\n", scenes[i].name, differences, results[i][1].calls_per_frame, passed ? "ok" : "FAILED");
+        failures += passed ? 0 : 1;
+    }
+
+    std::printf("\n%dx%d software renderer, %d frames per path\n", TARGET_WIDTH, TARGET_HEIGHT, frames);
+    std::printf("%18s %8s %12s %10s %12s\n", "scene", "path", "ms/frame", "speedup", "calls/frame");
+    for (size_t i = 0; i < SDL_arraysize(scenes); i++)
+    {
+        std::printf("%18s %8s %12.3f %10s %12.2f\n", scenes[i].name, "direct", results[i][0].mean_ms, "1.00x", results[i][0].calls_per_frame);
+        std::printf("%18s %8s %12.3f %9.2fx %12.2f\n", scenes[i].name, "cached", results[i][1].mean_ms, results[i][0].mean_ms / results[i][1].mean_ms, results[i][1].calls_per_frame);
+    }
+
+    // Clean up
+    for (auto &paths : results)
+    {
+        SDL_DestroySurface(paths[0].last_frame);
+        SDL_DestroySurface(paths[1].last_frame);
+    }
+    SDL_DestroyTexture(textures.sheet);
+    SDL_DestroyTexture(textures.sprite);
+    SDL_DestroyTexture(textures.background);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// Debug messages are compiled out, info messages stay and are filtered at runtime
+#define MLOG_LEVEL MLOG_LEVEL_INFO
+#include "MLog.hpp"
+#include <cstdio>
+
+// Constants for the benchmark workload
+constexpr int CALLS{10000000}; // Number of log calls measured for each path
+
+// Counter written by every iteration, so that the loops cannot be removed by the optimizer
+volatile int sink{0};
+
+// The compiled-out path is checked at compile time, not only timed: the argument is ill-formed for T = int, so this function would
+// fail to compile if MLOG_DEBUG kept any code (runtime check, SDL call or argument) below MLOG_LEVEL_INFO
+template <typename T>
+constexpr bool isDebugCompiledOut()
+{
+    MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Debug message %d\n", T::value_never_compiled);
+    return true;
+}
+static_assert(isDebugCompiledOut<int>(), "MLOG_DEBUG must leave no code behind below MLOG_LEVEL_INFO");
+
+// Function to convert a performance counter interval into nanoseconds per call
+double nanosecondsPerCall(const Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1e9 / (double)SDL_GetPerformanceFrequency() / CALLS;
+}
+
+// Function to measure the loop alone, the reference for the other paths
+double runBaseline()
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < CALLS; i++)
+    {
+        sink = i;
+    }
+    return nanosecondsPerCall(start);
+}
+
+// Function to measure a message below the compile-time level: the call and its arguments are removed
+double runCompiledOut()
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < CALLS; i++)
+    {
+        sink = i;
+        MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Texture %d cleared after %f ms: %s\n", i, i * 0.5, SDL_GetError());
+    }
+    return nanosecondsPerCall(start);
+}
+
+// Function to measure a message kept at compile time but disabled at runtime: one compare with the cached priority
+double runRuntimeDisabled()
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < CALLS; i++)
+    {
+        sink = i;
+        MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Texture %d cleared after %f ms: %s\n", i, i * 0.5, SDL_GetError());
+    }
+    return nanosecondsPerCall(start);
+}
+
+// Function to measure SDL_LogInfo disabled at runtime: the arguments are evaluated and SDL looks up the priority
+double runSDLLogDisabled()
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < CALLS; i++)
+    {
+        sink = i;
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Texture %d cleared after %f ms: %s\n", i, i * 0.5, SDL_GetError());
+    }
+    return nanosecondsPerCall(start);
+}
+
+int main()
+{
+    // Disable info messages at runtime, as a release build with logging left on would
+    MLogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN);
+
+    const double baseline_ns = runBaseline();
+    const double compiled_out_ns = runCompiledOut();
+    const double runtime_disabled_ns = runRuntimeDisabled();
+    const double sdl_log_ns = runSDLLogDisabled();
+
+    std::printf("%d calls per path\n", CALLS);
+    std::printf("%24s %12s %18s\n", "path", "ns/call", "ns/call - loop");
+    std::printf("%24s %12.3f %18s\n", "loop only", baseline_ns, "-");
+    std::printf("%24s %12.3f %18.3f\n", "MLOG_DEBUG compiled out", compiled_out_ns, compiled_out_ns - baseline_ns);
+    std::printf("%24s %12.3f %18.3f\n", "MLOG_INFO disabled", runtime_disabled_ns, runtime_disabled_ns - baseline_ns);
+    std::printf("%24s %12.3f %18.3f\n", "SDL_LogInfo disabled", sdl_log_ns, sdl_log_ns - baseline_ns);
+
+    SDL_Quit();
+
+    return 0;
+}
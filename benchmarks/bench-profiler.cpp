@@ -0,0 +1,160 @@
+#include "MProfiler.hpp"
+#include <cstdio>
+#include <cstring>
+
+// Constants for the checks and the benchmark workload
+constexpr int LOOP_CALLS{100};                 // Calls of the zone in a loop of the check frame, merged into one zone
+constexpr int ZONES_PER_MEASUREMENT{10000000}; // Number of zones timed for each measurement
+constexpr int ZONES_PER_FRAME{32};             // Zones of each frame of the distinct zone measurement
+constexpr const char *TRACE_FILE{"bench-profiler-trace.json"};
+
+// Variable written by the workload so that the compiler keeps it
+volatile Uint64 sink{0};
+
+// Function to do a little work inside a zone
+void work(const int iterations)
+{
+    for (int i = 0; i < iterations; i++)
+    {
+        sink = sink + (Uint64)i;
+    }
+}
+
+// Function to record one frame with nested and repeated zones, then check what the profiler kept; returns the number of failed checks
+int checkFrame()
+{
+    MProfiler::beginFrame();
+    {
+        MPROFILE_ZONE("outer");
+        work(1000);
+        for (int i = 0; i < LOOP_CALLS; i++)
+        {
+            MPROFILE_ZONE("loop");
+            work(100);
+        }
+    }
+    MProfiler::endFrame();
+
+    // Two zones: "outer" at depth 0 with one call, "loop" at depth 1 with every call merged and a shorter time
+    int count{0};
+    const MProfiler::Zone *zones = MProfiler::getZones(0, count);
+    bool passed = zones != nullptr && count == 2;
+    passed = passed && std::strcmp(zones[0].name, "outer") == 0 && zones[0].depth == 0 && zones[0].calls == 1;
+    passed = passed && std::strcmp(zones[1].name, "loop") == 0 && zones[1].depth == 1 && zones[1].calls == LOOP_CALLS;
+    passed = passed && zones[1].duration_ns <= zones[0].duration_ns && zones[1].start_ns >= zones[0].start_ns;
+    passed = passed && MProfiler::getFrameTimePercentile(100.0) * SDL_NS_PER_MS >= (double)zones[0].duration_ns;
+    std::printf("nested and merged zones: %s\n", passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+// Function to fill a frame past its capacity with alternating zones; returns the number of failed checks
+int checkOverflow()
+{
+    const Uint64 dropped = MProfiler::getDroppedZones();
+    for (int i = 0; i < MProfiler::MAX_ZONES + 10; i++)
+    {
+        MPROFILE_ZONE(i % 2 == 0 ? "even" : "odd"); // Alternating names: no zone merges with the previous one
+    }
+    MProfiler::endFrame();
+
+    // Past the capacity, the zones that repeat the last one kept are still merged into it: half of the 10 extra zones are dropped
+    int count{0};
+    MProfiler::getZones(0, count);
+    const bool passed = count == MProfiler::MAX_ZONES && MProfiler::getDroppedZones() - dropped == 5;
+    std::printf("full frame: %d zones kept, %llu dropped, %s\n", count, (unsigned long long)(MProfiler::getDroppedZones() - dropped), passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+// Function to export the ring buffer and count its events; returns the number of failed checks
+int checkTrace()
+{
+    // Wrap the ring buffer, so that only the last frames are exported
+    for (int frame = 0; frame < MProfiler::FRAME_HISTORY * 2; frame++)
+    {
+        MProfiler::beginFrame();
+        {
+            MPROFILE_ZONE("update");
+            work(10);
+        }
+        {
+            MPROFILE_ZONE("present");
+            work(10);
+        }
+        MProfiler::endFrame();
+    }
+
+    size_t size{0};
+    char *trace = MProfiler::exportTrace(TRACE_FILE) ? (char *)SDL_LoadFile(TRACE_FILE, &size) : nullptr;
+    int events{0};
+    for (const char *event = trace; event != nullptr && (event = std::strstr(event, "\"ph\":\"X\"")) != nullptr; event++)
+    {
+        events++;
+    }
+
+    // Each frame kept is one frame event and two zone events
+    const int expected = (MProfiler::FRAME_HISTORY - 1) * 3;
+    const bool passed = trace != nullptr && trace[0] == '{' && std::strstr(trace, "]}") != nullptr && events == expected;
+    std::printf("trace export: %d events (%d expected), %s\n", events, expected, passed ? "ok" : "FAILED");
+    SDL_free(trace);
+    SDL_RemovePath(TRACE_FILE);
+    return passed ? 0 : 1;
+}
+
+// Function to measure the cost of a zone, in nanoseconds: repeated zones are merged, distinct zones fill the frames
+double measureZone(const bool distinct)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < ZONES_PER_MEASUREMENT; i++)
+    {
+        if (distinct)
+        {
+            MPROFILE_ZONE(i % 2 == 0 ? "even" : "odd");
+            sink = sink + 1;
+            if (i % ZONES_PER_FRAME == ZONES_PER_FRAME - 1)
+            {
+                MProfiler::endFrame();
+            }
+        }
+        else
+        {
+            MPROFILE_ZONE("repeated");
+            sink = sink + 1;
+        }
+    }
+    MProfiler::endFrame();
+    return (double)(SDL_GetPerformanceCounter() - start) * 1e9 / (double)SDL_GetPerformanceFrequency() / ZONES_PER_MEASUREMENT;
+}
+
+// Function to measure the loop without zones, in nanoseconds per iteration
+double measureEmptyLoop()
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < ZONES_PER_MEASUREMENT; i++)
+    {
+        sink = sink + 1;
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) * 1e9 / (double)SDL_GetPerformanceFrequency() / ZONES_PER_MEASUREMENT;
+}
+
+int main()
+{
+    if constexpr (MPROFILER_ENABLED == 0)
+    {
+        std::printf("The profiler is compiled out (MPROFILER_ENABLED=0): zones cost nothing and record nothing\n");
+        return 0;
+    }
+
+    // Correctness first: timings of a profiler that records the wrong zones are worthless
+    const int failures = checkFrame() + checkOverflow() + checkTrace();
+
+    const double empty = measureEmptyLoop();
+    const double repeated = measureZone(false);
+    const double distinct = measureZone(true);
+    std::printf("\n%20s %14s %14s\n", "path", "ns/iteration", "zone cost ns");
+    std::printf("%20s %14.2f %14s\n", "no zone", empty, "-");
+    std::printf("%20s %14.2f %14.2f\n", "merged zone", repeated, repeated - empty);
+    std::printf("%20s %14.2f %14.2f\n", "distinct zones", distinct, distinct - empty);
+
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+#include "MRenderQueue.hpp"
+#include <cstdio>
+#include <vector>
+
+// Constants for the render target and the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr int TEXTURE_COUNT{4};    // Number of textures the sprites are spread over
+constexpr int LAYER_COUNT{3};      // Number of layers the sprites are spread over
+constexpr int SPRITE_COUNT{10000}; // Number of sprites in the scene
+constexpr float SPRITE_SIZE{16.f}; // Size of the drawn sprites, small so that draw call overhead dominates
+constexpr int FRAMES{20};          // Number of frames rendered for each path
+
+// Structure to hold one sprite of the scene
+struct Sprite
+{
+    int texture;       // Index of the sprite texture
+    int layer;         // Layer of the sprite
+    SDL_FRect dstRect; // Destination rectangle on the render target
+};
+
+// Function to create a small texture of one color, so that the benchmark does not depend on the assets
+SDL_Texture *createTexture(SDL_Renderer *renderer, const SDL_Color &color)
+{
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create texture surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+    SDL_FillSurfaceRect(surface, nullptr, SDL_MapSurfaceRGBA(surface, color.r, color.g, color.b, color.a));
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+// Function to generate a deterministic scene where consecutive sprites use different textures and layers (worst case for immediate drawing)
+std::vector<Sprite> generateScene()
+{
+    std::vector<Sprite> sprites(SPRITE_COUNT);
+    Uint32 seed{12345};
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        seed = seed * 1664525u + 1013904223u; // Linear congruential generator: same workload on every run
+        sprites[i].texture = i % TEXTURE_COUNT;
+        sprites[i].layer = (int)((seed >> 8) % LAYER_COUNT);
+        sprites[i].dstRect = SDL_FRect{(float)(seed % (TARGET_WIDTH - (int)SPRITE_SIZE)), (float)((seed >> 16) % (TARGET_HEIGHT - (int)SPRITE_SIZE)), SPRITE_SIZE, SPRITE_SIZE};
+    }
+    return sprites;
+}
+
+// Function to measure the immediate path: the color and clear of every frame, then one SDL_RenderTexture per sprite
+double runImmediate(SDL_Renderer *renderer, SDL_Texture *const *textures, const std::vector<Sprite> &sprites)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(renderer);
+
+        // Layer by layer, in the same layer order as the queue
+        for (int layer = 0; layer < LAYER_COUNT; layer++)
+        {
+            for (const Sprite &sprite : sprites)
+            {
+                if (sprite.layer == layer)
+                {
+                    SDL_RenderTexture(renderer, textures[sprite.texture], nullptr, &sprite.dstRect);
+                }
+            }
+        }
+        SDL_RenderPresent(renderer);
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency() / FRAMES;
+}
+
+// Function to measure the queued path: every sprite recorded, then sorted and merged at flush
+double runQueued(SDL_Renderer *renderer, SDL_Texture *const *textures, const std::vector<Sprite> &sprites, MRenderQueue &queue)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        queue.clear(SDL_Color{0xFF, 0xFF, 0xFF, 0xFF});
+        for (const Sprite &sprite : sprites)
+        {
+            queue.add(textures[sprite.texture], nullptr, sprite.dstRect, sprite.layer);
+        }
+        queue.flush(renderer);
+        SDL_RenderPresent(renderer);
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency() / FRAMES;
+}
+
+int main()
+{
+    // The software renderer draws into a plain surface: no window or GPU is needed
+    SDL_Surface *pTarget = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *pRenderer = pTarget != nullptr ? SDL_CreateSoftwareRenderer(pTarget) : nullptr;
+    if (pRenderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the software renderer: %s\n", SDL_GetError());
+        SDL_DestroySurface(pTarget);
+        return 1;
+    }
+
+    const SDL_Color colors[TEXTURE_COUNT]{{0xFF, 0x00, 0x00, 0xFF}, {0x00, 0xFF, 0x00, 0xFF}, {0x00, 0x00, 0xFF, 0xFF}, {0xFF, 0xFF, 0x00, 0xFF}};
+    SDL_Texture *textures[TEXTURE_COUNT]{};
+    for (int i = 0; i < TEXTURE_COUNT; i++)
+    {
+        if (textures[i] = createTexture(pRenderer, colors[i]); textures[i] == nullptr)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the sprite textures: %s\n", SDL_GetError());
+            return 1;
+        }
+    }
+
+    const std::vector<Sprite> sprites = generateScene();
+    MRenderQueue queue{};
+
+    const double immediate_ms = runImmediate(pRenderer, textures, sprites);
+    const double queued_ms = runQueued(pRenderer, textures, sprites, queue);
+
+    // Per-frame counters: the immediate path issues every call itself
+    std::printf("%d sprites, %d textures, %d layers, %d frames per path\n", SPRITE_COUNT, TEXTURE_COUNT, LAYER_COUNT, FRAMES);
+    std::printf("%10s %12s %10s %12s %14s %14s\n", "path", "ms/frame", "commands", "draw calls", "state changes", "state skipped");
+    std::printf("%10s %12.3f %10d %12d %14d %14d\n", "immediate", immediate_ms, SPRITE_COUNT, SPRITE_COUNT + 1, 1, 0);
+    std::printf("%10s %12.3f %10llu %12llu %14.2f %14.2f\n", "queue", queued_ms, (unsigned long long)(queue.getCommandsSubmitted() / FRAMES),
+                (unsigned long long)(queue.getDrawCalls() / FRAMES), (double)queue.getStateChanges() / FRAMES, (double)queue.getStateChangesSkipped() / FRAMES);
+    std::printf("speedup: %.2fx\n", immediate_ms / queued_ms);
+
+    // Clean up
+    for (SDL_Texture *texture : textures)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    SDL_DestroyRenderer(pRenderer);
+    SDL_DestroySurface(pTarget);
+    SDL_Quit();
+
+    return 0;
+}
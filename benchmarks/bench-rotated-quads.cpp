@@ -0,0 +1,196 @@
+#include "MQuadGenerator.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Constants for the checks and the benchmark workload
+constexpr double MAX_TRIG_ERROR{1e-6};         // Largest sine or cosine error accepted from the polynomial
+constexpr double MAX_POSITION_ERROR{1e-3};     // Largest vertex position difference with the scalar kernel accepted, in pixels
+constexpr float SWEEP_FIRST_DEGREE{-1080.f};   // First angle of the sine and cosine sweep
+constexpr float SWEEP_STEP_DEGREE{0.01f};      // Step of the sweep
+constexpr int SWEEP_COUNT{216001};             // Number of angles of the sweep (three turns each way)
+constexpr int QUADS_PER_MEASUREMENT{10000000}; // Number of quads generated for each measurement, whatever the batch size
+constexpr int QUAD_COUNTS[]{100, 10000, 100000};
+constexpr MQuadGenerator::Kernel KERNELS[]{MQuadGenerator::KERNEL_SCALAR, MQuadGenerator::KERNEL_SSE2, MQuadGenerator::KERNEL_AVX2};
+
+// Structure to hold the arrays of a batch of quads
+struct QuadData
+{
+    std::vector<float> center_x;
+    std::vector<float> center_y;
+    std::vector<float> half_w;
+    std::vector<float> half_h;
+    std::vector<float> degree;
+    std::vector<SDL_FPoint> tex_min;
+    std::vector<SDL_FPoint> tex_max;
+
+    // Function to get the pointers the generator reads
+    MQuadArrays getArrays() const { return {center_x.data(), center_y.data(), half_w.data(), half_h.data(), degree.data(), tex_min.data(), tex_max.data()}; }
+};
+
+// Function to generate a deterministic batch of quads on a 4K screen, with every flip mode and angles from -720 to 720 degrees
+QuadData generateQuads(const int count)
+{
+    QuadData data{};
+    Uint32 seed{12345};
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u; // Linear congruential generator: same workload on every run
+        data.center_x.push_back((float)(seed % 3840));
+        data.center_y.push_back((float)((seed >> 12) % 2160));
+        data.half_w.push_back((float)(1 + (seed >> 4) % 128));
+        data.half_h.push_back((float)(1 + (seed >> 9) % 128));
+        data.degree.push_back((float)((int)(seed >> 8) % 144000) / 100.f - 720.f);
+
+        // The flip is a swap of the texture coordinates, like MSpriteSystem stores them
+        const SDL_FlipMode flip_mode = (SDL_FlipMode)(i % 4);
+        SDL_FPoint min{0.25f, 0.5f}, max{0.75f, 1.f};
+        if (flip_mode & SDL_FLIP_HORIZONTAL)
+        {
+            std::swap(min.x, max.x);
+        }
+        if (flip_mode & SDL_FLIP_VERTICAL)
+        {
+            std::swap(min.y, max.y);
+        }
+        data.tex_min.push_back(min);
+        data.tex_max.push_back(max);
+    }
+    return data;
+}
+
+// Function to measure the largest sine and cosine error of a kernel, on a sweep of angles
+double measureTrigError(const MQuadGenerator &generator)
+{
+    // With a half width of 1, a half height of 0 and the center at 0, the top-right corner is (cos, sin)
+    QuadData sweep{};
+    for (int i = 0; i < SWEEP_COUNT; i++)
+    {
+        sweep.center_x.push_back(0.f);
+        sweep.center_y.push_back(0.f);
+        sweep.half_w.push_back(1.f);
+        sweep.half_h.push_back(0.f);
+        sweep.degree.push_back(SWEEP_FIRST_DEGREE + SWEEP_STEP_DEGREE * (float)i);
+        sweep.tex_min.push_back(SDL_FPoint{0.f, 0.f});
+        sweep.tex_max.push_back(SDL_FPoint{1.f, 1.f});
+    }
+    std::vector<SDL_Vertex> vertices((size_t)SWEEP_COUNT * 4);
+    generator.generate(sweep.getArrays(), SWEEP_COUNT, vertices.data());
+
+    double max_error{0.0};
+    for (int i = 0; i < SWEEP_COUNT; i++)
+    {
+        const double radians = (double)sweep.degree[i] * (SDL_PI_D / 180.0);
+        const SDL_FPoint &corner = vertices[(size_t)i * 4 + 1].position;
+        max_error = SDL_max(max_error, std::fabs((double)corner.x - std::cos(radians)));
+        max_error = SDL_max(max_error, std::fabs((double)corner.y - std::sin(radians)));
+    }
+    return max_error;
+}
+
+// Function to compare the vertices of a kernel with the ones of the scalar kernel: largest position difference, -1 if a color or texture coordinate differs
+double measurePositionError(const std::vector<SDL_Vertex> &reference, const std::vector<SDL_Vertex> &vertices)
+{
+    double max_error{0.0};
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        if (std::memcmp(&reference[i].color, &vertices[i].color, sizeof(SDL_FColor)) != 0 || std::memcmp(&reference[i].tex_coord, &vertices[i].tex_coord, sizeof(SDL_FPoint)) != 0)
+        {
+            return -1.0;
+        }
+        max_error = SDL_max(max_error, (double)std::fabs(reference[i].position.x - vertices[i].position.x));
+        max_error = SDL_max(max_error, (double)std::fabs(reference[i].position.y - vertices[i].position.y));
+    }
+    return max_error;
+}
+
+// Function to run the accuracy checks of every supported kernel, returns the number of failed checks
+int runChecks()
+{
+    const int count = QUAD_COUNTS[2] + 3; // Not a multiple of 8: the last quads go through the scalar tail of the SIMD kernels
+    const QuadData data = generateQuads(count);
+    std::vector<SDL_Vertex> reference((size_t)count * 4), vertices((size_t)count * 4), sse2_vertices;
+    MQuadGenerator(MQuadGenerator::KERNEL_SCALAR).generate(data.getArrays(), count, reference.data());
+
+    int failures{0};
+    std::printf("%8s %14s %18s %s\n", "kernel", "trig error", "position error", "result");
+    for (const MQuadGenerator::Kernel kernel : KERNELS)
+    {
+        if (!MQuadGenerator::isSupported(kernel))
+        {
+            std::printf("%8s %14s %18s %s\n", MQuadGenerator::getKernelName(kernel), "-", "-", "not supported by this CPU");
+            continue;
+        }
+
+        const MQuadGenerator generator(kernel);
+        generator.generate(data.getArrays(), count, vertices.data());
+        const double trig_error = measureTrigError(generator);
+        const double position_error = measurePositionError(reference, vertices);
+        bool passed = trig_error <= MAX_TRIG_ERROR && position_error >= 0.0 && position_error <= MAX_POSITION_ERROR;
+
+        // The scalar kernel is the reference: its trig error (std::sin of a float angle in radians) is only reported
+        if (kernel == MQuadGenerator::KERNEL_SCALAR)
+        {
+            std::printf("%8s %14.3g %18s %s\n", MQuadGenerator::getKernelName(kernel), trig_error, "-", "reference");
+            continue;
+        }
+
+        // The AVX2 kernel does the operations of the SSE2 kernel on twice the lanes: the vertices must be identical
+        if (kernel == MQuadGenerator::KERNEL_SSE2)
+        {
+            sse2_vertices = vertices;
+        }
+        else if (kernel == MQuadGenerator::KERNEL_AVX2 && !sse2_vertices.empty())
+        {
+            passed = passed && std::memcmp(sse2_vertices.data(), vertices.data(), vertices.size() * sizeof(SDL_Vertex)) == 0;
+        }
+
+        failures += passed ? 0 : 1;
+        std::printf("%8s %14.3g %18.3g %s\n", MQuadGenerator::getKernelName(kernel), trig_error, position_error, passed ? "ok" : "FAILED");
+    }
+    return failures;
+}
+
+// Function to measure the throughput of a kernel, in millions of quads per second
+double measureThroughput(const MQuadGenerator &generator, const QuadData &data, const int count)
+{
+    std::vector<SDL_Vertex> vertices((size_t)count * 4);
+    const MQuadArrays quads = data.getArrays();
+    const int repeats = SDL_max(QUADS_PER_MEASUREMENT / count, 1);
+    generator.generate(quads, count, vertices.data()); // Warm up the caches
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int repeat = 0; repeat < repeats; repeat++)
+    {
+        generator.generate(quads, count, vertices.data());
+    }
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    return (double)count * repeats / seconds / 1e6;
+}
+
+int main()
+{
+    // Accuracy first: a throughput of a wrong output is worthless
+    const int failures = runChecks();
+
+    std::printf("\n%10s %8s %14s %10s\n", "quads", "kernel", "Mquads/s", "speedup");
+    for (const int count : QUAD_COUNTS)
+    {
+        const QuadData data = generateQuads(count);
+        double scalar_rate{0.0};
+        for (const MQuadGenerator::Kernel kernel : KERNELS)
+        {
+            if (!MQuadGenerator::isSupported(kernel))
+            {
+                continue;
+            }
+            const double rate = measureThroughput(MQuadGenerator(kernel), data, count);
+            scalar_rate = kernel == MQuadGenerator::KERNEL_SCALAR ? rate : scalar_rate;
+            std::printf("%10d %8s %14.1f %9.2fx\n", count, MQuadGenerator::getKernelName(kernel), rate, rate / scalar_rate);
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+#include <SDL3/SDL.h>
+#include "MSurfaceBlitter.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+// Constants for the benchmark workload
+constexpr int SOURCE_WIDTH{320};      // Width of the generated source image (half of the tutorial 01 window)
+constexpr int SOURCE_HEIGHT{240};     // Height of the generated source image
+constexpr int BLIT_PIXELS{200000000}; // Destination pixels written for each measurement, so that every size runs for a similar time
+
+// Destination sizes: the tutorial 01 window, 1080p and 4K
+constexpr SDL_Point DESTINATION_SIZES[]{{640, 480}, {1920, 1080}, {3840, 2160}};
+
+// Function to create the source image: a gradient with some noise, so that the linear filter has work to do
+SDL_Surface *createSource()
+{
+    SDL_Surface *surface = SDL_CreateSurface(SOURCE_WIDTH, SOURCE_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create source surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+    for (int y = 0; y < surface->h; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+        for (int x = 0; x < surface->w; x++)
+        {
+            const Uint32 noise = ((Uint32)x * 2654435761u) ^ ((Uint32)y * 40503u);
+            row[x] = SDL_MapSurfaceRGB(surface, (Uint8)(x * 255 / surface->w), (Uint8)(y * 255 / surface->h), (Uint8)(noise >> 24));
+        }
+    }
+    return surface;
+}
+
+// Function to measure one blit path, in milliseconds per blit (blitter == nullptr measures SDL_BlitSurfaceScaled)
+double measureBlit(MSurfaceBlitter *blitter, SDL_Surface *source, SDL_Surface *destination, const SDL_ScaleMode scale_mode, const bool fill)
+{
+    const int blits = std::max(BLIT_PIXELS / (destination->w * destination->h), 4);
+    const Uint32 white = SDL_MapSurfaceRGB(destination, 255, 255, 255);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < blits; i++)
+    {
+        // The tutorial loop clears the screen first, unless the blit covers it
+        if (fill)
+        {
+            SDL_FillSurfaceRect(destination, nullptr, white);
+        }
+        if (blitter != nullptr)
+        {
+            blitter->blitScaled(source, nullptr, destination, nullptr, scale_mode);
+        }
+        else
+        {
+            SDL_BlitSurfaceScaled(source, nullptr, destination, nullptr, scale_mode);
+        }
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency() / blits;
+}
+
+// Function to compute the largest channel difference between two surfaces of the same size and format
+int maxDifference(const SDL_Surface *a, const SDL_Surface *b)
+{
+    int difference{0};
+    for (int y = 0; y < a->h; y++)
+    {
+        const Uint8 *row_a = (const Uint8 *)a->pixels + (size_t)y * a->pitch;
+        const Uint8 *row_b = (const Uint8 *)b->pixels + (size_t)y * b->pitch;
+        for (int x = 0; x < a->w * 4; x++)
+        {
+            difference = std::max(difference, std::abs(row_a[x] - row_b[x]));
+        }
+    }
+    return difference;
+}
+
+int main()
+{
+    if (!SDL_Init(0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Surface *source = createSource();
+    if (source == nullptr)
+    {
+        SDL_Quit();
+        return 1;
+    }
+
+    // The SDL blitter is the reference, then every kernel the CPU supports
+    const MSurfaceBlitter::Kernel kernels[]{MSurfaceBlitter::KERNEL_SCALAR, MSurfaceBlitter::KERNEL_SSE2, MSurfaceBlitter::KERNEL_AVX2};
+    const SDL_ScaleMode scale_modes[]{SDL_SCALEMODE_NEAREST, SDL_SCALEMODE_LINEAR};
+
+    std::printf("source %dx%d XRGB8888\n", SOURCE_WIDTH, SOURCE_HEIGHT);
+    std::printf("%10s %8s %8s %12s %10s %10s %14s %12s\n", "size", "mode", "path", "ms/blit", "Mpix/s", "speedup", "fill+blit ms", "max diff");
+
+    for (const SDL_Point &size : DESTINATION_SIZES)
+    {
+        SDL_Surface *reference = SDL_CreateSurface(size.x, size.y, SDL_PIXELFORMAT_XRGB8888);
+        SDL_Surface *destination = SDL_CreateSurface(size.x, size.y, SDL_PIXELFORMAT_XRGB8888);
+        if (reference == nullptr || destination == nullptr)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create %dx%d surface: %s\n", size.x, size.y, SDL_GetError());
+            SDL_DestroySurface(reference);
+            SDL_DestroySurface(destination);
+            continue;
+        }
+        char size_name[32];
+        std::snprintf(size_name, sizeof(size_name), "%dx%d", size.x, size.y);
+        const double megapixels = (double)size.x * size.y / 1e6;
+
+        for (const SDL_ScaleMode scale_mode : scale_modes)
+        {
+            const char *mode_name = scale_mode == SDL_SCALEMODE_NEAREST ? "nearest" : "linear";
+
+            // SDL's blitter, with the white fill of the tutorial loop and without it
+            const double sdl_ms = measureBlit(nullptr, source, reference, scale_mode, false);
+            const double sdl_fill_ms = measureBlit(nullptr, source, reference, scale_mode, true);
+            std::printf("%10s %8s %8s %12.3f %10.1f %10s %14.3f %12s\n", size_name, mode_name, "sdl", sdl_ms, megapixels / sdl_ms * 1000.0, "1.00x", sdl_fill_ms, "-");
+
+            for (const MSurfaceBlitter::Kernel kernel : kernels)
+            {
+                if (!MSurfaceBlitter::isSupported(kernel))
+                {
+                    continue;
+                }
+                MSurfaceBlitter blitter(kernel);
+                const double kernel_ms = measureBlit(&blitter, source, destination, scale_mode, false);
+                const double kernel_fill_ms = measureBlit(&blitter, source, destination, scale_mode, true);
+
+                // The difference with SDL comes from the rounding of the filter weights, not from the kernels: they all give the same pixels
+                std::printf("%10s %8s %8s %12.3f %10.1f %9.2fx %14.3f %12d\n", size_name, mode_name, MSurfaceBlitter::getKernelName(kernel), kernel_ms, megapixels / kernel_ms * 1000.0, sdl_ms / kernel_ms, kernel_fill_ms, maxDifference(reference, destination));
+                if (blitter.getFallbackCount() > 0)
+                {
+                    std::printf("%10s %8s %8s %llu blits handed to SDL\n", "", "", "", (unsigned long long)blitter.getFallbackCount());
+                }
+            }
+        }
+
+        SDL_DestroySurface(reference);
+        SDL_DestroySurface(destination);
+    }
+
+    SDL_DestroySurface(source);
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <SDL3/SDL.h>
+#include "MSurfaceBlitter.hpp"
+#include "MScaledSurfaceCache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Constants for the benchmark workload
+constexpr int DEFAULT_FRAMES{500}; // Number of frames drawn for each path, unless given on the command line
+constexpr int RESIZE_PERIOD{60};   // Frames between two simulated window resizes in the resize path
+
+// Window sizes: the tutorial 01 window and a maximized 1080p window
+constexpr SDL_Point SCREEN_SIZES[]{{640, 480}, {1920, 1080}};
+
+// Paths of the tutorial 01 frame
+enum FramePath
+{
+    PATH_SDL,          // White fill and SDL_BlitSurfaceScaled every frame (tutorial 01 before the cache)
+    PATH_SIMD,         // Fill skipped and MSurfaceBlitter every frame
+    PATH_CACHE,        // Unscaled copy of the scaled surface kept by MScaledSurfaceCache
+    PATH_CACHE_RESIZE  // Same as PATH_CACHE, with a window resize every RESIZE_PERIOD frames
+};
+
+// Structure to hold the measurements of one path
+struct PathResult
+{
+    double mean_ms;       // Mean CPU time of a frame
+    double p99_ms;        // 99th percentile CPU time of a frame
+    double max_ms;        // Slowest frame
+    Uint64 rebuild_count; // Number of times the cache scaled the image
+};
+
+// Function to load the 01 image, or an equivalent generated image when the bitmap is not available
+SDL_Surface *loadImage(const std::string &assets_dir)
+{
+    SDL_Surface *image = SDL_LoadBMP((assets_dir + "/01hello-world.bmp").c_str());
+    if (image == nullptr)
+    {
+        // Half the window size, as the tutorial image
+        image = SDL_CreateSurface(320, 240, SDL_PIXELFORMAT_XRGB8888);
+        for (int y = 0; image != nullptr && y < image->h; y++)
+        {
+            Uint32 *row = (Uint32 *)((Uint8 *)image->pixels + (size_t)y * image->pitch);
+            for (int x = 0; x < image->w; x++)
+            {
+                row[x] = SDL_MapSurfaceRGB(image, (Uint8)(x * 255 / image->w), (Uint8)(y * 255 / image->h), (Uint8)((x ^ y) & 0xFF));
+            }
+        }
+    }
+    return image;
+}
+
+// Function to draw the frames of one path into a surface of the window size, measuring the CPU time of each frame
+PathResult runPath(const FramePath path, SDL_Surface *image, const SDL_Point &size, const int frames)
+{
+    PathResult result{0.0, 0.0, 0.0, 0};
+    SDL_Surface *screen = SDL_CreateSurface(size.x, size.y, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Surface *resized_screen = SDL_CreateSurface(size.x - size.x / 8, size.y - size.y / 8, SDL_PIXELFORMAT_XRGB8888);
+    if (screen == nullptr || resized_screen == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create screen surface: %s\n", SDL_GetError());
+        SDL_DestroySurface(screen);
+        SDL_DestroySurface(resized_screen);
+        return result;
+    }
+
+    // The image is converted to the screen format once, as tutorial 01 does after loading
+    SDL_Surface *converted = SDL_ConvertSurface(image, screen->format);
+    if (converted == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not convert the image: %s\n", SDL_GetError());
+        SDL_DestroySurface(screen);
+        SDL_DestroySurface(resized_screen);
+        return result;
+    }
+    MSurfaceBlitter blitter;
+    MScaledSurfaceCache cache;
+    std::vector<double> frame_ms;
+    frame_ms.reserve(frames);
+
+    SDL_Surface *target = screen;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        // A resize replaces the window surface and invalidates the cache, as the SDL_EVENT_WINDOW_RESIZED handler of tutorial 01
+        if (path == PATH_CACHE_RESIZE && frame > 0 && frame % RESIZE_PERIOD == 0)
+        {
+            target = target == screen ? resized_screen : screen;
+            cache.invalidate();
+        }
+        const SDL_Rect destination_rect{0, 0, target->w, target->h};
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        switch (path)
+        {
+        case PATH_SDL:
+            SDL_FillSurfaceRect(target, nullptr, SDL_MapSurfaceRGB(target, 255, 255, 255));
+            SDL_BlitSurfaceScaled(converted, nullptr, target, &destination_rect, SDL_SCALEMODE_LINEAR);
+            break;
+        case PATH_SIMD:
+            if (!MSurfaceBlitter::coversSurface(converted, target, &destination_rect))
+            {
+                SDL_FillSurfaceRect(target, nullptr, SDL_MapSurfaceRGB(target, 255, 255, 255));
+            }
+            blitter.blitScaled(converted, nullptr, target, &destination_rect, SDL_SCALEMODE_LINEAR);
+            break;
+        case PATH_CACHE:
+        case PATH_CACHE_RESIZE:
+            cache.blit(converted, target, &destination_rect, SDL_SCALEMODE_LINEAR);
+            break;
+        }
+        frame_ms.push_back((double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    }
+
+    // Statistics of the frame times
+    std::sort(frame_ms.begin(), frame_ms.end());
+    for (const double ms : frame_ms)
+    {
+        result.mean_ms += ms / frame_ms.size();
+    }
+    result.p99_ms = frame_ms[(frame_ms.size() * 99) / 100];
+    result.max_ms = frame_ms.back();
+    result.rebuild_count = cache.getRebuildCount();
+
+    cache.invalidate();
+    SDL_DestroySurface(converted);
+    SDL_DestroySurface(screen);
+    SDL_DestroySurface(resized_screen);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    const int frames = argc > 1 ? std::max(std::atoi(argv[1]), 1) : DEFAULT_FRAMES;
+    const std::string assets_dir = argc > 2 ? argv[2] : "../assets";
+
+    if (!SDL_Init(0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Surface *image = loadImage(assets_dir);
+    if (image == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not load or create the image: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    const char *path_names[]{"sdl fill+scale", "simd scale", "cache", "cache+resize"};
+    std::printf("%d frames per path, image %dx%d, resize every %d frames in the resize path\n", frames, image->w, image->h, RESIZE_PERIOD);
+    std::printf("%10s %16s %10s %10s %10s %10s %10s\n", "size", "path", "mean ms", "p99 ms", "max ms", "speedup", "rebuilds");
+
+    for (const SDL_Point &size : SCREEN_SIZES)
+    {
+        char size_name[32];
+        std::snprintf(size_name, sizeof(size_name), "%dx%d", size.x, size.y);
+
+        double baseline_ms{0.0};
+        for (const FramePath path : {PATH_SDL, PATH_SIMD, PATH_CACHE, PATH_CACHE_RESIZE})
+        {
+            const PathResult result = runPath(path, image, size, frames);
+            if (path == PATH_SDL)
+            {
+                baseline_ms = result.mean_ms;
+            }
+            std::printf("%10s %16s %10.4f %10.4f %10.4f %9.2fx %10llu\n", size_name, path_names[path], result.mean_ms, result.p99_ms, result.max_ms,
+                        result.mean_ms > 0.0 ? baseline_ms / result.mean_ms : 0.0, (unsigned long long)result.rebuild_count);
+        }
+    }
+
+    SDL_DestroySurface(image);
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,370 @@
+#include "MTexture.hpp"
+#include "MSurfaceArena.hpp"
+#include "MAtlasPacker.hpp"
+#include "MRotationCache.hpp"
+#include "MAllocTracker.hpp"
+#include "MScene01.hpp"
+#include "MScene04.hpp"
+#include "MScene05.hpp"
+#include "MScene06.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Constants for the render target and the benchmark workload
+constexpr int SCREEN_WIDTH{640};   // Same window size as the tutorials
+constexpr int SCREEN_HEIGHT{480};
+constexpr int DEFAULT_FRAMES{500}; // Number of frames rendered for each scene, unless given on the command line
+constexpr int KEY_TOGGLE_FRAMES{30}; // Frames between two toggles of the 04 color key, like a key press that composites the layer again
+constexpr int ROTATION_BUCKETS{12};  // Angles cached in a turn, as tutorial 06 does
+
+// Vector grown by the tracker check: a global, so that the compiler cannot remove the allocation
+std::vector<int> check_buffer{};
+
+// Structure to hold the resources shared by the scenes: each frame is drawn by the scene class of its tutorial
+struct SceneContext
+{
+    SDL_Window *surface_window;  // Window drawn through its surface (tutorial 01)
+    SDL_Surface *screen_surface; // Surface of surface_window
+    SDL_Window *render_window;   // Window drawn through the software renderer (tutorials 04-06)
+    SDL_Renderer *renderer;      // Software renderer of render_window
+
+    SDL_Surface *image_surface;                                                    // 01: image scaled to the whole screen, in the screen format
+    MScene01 blit_scene{SCREEN_WIDTH, SCREEN_HEIGHT};                              // 01: scaled cache and dirty rectangles
+    MSurfaceArena arena;                                                           // 04: arena the images are decoded into
+    MTexture background;                                                           // 04: streaming background, swapped in place on the first key removal
+    MTexture sprite;                                                               // 04: sprite with both color key variants
+    MScene04 keyed_scene{background, sprite, SCREEN_WIDTH, SCREEN_HEIGHT};         // 04: composited layer, replayed with a single draw
+    MTexture sheet;                                                                // 05: atlas page holding the sprite sheet
+    MAtlasRegion sheet_region;                                                     // 05: region of the sprite sheet in the atlas page
+    MScene05 clip_scene{SCREEN_WIDTH, SCREEN_HEIGHT};                              // 05: clipped and stretched sprites in a cached layer
+    MTexture arrow;                                                                // 06: arrow rotated and flipped every frame
+    MRotationCache rotation_cache{ROTATION_BUCKETS};                               // 06: arrow pre-rotated for the software renderer
+    MScene06 rotation_scene{arrow, &rotation_cache, SCREEN_WIDTH, SCREEN_HEIGHT}; // 06: arrow drawn from the rotation cache
+};
+
+// Structure to describe one scene
+struct Scene
+{
+    const char *name;                                  // Name reported in the JSON output
+    bool (*load)(SceneContext &, const std::string &); // Function to load the scene resources from the assets directory
+    Uint64 (*render)(SceneContext &, const int frame); // Function to render one frame, returning the number of draw calls counted by the scene
+};
+
+// Function to load the 01 image, or an equivalent generated image when the bitmap is not available, in the screen format as 01-main.cpp does
+bool loadBlitScene(SceneContext &context, const std::string &assets_dir)
+{
+    if (context.image_surface = SDL_LoadBMP((assets_dir + "/01hello-world.bmp").c_str()); context.image_surface == nullptr)
+    {
+        // Same work for the scaled blit: a half-resolution image stretched to the window
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "01hello-world.bmp not found, blitting a generated image instead\n");
+        if (context.image_surface = SDL_CreateSurface(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2, SDL_PIXELFORMAT_XRGB8888); context.image_surface == nullptr)
+        {
+            return false;
+        }
+        for (int y = 0; y < context.image_surface->h; y += 16)
+        {
+            const SDL_Rect band{0, y, context.image_surface->w, 16};
+            SDL_FillSurfaceRect(context.image_surface, &band, SDL_MapSurfaceRGB(context.image_surface, (Uint8)y, 0x80, (Uint8)(0xFF - y)));
+        }
+    }
+
+    // Converted once to the screen format, so that the scene blits with a plain copy
+    if (context.image_surface->format != context.screen_surface->format)
+    {
+        SDL_Surface *converted_surface = SDL_ConvertSurface(context.image_surface, context.screen_surface->format);
+        SDL_DestroySurface(context.image_surface);
+        context.image_surface = converted_surface;
+    }
+    return context.image_surface != nullptr;
+}
+
+// Function to render the 01 frame through the tutorial scene: the window content is lost every frame (expose), so every pixel is redrawn
+Uint64 renderBlitScene(SceneContext &context, const int)
+{
+    const Uint64 draw_calls = context.blit_scene.getDrawCalls();
+    context.blit_scene.invalidate();
+    context.blit_scene.render(context.image_surface, context.screen_surface, context.surface_window);
+    return context.blit_scene.getDrawCalls() - draw_calls;
+}
+
+// Function to load the 04 backgrounds into one streaming texture and the sprite with both color key variants, as 04-main.cpp does
+bool loadKeyedScene(SceneContext &context, const std::string &assets_dir)
+{
+    SDL_Surface *background_surface = context.arena.load(assets_dir + "/04background0.png");
+    SDL_Surface *swap_surface = context.arena.load(assets_dir + "/04background1.png");
+    SDL_Rect swap_rect{};
+    const bool loaded = background_surface != nullptr && swap_surface != nullptr && context.background.loadStreaming(background_surface, context.renderer) &&
+                        MScene04::findChangedRect(background_surface, swap_surface, swap_rect);
+    if (loaded)
+    {
+        context.keyed_scene.setBackgroundSwap(swap_surface, swap_rect);
+    }
+    context.arena.release(background_surface);
+
+    const SDL_Color cyan{0x00, 0xFF, 0xFF, 0xFF};
+    return loaded && context.sprite.loadTexture(assets_dir + "/04sprite.png", context.renderer, context.arena, &cyan, true);
+}
+
+// Function to render the 04 frame through the tutorial scene, toggling the color key as a key press does
+Uint64 renderKeyedScene(SceneContext &context, const int frame)
+{
+    const Uint64 draw_calls = context.keyed_scene.getDrawCalls();
+    context.keyed_scene.render(context.renderer, (frame / KEY_TOGGLE_FRAMES) % 2 == 1);
+    SDL_RenderPresent(context.renderer);
+    return context.keyed_scene.getDrawCalls() - draw_calls;
+}
+
+// Function to load the 05 sprite sheet through the atlas, as 05-main.cpp does
+bool loadClipScene(SceneContext &context, const std::string &assets_dir)
+{
+    MAtlasPacker atlas{512};
+    const SDL_Color white_key{0xFF, 0xFF, 0xFF, 0xFF};
+    const std::string sheet_path = assets_dir + "/05dots.png";
+    if (!atlas.addImage(sheet_path, &white_key) || !atlas.pack())
+    {
+        return false;
+    }
+    const MAtlasRegion *region = atlas.findRegion(sheet_path);
+    if (region == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "The atlas has no region for %s\n", sheet_path.c_str());
+        return false;
+    }
+    context.sheet_region = *region;
+    return context.sheet.loadTexture(atlas.getPage(context.sheet_region.page), context.renderer);
+}
+
+// Function to render the 05 frame through the tutorial scene: the sprites are rendered into the layer on the first frame, then replayed
+Uint64 renderClipScene(SceneContext &context, const int)
+{
+    const Uint64 draw_calls = context.clip_scene.getDrawCalls();
+    context.clip_scene.render(context.renderer, context.sheet_region, context.sheet.getTexture());
+    SDL_RenderPresent(context.renderer);
+    return context.clip_scene.getDrawCalls() - draw_calls;
+}
+
+// Function to load the 06 arrow with its white background keyed out, and pre-rotate it as 06-main.cpp does on the software renderer
+bool loadRotationScene(SceneContext &context, const std::string &assets_dir)
+{
+    const SDL_Color white{0xFF, 0xFF, 0xFF, 0xFF};
+    const std::string arrow_path = assets_dir + "/06arrow.png";
+    if (!context.arrow.loadTexture(arrow_path, context.renderer, &white))
+    {
+        return false;
+    }
+    SDL_Surface *keyed_surface = IMG_Load(arrow_path.c_str());
+    const bool loaded = keyed_surface != nullptr && SDL_SetSurfaceColorKey(keyed_surface, true, SDL_MapSurfaceRGB(keyed_surface, white.r, white.g, white.b)) &&
+                        context.rotation_cache.load(keyed_surface) && context.rotation_cache.buildAll(context.renderer);
+    SDL_DestroySurface(keyed_surface);
+    return loaded;
+}
+
+// Function to render the 06 frame through the tutorial scene: the arrow turned by 30 degrees more every frame, cycling the flip modes
+Uint64 renderRotationScene(SceneContext &context, const int frame)
+{
+    const SDL_FlipMode flip_modes[3]{SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL};
+    const Uint64 draw_calls = context.rotation_scene.getDrawCalls();
+    context.rotation_scene.render(context.renderer, (float)((frame * 30) % 360), flip_modes[(frame / 12) % 3]);
+    SDL_RenderPresent(context.renderer);
+    return context.rotation_scene.getDrawCalls() - draw_calls;
+}
+
+// Structure to hold the measurements of one scene
+struct SceneResult
+{
+    const char *name;             // Name of the scene
+    bool loaded;                  // Flag to indicate if the scene resources could be loaded
+    std::vector<double> frame_ms; // Time of every frame
+    Uint64 draw_calls_total;      // Draw calls of every measured frame, counted by the scene
+    Uint64 draw_calls_max;        // Largest number of draw calls in one frame
+    double allocations_mean;      // Mean number of heap allocations per frame
+    Uint64 allocations_max;       // Largest number of heap allocations in one frame
+    Uint64 cpp_allocations_max;   // Largest number of operator new calls in one frame
+    Uint64 sdl_allocations_max;   // Largest number of SDL allocations in one frame
+    Uint64 violations;            // Number of measured frames where the C++ code allocated
+};
+
+// Function to check the strict mode of the tracker on frames with and without allocations; returns the number of failed checks
+int checkTracker()
+{
+    if constexpr (MALLOC_TRACKER_ENABLED == 0)
+    {
+        return 0; // Nothing is counted
+    }
+    const Uint64 violations = MAllocTracker::getViolationCount();
+    MAllocTracker::setStrict(true);
+
+    // A steady-state frame that allocates once through each allocator is reported
+    MAllocTracker::beginFrame();
+    check_buffer.reserve(check_buffer.capacity() + 64);
+    SDL_free(SDL_malloc(64));
+    MAllocTracker::endFrame();
+    const MAllocTracker::Counts allocating = MAllocTracker::getLastFrame();
+    bool passed = allocating.cpp == 1 && allocating.sdl == 1 && MAllocTracker::getViolationCount() == violations + 1;
+
+    // An excused frame may allocate, and a frame that does not allocate is never reported
+    MAllocTracker::beginFrame();
+    MAllocTracker::expectAllocations();
+    check_buffer.reserve(check_buffer.capacity() + 64);
+    MAllocTracker::endFrame();
+    MAllocTracker::beginFrame();
+    check_buffer.assign(16, 1);
+    MAllocTracker::endFrame();
+    passed = passed && MAllocTracker::getLastFrame().cpp == 0 && MAllocTracker::getViolationCount() == violations + 1;
+
+    MAllocTracker::setStrict(false);
+    std::fprintf(stderr, "allocation tracker strict mode: %s\n", passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+// Function to get a percentile of sorted frame times
+double percentile(const std::vector<double> &sorted_ms, const int percent)
+{
+    return sorted_ms.empty() ? 0.0 : sorted_ms[(sorted_ms.size() - 1) * percent / 100];
+}
+
+// Function to render the frames of one scene and measure each of them
+SceneResult runScene(SceneContext &context, const Scene &scene, const std::string &assets_dir, const int frames)
+{
+    SceneResult result{scene.name, false, {}, 0, 0, 0.0, 0, 0, 0, 0};
+    if (result.loaded = scene.load(context, assets_dir); !result.loaded)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load scene %s\n", scene.name);
+        return result;
+    }
+    result.frame_ms.reserve(frames); // Reserved up front, so that the measurement does not allocate
+
+    // The first frame warms the caches of the renderer up and is not measured
+    scene.render(context, 0);
+
+    // Every measured frame is a steady-state frame: the C++ code must not allocate (the software renderer allocates on its own, e.g. to rotate)
+    const Uint64 violations = MAllocTracker::getViolationCount();
+    MAllocTracker::setStrict(true, 0, false);
+
+    Uint64 allocations_total{0};
+    for (int frame = 1; frame <= frames; frame++)
+    {
+        MAllocTracker::beginFrame();
+        const Uint64 start = SDL_GetPerformanceCounter();
+
+        const Uint64 draw_calls = scene.render(context, frame);
+
+        const Uint64 end = SDL_GetPerformanceCounter();
+        const Uint64 allocations = MAllocTracker::endFrame();
+        const MAllocTracker::Counts split = MAllocTracker::getLastFrame();
+        result.frame_ms.push_back((double)(end - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+        allocations_total += allocations;
+        result.draw_calls_total += draw_calls;
+        result.draw_calls_max = std::max(result.draw_calls_max, draw_calls);
+        result.allocations_max = std::max(result.allocations_max, allocations);
+        result.cpp_allocations_max = std::max(result.cpp_allocations_max, split.cpp);
+        result.sdl_allocations_max = std::max(result.sdl_allocations_max, split.sdl);
+    }
+    MAllocTracker::setStrict(false);
+    result.allocations_mean = (double)allocations_total / frames;
+    result.violations = MAllocTracker::getViolationCount() - violations;
+    std::sort(result.frame_ms.begin(), result.frame_ms.end());
+
+    return result;
+}
+
+// Function to print the measurements as JSON
+void printJson(const std::vector<SceneResult> &results, const SceneContext &context, const int frames)
+{
+    std::printf("{\n");
+    std::printf("  \"video_driver\": \"%s\",\n", SDL_GetCurrentVideoDriver());
+    std::printf("  \"renderer\": \"%s\",\n", SDL_GetRendererName(context.renderer));
+    std::printf("  \"frames\": %d,\n", frames);
+    std::printf("  \"scenes\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const SceneResult &result = results[i];
+        double mean_ms{0.0};
+        for (const double frame_ms : result.frame_ms)
+        {
+            mean_ms += frame_ms / result.frame_ms.size();
+        }
+
+        std::printf("    {\n");
+        std::printf("      \"name\": \"%s\",\n", result.name);
+        std::printf("      \"loaded\": %s,\n", result.loaded ? "true" : "false");
+        std::printf("      \"frame_ms\": {\"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n", mean_ms,
+                    percentile(result.frame_ms, 50), percentile(result.frame_ms, 90), percentile(result.frame_ms, 99), percentile(result.frame_ms, 100));
+        std::printf("      \"draw_calls_per_frame\": {\"mean\": %.2f, \"max\": %llu},\n", result.frame_ms.empty() ? 0.0 : (double)result.draw_calls_total / result.frame_ms.size(),
+                    (unsigned long long)result.draw_calls_max);
+        std::printf("      \"allocations_per_frame\": {\"mean\": %.2f, \"max\": %llu, \"cpp_max\": %llu, \"sdl_max\": %llu},\n", result.allocations_mean,
+                    (unsigned long long)result.allocations_max, (unsigned long long)result.cpp_allocations_max, (unsigned long long)result.sdl_allocations_max);
+        std::printf("      \"steady_state_violations\": %llu\n", (unsigned long long)result.violations);
+        std::printf("    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n");
+    std::printf("}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    // Count SDL's allocations from the very first one
+    MAllocTracker::install();
+
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_FRAMES;
+    const std::string assets_dir = argc > 2 ? argv[2] : "../assets";
+
+    // The offscreen driver needs no display: the environment (SDL_VIDEO_DRIVER) can still select another one
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // One window is drawn through its surface (01), the other one through the software renderer (04-06)
+    SceneContext context{};
+    context.surface_window = SDL_CreateWindow("bench-scenes 01", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    context.screen_surface = context.surface_window != nullptr ? SDL_GetWindowSurface(context.surface_window) : nullptr;
+    context.render_window = SDL_CreateWindow("bench-scenes 04-06", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_HIDDEN);
+    context.renderer = context.render_window != nullptr ? SDL_CreateRenderer(context.render_window, "software") : nullptr;
+    if (context.screen_surface == nullptr || context.renderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the offscreen windows: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    const Scene scenes[]{
+        {"01-blit", loadBlitScene, renderBlitScene},
+        {"04-keyed-composite", loadKeyedScene, renderKeyedScene},
+        {"05-clip-stretch-grid", loadClipScene, renderClipScene},
+        {"06-rotation", loadRotationScene, renderRotationScene},
+    };
+
+    // The tracker is checked first: a scene without violations only means something if violations are caught
+    int failures = checkTracker();
+    std::vector<SceneResult> results{};
+    for (const Scene &scene : scenes)
+    {
+        results.push_back(runScene(context, scene, assets_dir, frames));
+        failures += results.back().violations > 0 ? 1 : 0;
+    }
+    printJson(results, context, frames);
+
+    // Clean up (the layer and rotated textures belong to the renderer: destroy them first)
+    context.blit_scene.clear();
+    SDL_DestroySurface(context.image_surface);
+    context.keyed_scene.clear();
+    context.background.clear();
+    context.sprite.clear();
+    context.arena.releaseAll();
+    context.clip_scene.clear();
+    context.sheet.clear();
+    context.rotation_cache.clear();
+    context.arrow.clear();
+    SDL_DestroyRenderer(context.renderer);
+    SDL_DestroyWindow(context.render_window);
+    SDL_DestroyWindow(context.surface_window);
+    SDL_Quit();
+
+    return failures == 0 ? 0 : 1;
+}
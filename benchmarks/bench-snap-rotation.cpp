@@ -0,0 +1,242 @@
+#include "MAngleTable.hpp"
+#include "MRotationCache.hpp"
+#include "MSpriteBatch.hpp"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Constants for the render target and the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr int SPRITE_WIDTH{128};        // Size of the rotated sprite, like the arrow of tutorial 06
+constexpr int SPRITE_HEIGHT{64};        // Not square, so that the quarter turns swap width and height
+constexpr int BATCH_QUADS{100000};      // Number of quads added to the batch for each measurement
+constexpr int BATCH_REPEATS{20};        // Number of times the batch is filled for each measurement
+constexpr int DRAWS{2000};              // Number of rotated draws for each renderer measurement
+constexpr int ROTATION_BUCKETS{12};     // Angle buckets of the rotation cache: the 30 degree steps are exact
+constexpr double MAX_TABLE_ERROR{1e-7}; // Largest sine or cosine error of the table accepted
+constexpr double ARBITRARY_STEP{7.3};   // Angle step of the arbitrary rotations, never a multiple of 15 degrees
+
+// Structure to hold one workload of angles
+struct AngleSet
+{
+    const char *name;           // Name printed in the results
+    std::vector<double> angles; // Angles of the draws, cycled
+};
+
+// Function to create the sprite in memory, every pixel a different opaque color, so that the benchmark does not depend on the assets
+SDL_Surface *createSprite()
+{
+    SDL_Surface *surface = SDL_CreateSurface(SPRITE_WIDTH, SPRITE_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create sprite surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+    for (int y = 0; y < SPRITE_HEIGHT; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+        for (int x = 0; x < SPRITE_WIDTH; x++)
+        {
+            row[x] = 0xFF000000u | (Uint32)(x << 16) | (Uint32)(y << 8) | (Uint32)((x ^ y) & 0xFF);
+        }
+    }
+    return surface;
+}
+
+// Function to build the workloads: quarter turns, 30 degree steps (table) and arbitrary angles (trigonometry)
+std::vector<AngleSet> createAngleSets()
+{
+    std::vector<AngleSet> sets{{"quarter turns", {}}, {"30 degree steps", {}}, {"arbitrary", {}}};
+    for (int i = -24; i < 24; i++)
+    {
+        sets[0].angles.push_back(i * 90.0);
+        if (i % 3 != 0)
+        {
+            sets[1].angles.push_back(i * 30.0); // Only the steps that are not quarter turns: they are the ones the table serves
+        }
+        sets[2].angles.push_back(i * ARBITRARY_STEP);
+    }
+    return sets;
+}
+
+// Function to check the table against the C library, returns the number of failed checks
+int checkTable()
+{
+    int failures{0};
+    double max_error{0.0};
+    for (int degree = -720; degree <= 720; degree += MAngleTable::STEP_DEGREES)
+    {
+        float sin_a{0.f}, cos_a{0.f};
+        if (!MAngleTable::lookup(degree, sin_a, cos_a))
+        {
+            failures++; // Every multiple of the step must be in the table
+            continue;
+        }
+        const double radians = degree * (SDL_PI_D / 180.0);
+        max_error = SDL_max(max_error, std::fabs(sin_a - std::sin(radians)));
+        max_error = SDL_max(max_error, std::fabs(cos_a - std::cos(radians)));
+
+        // Quarter turns must be exact: 0, 1 or -1
+        const int quarter_turns = MAngleTable::getQuarterTurns(degree);
+        const float exact_sin[4]{0.f, 1.f, 0.f, -1.f};
+        const float exact_cos[4]{1.f, 0.f, -1.f, 0.f};
+        if ((degree % 90 == 0) != (quarter_turns >= 0) || (quarter_turns >= 0 && (sin_a != exact_sin[quarter_turns] || cos_a != exact_cos[quarter_turns])))
+        {
+            failures++;
+        }
+    }
+    failures += max_error <= MAX_TABLE_ERROR ? 0 : 1;
+
+    // Angles between two entries are left to the trigonometry
+    float sin_a{0.f}, cos_a{0.f};
+    failures += MAngleTable::getQuarterTurns(45.0) < 0 && !MAngleTable::lookup(7.5, sin_a, cos_a) ? 0 : 1;
+    std::printf("table: largest error %.3g over -720 to 720 degrees, %s\n", max_error, failures == 0 ? "ok" : "FAILED");
+    return failures;
+}
+
+// Function to check that the cached quarter turns are exact pixel permutations of the sprite, returns the number of failed checks
+int checkQuarterTurns(SDL_Renderer *renderer, SDL_Surface *target, SDL_Surface *sprite, MRotationCache &cache)
+{
+    const float x = (TARGET_WIDTH - SPRITE_WIDTH) / 2.f;
+    const float y = (TARGET_HEIGHT - SPRITE_HEIGHT) / 2.f;
+    int failures{0};
+    for (int turns = 0; turns < 4; turns++)
+    {
+        for (int flip = 0; flip < 4; flip++)
+        {
+            SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+            SDL_RenderClear(renderer);
+            cache.render(renderer, x, y, turns * 90.0, (SDL_FlipMode)flip);
+            SDL_FlushRenderer(renderer);
+
+            // The rotated sprite shares the center of the unrotated one
+            const int rotated_w = turns % 2 == 0 ? SPRITE_WIDTH : SPRITE_HEIGHT;
+            const int rotated_h = turns % 2 == 0 ? SPRITE_HEIGHT : SPRITE_WIDTH;
+            const int left = (TARGET_WIDTH - rotated_w) / 2;
+            const int top = (TARGET_HEIGHT - rotated_h) / 2;
+            int mismatches{0};
+            for (int dy = 0; dy < rotated_h; dy++)
+            {
+                const Uint32 *row = (const Uint32 *)((const Uint8 *)target->pixels + (size_t)(top + dy) * target->pitch);
+                for (int dx = 0; dx < rotated_w; dx++)
+                {
+                    // Source pixel of a clockwise rotation by the quarter turns, then of the flip applied before it
+                    const int source_x[4]{dx, dy, SPRITE_WIDTH - 1 - dx, SPRITE_WIDTH - 1 - dy};
+                    const int source_y[4]{dy, SPRITE_HEIGHT - 1 - dx, SPRITE_HEIGHT - 1 - dy, dx};
+                    const int sx = (flip & SDL_FLIP_HORIZONTAL) ? SPRITE_WIDTH - 1 - source_x[turns] : source_x[turns];
+                    const int sy = (flip & SDL_FLIP_VERTICAL) ? SPRITE_HEIGHT - 1 - source_y[turns] : source_y[turns];
+                    const Uint32 expected = ((const Uint32 *)((const Uint8 *)sprite->pixels + (size_t)sy * sprite->pitch))[sx];
+                    mismatches += ((row[left + dx] ^ expected) & 0x00FFFFFFu) != 0 ? 1 : 0;
+                }
+            }
+            failures += mismatches == 0 ? 0 : 1;
+            if (mismatches != 0)
+            {
+                std::printf("cache: %d degrees, flip %d: %d pixels differ, FAILED\n", turns * 90, flip, mismatches);
+            }
+        }
+    }
+    std::printf("cache: quarter turns of every flip mode %s\n", failures == 0 ? "exact" : "FAILED");
+    return failures;
+}
+
+// Function to measure the vertex generation of MSpriteBatch for a set of angles, in nanoseconds per quad
+double measureBatch(MSpriteBatch &batch, SDL_Texture *texture, const AngleSet &set)
+{
+    const SDL_FRect srcRect{0.f, 0.f, (float)SPRITE_WIDTH, (float)SPRITE_HEIGHT};
+    const SDL_FRect dstRect{100.f, 100.f, (float)SPRITE_WIDTH, (float)SPRITE_HEIGHT};
+    const size_t angle_count = set.angles.size();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int repeat = 0; repeat < BATCH_REPEATS; repeat++)
+    {
+        batch.begin(texture);
+        for (int i = 0; i < BATCH_QUADS; i++)
+        {
+            batch.add(srcRect, dstRect, SDL_FLIP_NONE, set.angles[(size_t)i % angle_count]);
+        }
+    }
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    return seconds * 1e9 / ((double)BATCH_QUADS * BATCH_REPEATS);
+}
+
+// Function to measure rotated draws with the software renderer, through SDL or through the cache, in microseconds per draw
+double measureDraws(SDL_Renderer *renderer, SDL_Texture *texture, MRotationCache *cache, const AngleSet &set)
+{
+    const float x = (TARGET_WIDTH - SPRITE_WIDTH) / 2.f;
+    const float y = (TARGET_HEIGHT - SPRITE_HEIGHT) / 2.f;
+    const SDL_FRect dstRect{x, y, (float)SPRITE_WIDTH, (float)SPRITE_HEIGHT};
+    const size_t angle_count = set.angles.size();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < DRAWS; i++)
+    {
+        const double degree = set.angles[(size_t)i % angle_count];
+        if (cache != nullptr)
+        {
+            cache->render(renderer, x, y, degree, SDL_FLIP_NONE);
+        }
+        else
+        {
+            SDL_RenderTextureRotated(renderer, texture, nullptr, &dstRect, degree, nullptr, SDL_FLIP_NONE);
+        }
+    }
+    SDL_FlushRenderer(renderer);
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    return seconds * 1e6 / DRAWS;
+}
+
+int main()
+{
+    // The software renderer draws into a plain surface: no window or GPU is needed
+    SDL_Surface *pTarget = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *pRenderer = pTarget != nullptr ? SDL_CreateSoftwareRenderer(pTarget) : nullptr;
+    SDL_Surface *pSprite = pRenderer != nullptr ? createSprite() : nullptr;
+    SDL_Texture *pTexture = pSprite != nullptr ? SDL_CreateTextureFromSurface(pRenderer, pSprite) : nullptr;
+    if (pTexture == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+
+    MRotationCache cache{ROTATION_BUCKETS};
+    MSpriteBatch batch{};
+    const std::vector<AngleSet> sets = createAngleSets();
+
+    // Exactness first: a faster rotation that draws the wrong pixels is worthless
+    int failures = checkTable();
+    if (!cache.load(pSprite))
+    {
+        return 1;
+    }
+    failures += checkQuarterTurns(pRenderer, pTarget, pSprite, cache);
+
+    // Vertex generation: quarter turns only move the texture coordinates, 30 degree steps read the table, the others call std::sin and std::cos
+    std::printf("\n%16s %18s\n", "angles", "batch ns/quad");
+    for (const AngleSet &set : sets)
+    {
+        std::printf("%16s %18.2f\n", set.name, measureBatch(batch, pTexture, set));
+    }
+
+    // Software renderer: SDL rotates the whole sprite on every draw, the cache rotates each bucket once and then copies it
+    std::printf("\n%16s %14s %14s %10s %8s\n", "angles", "SDL us/draw", "cache us/draw", "speedup", "builds");
+    for (const AngleSet &set : sets)
+    {
+        cache.load(pSprite); // Start every workload with an empty cache, so that the builds are part of the measurement
+        const Uint64 builds = cache.getBuildCount();
+        const double sdl_time = measureDraws(pRenderer, pTexture, nullptr, set);
+        const double cache_time = measureDraws(pRenderer, pTexture, &cache, set);
+        std::printf("%16s %14.2f %14.2f %9.2fx %8llu\n", set.name, sdl_time, cache_time, sdl_time / cache_time, (unsigned long long)(cache.getBuildCount() - builds));
+    }
+    std::printf("(arbitrary angles are snapped to the nearest of the %d buckets by the cache)\n", cache.getBucketCount());
+
+    // Clean up (the rotated textures belong to the renderer)
+    cache.clear();
+    SDL_DestroyTexture(pTexture);
+    SDL_DestroySurface(pSprite);
+    SDL_DestroyRenderer(pRenderer);
+    SDL_DestroySurface(pTarget);
+    SDL_Quit();
+
+    return failures == 0 ? 0 : 1;
+}
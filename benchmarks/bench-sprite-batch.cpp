@@ -0,0 +1,126 @@
+#include "MSpriteBatch.hpp"
+#include <cstdio>
+#include <vector>
+
+// Constants for the render target and the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr float SHEET_SPRITE_SIZE{100.f}; // Size of one sprite in the 2x2 sprite sheet (like 05dots.png)
+constexpr float QUAD_SIZE{16.f};          // Size of the drawn quads, small so that draw call overhead dominates
+constexpr int FRAMES{10};                 // Number of frames rendered for each measurement
+constexpr int QUAD_COUNTS[]{8, 100, 1000, 10000, 100000};
+
+// Structure to hold the rectangles of one quad
+struct Quad
+{
+    SDL_FRect srcRect; // Clip rectangle in the sprite sheet
+    SDL_FRect dstRect; // Destination rectangle on the render target
+};
+
+// Function to create a 2x2 sprite sheet in memory, so that the benchmark does not depend on the assets
+SDL_Texture *createSpriteSheet(SDL_Renderer *renderer)
+{
+    SDL_Surface *surface = SDL_CreateSurface(2 * (int)SHEET_SPRITE_SIZE, 2 * (int)SHEET_SPRITE_SIZE, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create sprite sheet surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+
+    // Fill each quadrant with a different color
+    const SDL_Color colors[4]{{0xFF, 0x00, 0x00, 0xFF}, {0x00, 0xFF, 0x00, 0xFF}, {0x00, 0x00, 0xFF, 0xFF}, {0xFF, 0xFF, 0x00, 0xFF}};
+    for (int i = 0; i < 4; i++)
+    {
+        const SDL_Rect quadrant{(i % 2) * (int)SHEET_SPRITE_SIZE, (i / 2) * (int)SHEET_SPRITE_SIZE, (int)SHEET_SPRITE_SIZE, (int)SHEET_SPRITE_SIZE};
+        SDL_FillSurfaceRect(surface, &quadrant, SDL_MapSurfaceRGBA(surface, colors[i].r, colors[i].g, colors[i].b, colors[i].a));
+    }
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+// Function to generate a deterministic list of quads spread over the render target
+std::vector<Quad> generateQuads(const int count)
+{
+    std::vector<Quad> quads(count);
+    Uint32 seed{12345};
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u; // Linear congruential generator: same workload on every run
+        const float x = (float)(seed % (TARGET_WIDTH - (int)QUAD_SIZE));
+        const float y = (float)((seed >> 16) % (TARGET_HEIGHT - (int)QUAD_SIZE));
+        quads[i].srcRect = SDL_FRect{(i % 2) * SHEET_SPRITE_SIZE, ((i / 2) % 2) * SHEET_SPRITE_SIZE, SHEET_SPRITE_SIZE, SHEET_SPRITE_SIZE};
+        quads[i].dstRect = SDL_FRect{x, y, QUAD_SIZE, QUAD_SIZE};
+    }
+    return quads;
+}
+
+// Function to measure the per-call path: one SDL_RenderTexture per quad, as MTexture::renderTexture does
+double runPerCall(SDL_Renderer *renderer, SDL_Texture *texture, const std::vector<Quad> &quads)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(renderer);
+        for (const Quad &quad : quads)
+        {
+            SDL_RenderTexture(renderer, texture, &quad.srcRect, &quad.dstRect);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+// Function to measure the batched path: every quad submitted with one SDL_RenderGeometry call
+double runBatched(SDL_Renderer *renderer, SDL_Texture *texture, const std::vector<Quad> &quads, MSpriteBatch &batch)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(renderer);
+        batch.begin(texture);
+        for (const Quad &quad : quads)
+        {
+            batch.add(quad.srcRect, quad.dstRect);
+        }
+        batch.submit(renderer);
+        SDL_RenderPresent(renderer);
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
+
+int main()
+{
+    // The software renderer draws into a plain surface: no window or GPU is needed
+    SDL_Surface *pTarget = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *pRenderer = pTarget != nullptr ? SDL_CreateSoftwareRenderer(pTarget) : nullptr;
+    SDL_Texture *pTexture = pRenderer != nullptr ? createSpriteSheet(pRenderer) : nullptr;
+    if (pTexture == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    MSpriteBatch batch{};
+
+    std::printf("%10s %18s %18s %10s\n", "quads", "per-call quads/s", "batched quads/s", "speedup");
+    for (const int count : QUAD_COUNTS)
+    {
+        const std::vector<Quad> quads = generateQuads(count);
+        const double per_call_seconds = runPerCall(pRenderer, pTexture, quads);
+        const double batched_seconds = runBatched(pRenderer, pTexture, quads, batch);
+        const double total_quads = (double)count * FRAMES;
+        std::printf("%10d %18.0f %18.0f %9.2fx\n", count, total_quads / per_call_seconds, total_quads / batched_seconds, per_call_seconds / batched_seconds);
+    }
+
+    // Clean up
+    SDL_DestroyTexture(pTexture);
+    SDL_DestroyRenderer(pRenderer);
+    SDL_DestroySurface(pTarget);
+    SDL_Quit();
+
+    return 0;
+}
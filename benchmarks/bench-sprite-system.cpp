@@ -0,0 +1,151 @@
+#include "MTexture.hpp"
+#include "MSpriteSystem.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Constants for the render target and the benchmark workload
+constexpr int TARGET_WIDTH{640};
+constexpr int TARGET_HEIGHT{480};
+constexpr int ARROW_SIZE{12};              // Size of the arrow texture, drawn unscaled by both paths
+constexpr float FRAME_SECONDS{1.f / 60.f}; // Simulated time step of a frame
+constexpr int DEFAULT_FRAMES{20};          // Number of frames rendered for each measurement, unless given on the command line
+constexpr int ARROW_COUNTS[]{1000, 10000, 100000};
+
+// Structure to hold one arrow of the per-object path, as tutorial 06 holds its arrow in locals
+struct Arrow
+{
+    float x;                // Left position of the arrow
+    float y;                // Top position of the arrow
+    float degree;           // Clockwise rotation around the center
+    float spin;             // Rotation speed in degrees per second
+    SDL_FlipMode flip_mode; // Flip applied to the texture
+};
+
+// Function to create a small arrow texture pointing right, so that the benchmark does not depend on the assets
+bool createArrow(SDL_Renderer *renderer, MTexture &texture)
+{
+    SDL_Surface *surface = SDL_CreateSurface(ARROW_SIZE, ARROW_SIZE, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create arrow surface: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Transparent background, a shaft on the left half and a head on the right half
+    SDL_FillSurfaceRect(surface, nullptr, SDL_MapSurfaceRGBA(surface, 0, 0, 0, 0));
+    const Uint32 color = SDL_MapSurfaceRGBA(surface, 0x20, 0x40, 0xC0, 0xFF);
+    const SDL_Rect shaft{0, ARROW_SIZE / 2 - 1, ARROW_SIZE / 2, 2};
+    SDL_FillSurfaceRect(surface, &shaft, color);
+    for (int x = ARROW_SIZE / 2; x < ARROW_SIZE; x++)
+    {
+        const int half_height = ARROW_SIZE - x; // The head narrows towards the tip
+        const SDL_Rect column{x, ARROW_SIZE / 2 - half_height / 2, 1, SDL_max(half_height, 1)};
+        SDL_FillSurfaceRect(surface, &column, color);
+    }
+
+    const bool loaded = texture.loadTexture(surface, renderer);
+    SDL_DestroySurface(surface);
+    return loaded;
+}
+
+// Function to generate a deterministic set of arrows spread over the render target
+std::vector<Arrow> generateArrows(const int count)
+{
+    std::vector<Arrow> arrows(count);
+    Uint32 seed{12345};
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u; // Linear congruential generator: same workload on every run
+        arrows[i].x = (float)(seed % (TARGET_WIDTH - ARROW_SIZE));
+        arrows[i].y = (float)((seed >> 16) % (TARGET_HEIGHT - ARROW_SIZE));
+        arrows[i].degree = (float)(seed % 360);
+        arrows[i].spin = (float)((int)((seed >> 8) % 361) - 180);
+        arrows[i].flip_mode = (i % 3 == 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+    }
+    return arrows;
+}
+
+// Function to measure the per-object path: each arrow updated and drawn with its own MTexture::renderTexture call
+double runPerObject(SDL_Renderer *renderer, const MTexture &texture, std::vector<Arrow> arrows, const int frames)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(renderer);
+        for (Arrow &arrow : arrows)
+        {
+            arrow.degree += arrow.spin * FRAME_SECONDS;
+            texture.renderTexture(arrow.x, arrow.y, arrow.degree, arrow.flip_mode, renderer);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency() / frames;
+}
+
+// Function to measure the structure-of-arrays path: one update over the arrays, then one geometry call for every arrow
+double runSpriteSystem(SDL_Renderer *renderer, const MTexture &texture, const std::vector<Arrow> &arrows, const int frames, double &update_ms)
+{
+    MSpriteSystem system{};
+    const int texture_id = system.addTexture(texture.getTexture());
+    system.reserve(arrows.size());
+    for (const Arrow &arrow : arrows)
+    {
+        const SDL_FRect dstRect{arrow.x, arrow.y, (float)ARROW_SIZE, (float)ARROW_SIZE};
+        system.add(texture_id, dstRect, nullptr, arrow.degree, arrow.flip_mode, arrow.spin);
+    }
+
+    Uint64 update_ticks{0};
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        const Uint64 update_start = SDL_GetPerformanceCounter();
+        system.update(FRAME_SECONDS);
+        update_ticks += SDL_GetPerformanceCounter() - update_start;
+
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(renderer);
+        system.render(renderer);
+        SDL_RenderPresent(renderer);
+    }
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    update_ms = (double)update_ticks * 1000.0 / frequency / frames;
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / frequency / frames;
+}
+
+int main(int argc, char *argv[])
+{
+    const int frames = argc > 1 ? SDL_max(std::atoi(argv[1]), 1) : DEFAULT_FRAMES;
+
+    // The software renderer draws into a plain surface: no window or GPU is needed
+    SDL_Surface *pTarget = SDL_CreateSurface(TARGET_WIDTH, TARGET_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *pRenderer = pTarget != nullptr ? SDL_CreateSoftwareRenderer(pTarget) : nullptr;
+    MTexture texture{};
+    if (pRenderer == nullptr || !createArrow(pRenderer, texture))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not set up the benchmark: %s\n", SDL_GetError());
+        SDL_DestroyRenderer(pRenderer);
+        SDL_DestroySurface(pTarget);
+        return 1;
+    }
+
+    std::printf("%d frames per path, %dx%d software render target, %dx%d rotating arrows\n", frames, TARGET_WIDTH, TARGET_HEIGHT, ARROW_SIZE, ARROW_SIZE);
+    std::printf("%10s %14s %14s %14s %14s %10s\n", "arrows", "MTexture ms", "system ms", "update ms", "system fps", "speedup");
+    for (const int count : ARROW_COUNTS)
+    {
+        const std::vector<Arrow> arrows = generateArrows(count);
+        double update_ms{0.0};
+        const double per_object_ms = runPerObject(pRenderer, texture, arrows, frames);
+        const double system_ms = runSpriteSystem(pRenderer, texture, arrows, frames, update_ms);
+        std::printf("%10d %14.3f %14.3f %14.3f %14.1f %9.2fx\n", count, per_object_ms, system_ms, update_ms, 1000.0 / system_ms, per_object_ms / system_ms);
+    }
+
+    // Clean up
+    texture.clear();
+    SDL_DestroyRenderer(pRenderer);
+    SDL_DestroySurface(pTarget);
+    SDL_Quit();
+
+    return 0;
+}
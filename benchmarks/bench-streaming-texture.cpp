@@ -0,0 +1,193 @@
+#include <SDL3/SDL.h>
+#include "MTexture.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Constants for the benchmark workload
+constexpr int TEXTURE_WIDTH{1920};  // Width of the texture and of the window
+constexpr int TEXTURE_HEIGHT{1080}; // Height of the texture and of the window
+constexpr int CHANGED_SIZE{256};    // Side of the square that changes every frame
+constexpr int DEFAULT_FRAMES{300};  // Frames drawn for each path
+
+// Paths that bring a frame's changes to the texture
+enum UpdatePath
+{
+    PATH_RECREATE, // clear() and a new static texture from the whole surface, as the tutorials did
+    PATH_FULL,     // Streaming texture, the whole surface marked dirty and uploaded
+    PATH_PARTIAL,  // Streaming texture, only the changed square marked dirty and uploaded
+    PATH_LOCK      // Streaming texture, the changed square written directly into the locked pixels
+};
+constexpr const char *PATH_NAMES[]{"recreate", "full update", "partial update", "lock"};
+
+// Structure to hold the measurements of one path
+struct PathResult
+{
+    double mean_ms;          // Mean time of a frame (update, render and present)
+    Uint64 uploaded_pixels;  // Pixels written to the streaming texture (0 for recreate)
+    SDL_Surface *last_frame; // Pixels of the renderer after the last frame, compared across paths
+};
+
+// Function to get the rectangle that changes in a frame: a square sweeping over the texture
+SDL_Rect getChangedRect(const int frame)
+{
+    return SDL_Rect{(frame * 37) % (TEXTURE_WIDTH - CHANGED_SIZE), (frame * 23) % (TEXTURE_HEIGHT - CHANGED_SIZE), CHANGED_SIZE, CHANGED_SIZE};
+}
+
+// Function to write the procedural content of a frame into the pixels of a rectangle (ARGB8888, pixels points at the top left of the rectangle)
+void writePattern(void *pixels, const int pitch, const SDL_Rect &rect, const int frame)
+{
+    for (int y = 0; y < rect.h; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)pixels + (size_t)y * pitch);
+        for (int x = 0; x < rect.w; x++)
+        {
+            const int px = rect.x + x;
+            const int py = rect.y + y;
+            row[x] = 0xFF000000u | (Uint32)((px + frame * 5) & 0xFF) << 16 | (Uint32)((py * 3 + frame) & 0xFF) << 8 | (Uint32)((px ^ py) & 0xFF);
+        }
+    }
+}
+
+// Function to fill the source surface with its initial content: a gradient, identical for every path
+void fillInitial(SDL_Surface *surface)
+{
+    writePattern(surface->pixels, surface->pitch, SDL_Rect{0, 0, surface->w, surface->h}, 0);
+}
+
+// Function to draw the frames of one path and read back the last one
+PathResult runPath(const UpdatePath path, SDL_Renderer *renderer, SDL_Surface *source, const int frames)
+{
+    fillInitial(source);
+    MTexture texture{};
+    const bool created = path == PATH_RECREATE ? texture.loadTexture(source, renderer) : texture.loadStreaming(source, renderer);
+    if (!created)
+    {
+        return PathResult{0.0, 0, nullptr};
+    }
+
+    // The initial upload of the streaming texture is not part of the comparison
+    const Uint64 uploaded_before = MTexture::getUploadedPixels();
+    SDL_Surface *last_frame{nullptr};
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 1; frame <= frames; frame++)
+    {
+        const SDL_Rect rect = getChangedRect(frame);
+        if (path == PATH_LOCK)
+        {
+            int pitch{0};
+            void *pixels = texture.lockPixels(&rect, pitch);
+            if (pixels != nullptr)
+            {
+                writePattern(pixels, pitch, rect, frame);
+                texture.unlockPixels();
+            }
+        }
+        else
+        {
+            // The other paths change the surface first, as a program keeping its image on the CPU does
+            writePattern((Uint8 *)source->pixels + (size_t)rect.y * source->pitch + (size_t)rect.x * 4, source->pitch, rect, frame);
+            if (path == PATH_RECREATE)
+            {
+                texture.clear();
+                texture.loadTexture(source, renderer);
+            }
+            else
+            {
+                texture.markDirty(path == PATH_FULL ? SDL_Rect{0, 0, TEXTURE_WIDTH, TEXTURE_HEIGHT} : rect);
+                texture.uploadDirty(source);
+            }
+        }
+
+        SDL_RenderClear(renderer);
+        texture.renderTexture(0, 0, renderer);
+        if (frame == frames)
+        {
+            last_frame = SDL_RenderReadPixels(renderer, nullptr);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    const double elapsed_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    return PathResult{elapsed_ms / frames, MTexture::getUploadedPixels() - uploaded_before, last_frame};
+}
+
+// Function to count the pixels that differ between two surfaces of the same size and format (-1 when one is missing)
+int countDifferences(const SDL_Surface *a, const SDL_Surface *b)
+{
+    if (a == nullptr || b == nullptr || a->w != b->w || a->h != b->h || a->format != b->format)
+    {
+        return -1;
+    }
+    int differences{0};
+    const int bytes_per_pixel = SDL_BYTESPERPIXEL(a->format);
+    for (int y = 0; y < a->h; y++)
+    {
+        const Uint8 *row_a = (const Uint8 *)a->pixels + (size_t)y * a->pitch;
+        const Uint8 *row_b = (const Uint8 *)b->pixels + (size_t)y * b->pitch;
+        for (int x = 0; x < a->w; x++)
+        {
+            differences += std::memcmp(row_a + x * bytes_per_pixel, row_b + x * bytes_per_pixel, bytes_per_pixel) != 0;
+        }
+    }
+    return differences;
+}
+
+int main(int argc, char *argv[])
+{
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_FRAMES;
+
+    // The offscreen driver needs no display: the environment (SDL_VIDEO_DRIVER) can still select another one
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Window *window = SDL_CreateWindow("bench-streaming-texture", TEXTURE_WIDTH, TEXTURE_HEIGHT, SDL_WINDOW_HIDDEN);
+    SDL_Renderer *renderer = window != nullptr ? SDL_CreateRenderer(window, "software") : nullptr;
+    SDL_Surface *source = SDL_CreateSurface(TEXTURE_WIDTH, TEXTURE_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    if (renderer == nullptr || source == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the offscreen renderer: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    PathResult results[SDL_arraysize(PATH_NAMES)]{};
+    for (int path = PATH_RECREATE; path <= PATH_LOCK; path++)
+    {
+        results[path] = runPath((UpdatePath)path, renderer, source, frames);
+    }
+
+    // Every path must show the same last frame, and the streaming paths must upload exactly what they marked or locked
+    int failures{0};
+    const Uint64 expected_uploads[]{0, (Uint64)frames * TEXTURE_WIDTH * TEXTURE_HEIGHT, (Uint64)frames * CHANGED_SIZE * CHANGED_SIZE, (Uint64)frames * CHANGED_SIZE * CHANGED_SIZE};
+    for (int path = PATH_RECREATE; path <= PATH_LOCK; path++)
+    {
+        const int differences = countDifferences(results[PATH_RECREATE].last_frame, results[path].last_frame);
+        const bool passed = differences == 0 && results[path].uploaded_pixels == expected_uploads[path];
+        std::printf("%s: %d pixels differ from recreate, %llu pixels uploaded, %s\n", PATH_NAMES[path], differences, (unsigned long long)results[path].uploaded_pixels,
+                    passed ? "ok" : "FAILED");
+        failures += passed ? 0 : 1;
+    }
+
+    std::printf("\n%dx%d texture, %dx%d square changed per frame, %d frames per path\n", TEXTURE_WIDTH, TEXTURE_HEIGHT, CHANGED_SIZE, CHANGED_SIZE, frames);
+    std::printf("%16s %12s %10s %16s\n", "path", "ms/frame", "speedup", "pixels/frame");
+    for (int path = PATH_RECREATE; path <= PATH_LOCK; path++)
+    {
+        const double pixels_per_frame = path == PATH_RECREATE ? (double)TEXTURE_WIDTH * TEXTURE_HEIGHT : (double)results[path].uploaded_pixels / frames;
+        std::printf("%16s %12.3f %9.2fx %16.0f\n", PATH_NAMES[path], results[path].mean_ms, results[PATH_RECREATE].mean_ms / results[path].mean_ms, pixels_per_frame);
+    }
+
+    // Clean up
+    for (const PathResult &result : results)
+    {
+        SDL_DestroySurface(result.last_frame);
+    }
+    SDL_DestroySurface(source);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+#include "MSurfaceArena.hpp"
+#include "MAllocTracker.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+// Constants for the benchmark workload
+constexpr int DEFAULT_RELOADS{10000}; // Number of image loads, cycling over the assets
+constexpr int CHECK_SURFACES{4};      // Surfaces of the same size taken at once by the bulk release check
+constexpr const char *ASSET_NAMES[]{"03up.png", "03down.png", "03left.png", "03right.png", "04background0.png", "04background1.png", "04sprite.png"};
+constexpr SDL_Color CYAN{0x00, 0xFF, 0xFF, 0xFF}; // Color key of the 04 sprite, applied to every load like MTexture does
+
+// Structure to hold the measurements of one path
+struct ReloadStats
+{
+    double mean_us;          // Mean time of a load
+    double sdl_per_reload;   // SDL allocations (SDL_malloc, SDL_calloc, SDL_realloc) per load
+    double cpp_per_reload;   // C++ allocations (operator new) per load
+    long long rss_growth_kb; // Resident set size after the loads minus before
+};
+
+// Function to get the resident set size of the process in KiB (0 when unknown)
+long long getResidentKb()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? (long long)(counters.WorkingSetSize / 1024) : 0;
+#else
+    long long pages{0}, resident{0};
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr)
+    {
+        return 0;
+    }
+    const bool read = std::fscanf(statm, "%lld %lld", &pages, &resident) == 2;
+    std::fclose(statm);
+    return read ? resident * (sysconf(_SC_PAGESIZE) / 1024) : 0;
+#endif
+}
+
+// Function to keep the cyan background out of a decoded surface, as MTexture::loadTexture does before the upload
+bool applyColorKey(SDL_Surface *surface)
+{
+    return SDL_SetSurfaceColorKey(surface, true, SDL_MapSurfaceRGB(surface, CYAN.r, CYAN.g, CYAN.b));
+}
+
+// Function to compare the arena decode with IMG_Load converted to the format of the arena surface; returns the number of failed checks
+int checkPixels(MSurfaceArena &arena, const std::vector<std::string> &file_paths)
+{
+    int failures{0};
+    for (size_t i = 0; i < std::min(file_paths.size(), SDL_arraysize(ASSET_NAMES)); i++)
+    {
+        SDL_Surface *surface = arena.load(file_paths[i]);
+        SDL_Surface *decoded = IMG_Load(file_paths[i].c_str());
+        SDL_Surface *expected = decoded != nullptr && surface != nullptr ? SDL_ConvertSurface(decoded, surface->format) : nullptr;
+        bool passed = expected != nullptr && SDL_BYTESPERPIXEL(surface->format) == 4 && SDL_ISPIXELFORMAT_ALPHA(surface->format) && surface->w == expected->w &&
+                      surface->h == expected->h;
+        for (int y = 0; passed && y < surface->h; y++)
+        {
+            passed = std::memcmp((Uint8 *)surface->pixels + y * surface->pitch, (Uint8 *)expected->pixels + y * expected->pitch, surface->w * 4) == 0;
+        }
+        std::printf("pixels of %s: %s\n", ASSET_NAMES[i], passed ? "ok" : "FAILED");
+        failures += passed ? 0 : 1;
+        arena.release(surface);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(decoded);
+    }
+    return failures;
+}
+
+// Function to take several surfaces, give them back at once and take them again; returns the number of failed checks
+int checkBulkRelease()
+{
+    MSurfaceArena arena{};
+    SDL_Surface *surfaces[CHECK_SURFACES]{};
+    for (int round = 0; round < 2; round++)
+    {
+        for (SDL_Surface *&surface : surfaces)
+        {
+            surface = arena.createSurface(640, 480, SDL_PIXELFORMAT_ARGB8888);
+        }
+        arena.releaseAll();
+    }
+
+    // The second round reuses the buffers of the first, then trim frees them all
+    bool passed = std::all_of(std::begin(surfaces), std::end(surfaces), [](const SDL_Surface *surface) { return surface != nullptr; });
+    passed = passed && arena.getSystemAllocations() == CHECK_SURFACES && arena.getReuses() == CHECK_SURFACES;
+    arena.trim();
+    passed = passed && arena.getBlockCount() == 0 && arena.getReservedBytes() == 0;
+    std::printf("bulk release and trim: %s\n", passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+// Function to reload the assets through IMG_Load, keying and destroying each surface like MTexture::loadTexture
+ReloadStats runImgLoad(const std::vector<std::string> &file_paths, const int reloads)
+{
+    const long long rss_before = getResidentKb();
+    const MAllocTracker::Counts before = MAllocTracker::getTotalCounts();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < reloads; i++)
+    {
+        SDL_Surface *surface = IMG_Load(file_paths[i % file_paths.size()].c_str());
+        if (surface != nullptr)
+        {
+            applyColorKey(surface);
+        }
+        SDL_DestroySurface(surface);
+    }
+    const double elapsed_us = (double)(SDL_GetPerformanceCounter() - start) * 1e6 / (double)SDL_GetPerformanceFrequency();
+    const MAllocTracker::Counts after = MAllocTracker::getTotalCounts();
+    return ReloadStats{elapsed_us / reloads, (double)(after.sdl - before.sdl) / reloads, (double)(after.cpp - before.cpp) / reloads, getResidentKb() - rss_before};
+}
+
+// Function to reload the assets through the arena, keying and releasing each surface like the arena overload of MTexture::loadTexture
+// (SDL's allocations are pooled: the decode of a reload takes the blocks freed by the previous decodes back)
+ReloadStats runArena(MSurfaceArena &arena, const std::vector<std::string> &file_paths, const int reloads)
+{
+    const long long rss_before = getResidentKb();
+    const MAllocTracker::Counts before = MAllocTracker::getTotalCounts();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < reloads; i++)
+    {
+        SDL_Surface *surface = arena.load(file_paths[i % file_paths.size()]);
+        if (surface != nullptr)
+        {
+            applyColorKey(surface);
+        }
+        arena.release(surface);
+    }
+    const double elapsed_us = (double)(SDL_GetPerformanceCounter() - start) * 1e6 / (double)SDL_GetPerformanceFrequency();
+    const MAllocTracker::Counts after = MAllocTracker::getTotalCounts();
+    return ReloadStats{elapsed_us / reloads, (double)(after.sdl - before.sdl) / reloads, (double)(after.cpp - before.cpp) / reloads, getResidentKb() - rss_before};
+}
+
+int main(int argc, char *argv[])
+{
+    // SDL's memory functions can only be replaced before its first allocation
+    MAllocTracker::install();
+    MAllocTracker::setPooling(true);
+
+    const int reloads = argc > 1 ? std::max(1, std::atoi(argv[1])) : DEFAULT_RELOADS;
+    const std::string assets_dir = argc > 2 ? argv[2] : "../assets";
+    std::vector<std::string> file_paths{};
+    for (const char *name : ASSET_NAMES)
+    {
+        file_paths.push_back(assets_dir + "/" + name);
+    }
+
+    // Correctness first: the arena must decode the same pixels, and reuse its buffers
+    MSurfaceArena arena{};
+    int failures = checkPixels(arena, file_paths) + checkBulkRelease();
+
+    // Reference: IMG_Load without the pool, every decode goes to the system allocator
+    MAllocTracker::setPooling(false);
+    MAllocTracker::trimPool();
+    const ReloadStats img_load = runImgLoad(file_paths, reloads);
+
+    // One pass over the assets warms the arena and the pool up: a reload must then neither allocate a buffer nor reach the system allocator
+    MAllocTracker::setPooling(true);
+    runArena(arena, file_paths, (int)file_paths.size());
+    const Uint64 warm_allocations = arena.getSystemAllocations();
+    const ReloadStats arena_load = runArena(arena, file_paths, reloads);
+    const bool steady = arena.getSystemAllocations() == warm_allocations && (!MAllocTracker::isInstalled() || arena_load.sdl_per_reload == 0.0);
+    std::printf("after warm-up: %llu arena buffers and %.2f SDL allocations per reload, %s\n", (unsigned long long)(arena.getSystemAllocations() - warm_allocations),
+                arena_load.sdl_per_reload, steady ? "ok" : "FAILED");
+    failures += steady ? 0 : 1;
+
+    std::printf("\n%d reloads of %d assets (03 arrows and 04), arena holding %llu buffers (%llu KiB), pool holding %llu KiB\n", reloads, (int)file_paths.size(),
+                (unsigned long long)arena.getBlockCount(), (unsigned long long)(arena.getReservedBytes() / 1024), (unsigned long long)(MAllocTracker::getPooledBytes() / 1024));
+    std::printf("%16s %12s %14s %14s %14s\n", "path", "us/reload", "SDL allocs", "C++ allocs", "RSS growth KiB");
+    std::printf("%16s %12.1f %14.2f %14.2f %14lld\n", "IMG_Load", img_load.mean_us, img_load.sdl_per_reload, img_load.cpp_per_reload, img_load.rss_growth_kb);
+    std::printf("%16s %12.1f %14.2f %14.2f %14lld\n", "arena + pool", arena_load.mean_us, arena_load.sdl_per_reload, arena_load.cpp_per_reload, arena_load.rss_growth_kb);
+    if (!MAllocTracker::isInstalled())
+    {
+        std::printf("(allocations are not counted: built with MALLOC_TRACKER_ENABLED=0)\n");
+    }
+
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
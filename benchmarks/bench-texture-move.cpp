@@ -0,0 +1,152 @@
+#include <SDL3/SDL.h>
+#include "MTexture.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+// Constants for the benchmark workload
+constexpr int TEXTURE_SIZE{16};       // Width and height of every texture created
+constexpr int TARGET_SIZE{64};        // Width and height of the surface the software renderer draws into
+constexpr int DEFAULT_TEXTURES{1000}; // Number of textures pushed into a vector without reserving, unless given on the command line
+
+// std::vector only moves its elements on reallocation when the move constructor cannot throw: otherwise it copies, which MTexture forbids
+static_assert(std::is_nothrow_move_constructible_v<MTexture> && std::is_nothrow_move_assignable_v<MTexture>, "MTexture moves must be noexcept");
+static_assert(!std::is_copy_constructible_v<MTexture> && !std::is_copy_assignable_v<MTexture>, "MTexture must not be copyable");
+
+// Function to create a texture of the test size (one SDL texture)
+MTexture createTexture(SDL_Renderer *renderer)
+{
+    MTexture texture{};
+    if (!texture.createStreaming(TEXTURE_SIZE, TEXTURE_SIZE, renderer))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create a test texture: %s\n", SDL_GetError());
+    }
+    return texture;
+}
+
+// Function to print the result of a check: returns 1 when it failed
+int report(const char *name, const bool passed, const Uint64 destroyed, const Uint64 expected)
+{
+    std::printf("%-28s %3llu destroyed, %3llu expected: %s\n", name, (unsigned long long)destroyed, (unsigned long long)expected, passed ? "ok" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+// Function to check the number of SDL textures destroyed by moves and destructors; returns the number of failed checks
+int checkMoves(SDL_Renderer *renderer)
+{
+    int failures{0};
+
+    // Move construction: the texture changes owner, nothing is destroyed
+    MTexture source = createTexture(renderer);
+    SDL_Texture *const sdl_texture = source.getTexture();
+    Uint64 before = MTexture::getDestroyCount();
+    MTexture moved{std::move(source)};
+    Uint64 destroyed = MTexture::getDestroyCount() - before;
+    failures += report("move construction", destroyed == 0 && sdl_texture != nullptr && moved.getTexture() == sdl_texture && !source.isLoaded(), destroyed, 0);
+
+    // Move assignment into a loaded texture: only the texture it held is destroyed
+    MTexture target = createTexture(renderer);
+    before = MTexture::getDestroyCount();
+    target = std::move(moved);
+    destroyed = MTexture::getDestroyCount() - before;
+    failures += report("move assignment", destroyed == 1 && target.getTexture() == sdl_texture && !moved.isLoaded(), destroyed, 1);
+
+    // Self-move: the texture is kept (through a reference, as the compiler warns about a direct self-move)
+    MTexture &alias = target;
+    before = MTexture::getDestroyCount();
+    target = std::move(alias);
+    destroyed = MTexture::getDestroyCount() - before;
+    failures += report("self-move assignment", destroyed == 0 && target.getTexture() == sdl_texture, destroyed, 0);
+
+    // Destruction of moved-from objects: only the owner destroys the texture, once
+    before = MTexture::getDestroyCount();
+    {
+        MTexture owner = createTexture(renderer);
+        MTexture first{std::move(owner)};
+        MTexture second{};
+        second = std::move(first);
+    }
+    destroyed = MTexture::getDestroyCount() - before;
+    failures += report("destruction after moves", destroyed == 1, destroyed, 1);
+
+    // Moving from an empty texture and clearing a moved-from one destroy nothing
+    before = MTexture::getDestroyCount();
+    MTexture empty{};
+    MTexture from_empty{std::move(empty)};
+    source.clear();
+    moved.clear();
+    destroyed = MTexture::getDestroyCount() - before;
+    failures += report("empty and moved-from clear", destroyed == 0 && !from_empty.isLoaded(), destroyed, 0);
+
+    // The last owner releases the texture
+    before = MTexture::getDestroyCount();
+    target.clear();
+    destroyed = MTexture::getDestroyCount() - before;
+    failures += report("clear of the owner", destroyed == 1 && !target.isLoaded(), destroyed, 1);
+    return failures;
+}
+
+// Function to check that a vector growing without reserve moves its textures instead of destroying them; returns the number of failed checks
+int checkVectorGrowth(SDL_Renderer *renderer, const int count)
+{
+    std::vector<MTexture> textures{};
+    std::vector<SDL_Texture *> expected{};
+    expected.reserve(count);
+    int reallocations{0};
+    const Uint64 before = MTexture::getDestroyCount();
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < count; i++)
+    {
+        const size_t capacity = textures.capacity();
+        textures.push_back(createTexture(renderer));
+        expected.push_back(textures.back().getTexture());
+        reallocations += textures.capacity() != capacity ? 1 : 0;
+    }
+    const double elapsed_ms = (double)(SDL_GetPerformanceCounter() - start) * 1e3 / (double)SDL_GetPerformanceFrequency();
+    const Uint64 destroyed = MTexture::getDestroyCount() - before;
+
+    // Every texture is still owned by the element it was pushed as, after every reallocation
+    bool owned{true};
+    for (int i = 0; i < count; i++)
+    {
+        owned = owned && expected[i] != nullptr && textures[i].getTexture() == expected[i];
+    }
+    int failures = report("vector reallocations", destroyed == 0 && owned && reallocations > 1, destroyed, 0);
+
+    // Clearing the vector destroys each texture once
+    const Uint64 before_clear = MTexture::getDestroyCount();
+    textures.clear();
+    failures += report("vector clear", MTexture::getDestroyCount() - before_clear == (Uint64)count, MTexture::getDestroyCount() - before_clear, count);
+
+    std::printf("\n%d textures pushed in %.2f ms through %d reallocations\n", count, elapsed_ms, reallocations);
+    return failures;
+}
+
+int main(int argc, char *argv[])
+{
+    const int count = argc > 1 ? std::atoi(argv[1]) : DEFAULT_TEXTURES;
+    if (count <= 1)
+    {
+        std::fprintf(stderr, "Usage: %s [textures (at least 2)]\n", argv[0]);
+        return 1;
+    }
+
+    // The software renderer creates real SDL textures without a window
+    SDL_Surface *target = SDL_CreateSurface(TARGET_SIZE, TARGET_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = target != nullptr ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (renderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create the software renderer: %s\n", SDL_GetError());
+        SDL_DestroySurface(target);
+        return 1;
+    }
+
+    int failures = checkMoves(renderer);
+    failures += checkVectorGrowth(renderer, count);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
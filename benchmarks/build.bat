@@ -0,0 +1,95 @@
+g++ bench-sprite-batch.cpp ..\common\MSpriteBatch.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-sprite-batch.exe
+g++ bench-async-loader.cpp ..\common\MAsyncLoader.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-async-loader.exe
+g++ bench-log.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-log.exe
+g++ bench-scenes.cpp ..\01-sdl-basics\MScene01.cpp ..\04-sdl-color-keying\MScene04.cpp ..\05-sdl-clipping-and-stretching\MScene05.cpp ..\06-sdl-rotation-and-flipping\MScene06.cpp ^
+..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp ..\common\MSurfaceBlitter.cpp ..\common\MScaledSurfaceCache.cpp ^
+..\common\MRenderQueue.cpp ..\common\MLayerCache.cpp ..\common\MSpriteBatch.cpp ..\common\MAtlasPacker.cpp ..\common\MRotationCache.cpp ..\common\MSpriteSystem.cpp ..\common\MQuadGenerator.cpp ^
+..\common\MAllocTracker.cpp -O2 -DMPROFILER_ENABLED=0 -std=c++2a ^
+-I "..\common" -I "..\01-sdl-basics" -I "..\04-sdl-color-keying" -I "..\05-sdl-clipping-and-stretching" -I "..\06-sdl-rotation-and-flipping" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-scenes.exe
+g++ bench-04-events.cpp ..\04-sdl-color-keying\MScene04.cpp ..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp ^
+..\common\MRenderQueue.cpp ..\common\MLayerCache.cpp ..\common\MSpriteBatch.cpp -O2 -DMPROFILER_ENABLED=0 -std=c++2a ^
+-I "..\common" -I "..\04-sdl-color-keying" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-04-events.exe
+g++ bench-scale-blit.cpp ..\common\MSurfaceBlitter.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-scale-blit.exe
+g++ bench-scaled-cache.cpp ..\common\MScaledSurfaceCache.cpp ..\common\MSurfaceBlitter.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-scaled-cache.exe
+g++ bench-dirty-rects.cpp ..\common\MDirtyRegion.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-dirty-rects.exe
+g++ bench-render-queue.cpp ..\common\MRenderQueue.cpp ..\common\MSpriteBatch.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" ^
+-o ../bench-render-queue.exe
+g++ bench-sprite-system.cpp ..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp ..\common\MSpriteSystem.cpp ..\common\MQuadGenerator.cpp -O2 -DMPROFILER_ENABLED=0 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-sprite-system.exe
+g++ bench-rotated-quads.cpp ..\common\MQuadGenerator.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-rotated-quads.exe
+g++ bench-snap-rotation.cpp ..\common\MSpriteBatch.cpp ..\common\MRotationCache.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-snap-rotation.exe
+g++ bench-profiler.cpp ..\common\MProfiler.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-profiler.exe
+g++ bench-surface-arena.cpp ..\common\MSurfaceArena.cpp ..\common\MAllocTracker.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image -lpsapi ^
+-o ../bench-surface-arena.exe
+g++ bench-color-key.cpp ..\common\MColorKeyConverter.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-color-key.exe
+g++ bench-streaming-texture.cpp ..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp -O2 -DMPROFILER_ENABLED=0 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-streaming-texture.exe
+g++ bench-layer-cache.cpp ..\common\MLayerCache.cpp ..\common\MRenderQueue.cpp ..\common\MSpriteBatch.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" ^
+-o ../bench-layer-cache.exe
+g++ bench-hot-reload.cpp ..\common\MAssetWatcher.cpp ..\common\MAsyncLoader.cpp ..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp -O2 -DMPROFILER_ENABLED=0 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-hot-reload.exe
+g++ bench-fixed-timestep.cpp ..\common\MFixedTimestep.cpp -O2 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-o ../bench-fixed-timestep.exe
+g++ bench-texture-move.cpp ..\common\MTexture.cpp ..\common\MSurfaceArena.cpp ..\common\MColorKeyConverter.cpp ..\common\MDirtyRegion.cpp ..\common\MProfiler.cpp -O2 -DMPROFILER_ENABLED=0 -std=c++2a ^
+-I "..\common" ^
+-I "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\include" -L "..\lib\SDL3-3.2.18\x86_64-w64-mingw32\lib" -lSDL3 ^
+-I "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\include" -L "..\lib\SDL3_image-3.2.4\x86_64-w64-mingw32\lib" -lSDL3_image ^
+-o ../bench-texture-move.exe
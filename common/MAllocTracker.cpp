@@ -0,0 +1,310 @@
+#include "MAllocTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// Counters of every thread, and of the calling thread only (a frame only counts the allocations of the render thread)
+static std::atomic<Uint64> total_cpp{0};
+static std::atomic<Uint64> total_sdl{0};
+static thread_local Uint64 thread_cpp{0};
+static thread_local Uint64 thread_sdl{0};
+
+// SDL's own memory functions, called by the counting ones
+static SDL_malloc_func original_malloc{nullptr};
+static SDL_calloc_func original_calloc{nullptr};
+static SDL_realloc_func original_realloc{nullptr};
+static SDL_free_func original_free{nullptr};
+
+// Header in front of every block handed to SDL: its capacity, and the next free block of its class while it is in the pool
+// (16 bytes, so that the block keeps the alignment of the system allocator)
+struct alignas(16) PoolHeader
+{
+    size_t capacity;  // Bytes the block holds: the size of its class, or the size requested above the largest class
+    PoolHeader *next; // Next free block of the class
+};
+constexpr int UNPOOLED_CLASS{0}; // Size class of the blocks too large for the pool
+
+// Pool of the blocks SDL freed, one list per size class
+static std::mutex pool_mutex;
+static PoolHeader *free_blocks[MAllocTracker::MAX_POOL_SHIFT + 1]{};
+static std::atomic<bool> pooling{false};
+static std::atomic<Uint64> pool_reuses{0};
+static std::atomic<size_t> pooled_bytes{0};
+
+// Function to count one allocation of the calling thread
+static inline void countAllocation(std::atomic<Uint64> &total, Uint64 &thread_total)
+{
+    total.fetch_add(1, std::memory_order_relaxed);
+    thread_total++;
+}
+
+// Function to get the smallest size class holding size bytes, UNPOOLED_CLASS above the largest one
+static inline int getSizeClass(const size_t size)
+{
+    int size_class{MAllocTracker::MIN_POOL_SHIFT};
+    while (size_class <= MAllocTracker::MAX_POOL_SHIFT && ((size_t)1 << size_class) < size)
+    {
+        size_class++;
+    }
+    return size_class <= MAllocTracker::MAX_POOL_SHIFT ? size_class : UNPOOLED_CLASS;
+}
+
+// Function to get a block of at least size bytes: a free block of its class, or a new one counted as an SDL allocation
+static void *allocateBlock(const size_t size)
+{
+    const int size_class = getSizeClass(size);
+    if (size_class != UNPOOLED_CLASS)
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (PoolHeader *header = free_blocks[size_class]; header != nullptr)
+        {
+            free_blocks[size_class] = header->next;
+            pooled_bytes.fetch_sub((size_t)1 << size_class, std::memory_order_relaxed);
+            pool_reuses.fetch_add(1, std::memory_order_relaxed);
+            return header + 1;
+        }
+    }
+
+    // Blocks are allocated at the size of their class, so that they can join the pool once freed
+    const size_t capacity = size_class != UNPOOLED_CLASS ? (size_t)1 << size_class : size;
+    if (capacity > SDL_SIZE_MAX - sizeof(PoolHeader))
+    {
+        return nullptr;
+    }
+    countAllocation(total_sdl, thread_sdl);
+    PoolHeader *header = (PoolHeader *)original_malloc(sizeof(PoolHeader) + capacity);
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+    header->capacity = capacity;
+    return header + 1;
+}
+
+// Function to put a block back in the pool of its class, or give it back to the system allocator
+static void freeBlock(void *memory)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+    PoolHeader *header = (PoolHeader *)memory - 1;
+    const int size_class = getSizeClass(header->capacity);
+    if (size_class != UNPOOLED_CLASS && pooling.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        header->next = free_blocks[size_class];
+        free_blocks[size_class] = header;
+        pooled_bytes.fetch_add(header->capacity, std::memory_order_relaxed);
+        return;
+    }
+    original_free(header);
+}
+
+// Functions handed to SDL_SetMemoryFunctions: a realloc that outgrows its block counts as an allocation, as it moves the block
+static void *SDLCALL countingMalloc(size_t size) { return allocateBlock(size); }
+static void *SDLCALL countingCalloc(size_t count, size_t size)
+{
+    if (size != 0 && count > SDL_SIZE_MAX / size)
+    {
+        return nullptr;
+    }
+    void *memory = allocateBlock(count * size);
+    if (memory != nullptr)
+    {
+        std::memset(memory, 0, count * size);
+    }
+    return memory;
+}
+static void *SDLCALL countingRealloc(void *memory, size_t size)
+{
+    if (memory == nullptr)
+    {
+        return allocateBlock(size);
+    }
+
+    // The block still holds the new size: nothing moves
+    const size_t capacity = ((const PoolHeader *)memory - 1)->capacity;
+    if (size <= capacity)
+    {
+        return memory;
+    }
+
+    // Otherwise copy into a larger block, the old one goes back to the pool
+    void *moved = allocateBlock(size);
+    if (moved != nullptr)
+    {
+        std::memcpy(moved, memory, capacity);
+        freeBlock(memory);
+    }
+    return moved;
+}
+static void SDLCALL countingFree(void *memory) { freeBlock(memory); }
+
+#if MALLOC_TRACKER_ENABLED
+// Replacements of the global allocation functions: new[] and the nothrow forms call this one, the aligned forms (alignas above 16) are not counted
+void *operator new(size_t size)
+{
+    countAllocation(total_cpp, thread_cpp);
+    if (void *memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, size_t) noexcept { std::free(memory); }
+#endif
+
+// ############################################################################################
+// AllocTracker's install function wraps SDL's memory functions with the counting ones
+bool MAllocTracker::install()
+{
+    if constexpr (MALLOC_TRACKER_ENABLED == 0)
+    {
+        return true; // Nothing is counted
+    }
+    if (installed)
+    {
+        return true;
+    }
+
+    SDL_GetOriginalMemoryFunctions(&original_malloc, &original_calloc, &original_realloc, &original_free);
+    if (!SDL_SetMemoryFunctions(countingMalloc, countingCalloc, countingRealloc, countingFree))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to count SDL's allocations: %s\n", SDL_GetError());
+        return false;
+    }
+    installed = true;
+    return true;
+}
+
+// ############################################################################################
+// AllocTracker's setPooling function starts or stops keeping the blocks SDL frees
+void MAllocTracker::setPooling(const bool enabled)
+{
+    if (enabled && !installed)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to pool SDL's allocations: the memory functions are not installed\n");
+        return;
+    }
+    pooling.store(enabled, std::memory_order_relaxed);
+}
+
+// ############################################################################################
+// AllocTracker's trimPool function frees every block of the pool
+size_t MAllocTracker::trimPool()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    size_t freed{0};
+    for (PoolHeader *&list : free_blocks)
+    {
+        while (list != nullptr)
+        {
+            PoolHeader *header = list;
+            list = header->next;
+            freed += header->capacity;
+            original_free(header);
+        }
+    }
+    pooled_bytes.fetch_sub(freed, std::memory_order_relaxed);
+    return freed;
+}
+
+// ############################################################################################
+// AllocTracker's isPooling function returns the pooling state
+bool MAllocTracker::isPooling()
+{
+    return pooling.load(std::memory_order_relaxed);
+}
+
+// ############################################################################################
+// AllocTracker's getPoolReuses function returns the number of allocations the pool served
+Uint64 MAllocTracker::getPoolReuses()
+{
+    return pool_reuses.load(std::memory_order_relaxed);
+}
+
+// ############################################################################################
+// AllocTracker's getPooledBytes function returns the bytes held by the free blocks of the pool
+size_t MAllocTracker::getPooledBytes()
+{
+    return pooled_bytes.load(std::memory_order_relaxed);
+}
+
+// ############################################################################################
+// AllocTracker's getTotalCounts function returns the counters shared by every thread
+MAllocTracker::Counts MAllocTracker::getTotalCounts()
+{
+    return Counts{total_cpp.load(std::memory_order_relaxed), total_sdl.load(std::memory_order_relaxed)};
+}
+
+// ############################################################################################
+// AllocTracker's getThreadCounts function returns the counters of the calling thread
+MAllocTracker::Counts MAllocTracker::getThreadCounts()
+{
+    return Counts{thread_cpp, thread_sdl};
+}
+
+// ############################################################################################
+// AllocTracker's beginFrame function restarts the frame count, so that the idle loop iterations before a frame are not counted
+void MAllocTracker::beginFrame()
+{
+    if constexpr (MALLOC_TRACKER_ENABLED != 0)
+    {
+        frame_start = getThreadCounts();
+    }
+}
+
+// ############################################################################################
+// AllocTracker's endFrame function counts the allocations of the frame and reports them in strict mode
+Uint64 MAllocTracker::endFrame()
+{
+    if constexpr (MALLOC_TRACKER_ENABLED == 0)
+    {
+        return 0; // Nothing counted
+    }
+
+    const Counts now = getThreadCounts();
+    last_frame = Counts{now.cpp - frame_start.cpp, now.sdl - frame_start.sdl};
+    const Uint64 allocations = last_frame.cpp + last_frame.sdl;
+    frame_count++;
+    max_frame_allocations = SDL_max(max_frame_allocations, allocations);
+    if (allocations > 0)
+    {
+        allocating_frames++;
+    }
+
+    // A steady-state frame draws resources that are already loaded into buffers that already grew: any allocation is a regression
+    const bool checked = strict && !expected && frame_count > steady_frame;
+    if (checked && (last_frame.cpp > 0 || (strict_sdl && last_frame.sdl > 0)))
+    {
+        violation_count++;
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Steady-state frame %llu allocated %llu times (%llu C++, %llu SDL)\n",
+                     (unsigned long long)frame_count, (unsigned long long)allocations, (unsigned long long)last_frame.cpp, (unsigned long long)last_frame.sdl);
+    }
+
+    // The next frame starts now: the report above is not part of it
+    expected = false;
+    frame_start = getThreadCounts();
+    return allocations;
+}
+
+// ############################################################################################
+// AllocTracker's expectAllocations function lets the current frame allocate without being reported
+void MAllocTracker::expectAllocations()
+{
+    expected = true;
+}
+
+// ############################################################################################
+// AllocTracker's setStrict function starts or stops the steady-state check
+void MAllocTracker::setStrict(const bool enabled, const int warmup_frames, const bool count_sdl)
+{
+    strict = enabled;
+    strict_sdl = count_sdl;
+    steady_frame = frame_count + (Uint64)SDL_max(warmup_frames, 0);
+}
+// ############################################################################################
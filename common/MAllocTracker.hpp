@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Compile-time switch: when 0, the allocation functions are not replaced and the tracker counts nothing
+// Override it with -DMALLOC_TRACKER_ENABLED=0 or 1, by default release builds (NDEBUG) are not tracked
+#ifndef MALLOC_TRACKER_ENABLED
+#ifdef NDEBUG
+#define MALLOC_TRACKER_ENABLED 0
+#else
+#define MALLOC_TRACKER_ENABLED 1
+#endif
+#endif
+
+// Heap allocation counter: the global operator new and the memory functions handed to SDL (SDL_SetMemoryFunctions) count every
+// allocation, so that each frame reports how often it allocated and a steady-state frame can be required to allocate nothing
+// Frames are counted on the thread that calls beginFrame and endFrame (the render thread): worker threads (e.g. MAsyncLoader) are not part of a frame
+// Pooling (setPooling): the blocks SDL frees are kept in power-of-two size classes and handed back by its next allocation of the class, so
+// that work repeating the same allocations (e.g. decoding the same images again) stops reaching the system allocator once warm; only the
+// allocations served by the system allocator are counted
+class MAllocTracker
+{
+public:
+    // Structure to hold allocation counts, split by the allocator they went through
+    struct Counts
+    {
+        Uint64 cpp; // Allocations through operator new (C++ containers, std::string, std::make_shared, ...)
+        Uint64 sdl; // Allocations through SDL_malloc, SDL_calloc and SDL_realloc (surfaces, textures, renderer buffers, ...), not served by the pool
+    };
+
+    static constexpr int MIN_POOL_SHIFT{4};  // Smallest size class of the pool: 16 bytes
+    static constexpr int MAX_POOL_SHIFT{28}; // Largest size class of the pool: 256 MiB, larger blocks always go back to the system
+
+private:
+    inline static bool installed{false};           // Flag to indicate that SDL's memory functions have been replaced
+    inline static bool strict{false};              // Flag to report the steady-state frames that allocate
+    inline static bool strict_sdl{true};           // Flag to also report the frames where only SDL allocated
+    inline static bool expected{false};            // Flag to excuse the current frame (a resource is loaded or resized)
+    inline static Uint64 steady_frame{0};          // First frame checked by the strict mode, the earlier ones warm the buffers up
+    inline static Counts frame_start{};            // Counts of the render thread when the current frame started
+    inline static Counts last_frame{};             // Allocations of the last frame that ended
+    inline static Uint64 frame_count{0};           // Number of frames ended
+    inline static Uint64 allocating_frames{0};     // Number of frames that allocated at least once
+    inline static Uint64 max_frame_allocations{0}; // Most allocations made by one frame
+    inline static Uint64 violation_count{0};       // Number of steady-state frames that allocated in strict mode
+
+public:
+    // Function to count SDL's allocations too: must be called before SDL_Init, SDL's memory functions cannot change once it allocated
+    static bool install();
+
+    // Function to keep the blocks SDL frees for its next allocations of the same size class (needs install; the blocks kept so far are
+    // still reused after disabling it, until trimPool)
+    static void setPooling(const bool enabled);
+
+    // Function to give the blocks kept by the pool back to the system allocator: returns the number of bytes freed
+    static size_t trimPool();
+
+    // Function to check whether the blocks SDL frees are kept by the pool
+    static bool isPooling();
+
+    // Function to get the number of SDL allocations served by a block of the pool, from every thread
+    static Uint64 getPoolReuses();
+
+    // Function to get the bytes held by the free blocks of the pool
+    static size_t getPooledBytes();
+
+    // Function to get the allocations made by every thread since the program started
+    static Counts getTotalCounts();
+
+    // Function to get the allocations made by the calling thread since it started
+    static Counts getThreadCounts();
+
+    // Function to mark the start of the frame work (may be called again, e.g. every loop iteration until a frame is presented)
+    static void beginFrame();
+
+    // Function to end the frame after it is presented: returns the number of allocations it made
+    static Uint64 endFrame();
+
+    // Function to excuse the current frame in strict mode, e.g. when it loads a resource or follows a window resize
+    static void expectAllocations();
+
+    // Function to report every frame that allocates once warmup_frames more frames have ended (count_sdl = false only checks the C++ allocations,
+    // e.g. when the renderer is known to allocate on its own)
+    static void setStrict(const bool enabled, const int warmup_frames = 0, const bool count_sdl = true);
+
+    // Getters for the tracker state inline for efficiency
+    inline static const bool isInstalled() { return installed; }                          // Getter for the SDL memory functions state
+    inline static const Counts getLastFrame() { return last_frame; }                      // Getter for the allocations of the last frame
+    inline static const Uint64 getFrameCount() { return frame_count; }                    // Getter for the number of frames ended
+    inline static const Uint64 getAllocatingFrames() { return allocating_frames; }        // Getter for the number of frames that allocated
+    inline static const Uint64 getMaxFrameAllocations() { return max_frame_allocations; } // Getter for the most allocations of one frame
+    inline static const Uint64 getViolationCount() { return violation_count; }            // Getter for the number of steady-state frames that allocated
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <cmath>
+
+// Sine and cosine of the angles that are multiples of 15 degrees (every 30 degree step of tutorial 06, and the quarter turns),
+// computed at compile time, so that quantized rotations need no trigonometry at runtime
+// Quarter turns are exact (0 and +-1): a quad rotated by them stays axis-aligned and only its texture coordinates rotate
+class MAngleTable
+{
+public:
+    static constexpr int STEP_DEGREES{15};              // Angle between two entries of the table
+    static constexpr int SIZE{360 / STEP_DEGREES};      // Number of entries in a turn
+    static constexpr int QUARTER{90 / STEP_DEGREES};    // Number of entries in a quarter turn
+
+private:
+    // Structure to hold one entry of the table
+    struct Entry
+    {
+        float sin_a; // Sine of the angle
+        float cos_a; // Cosine of the angle
+    };
+
+    // Function to compute sine and cosine of an angle in [-45, 45] degrees with their Taylor series (enough terms for double precision)
+    static constexpr Entry taylor(const double degree)
+    {
+        const double x = degree * (SDL_PI_D / 180.0);
+        double sin_term{x}, cos_term{1.0};
+        double sin_sum{x}, cos_sum{1.0};
+        for (int n = 1; n < 12; n++)
+        {
+            sin_term *= -x * x / ((2 * n) * (2 * n + 1));
+            cos_term *= -x * x / ((2 * n - 1) * (2 * n));
+            sin_sum += sin_term;
+            cos_sum += cos_term;
+        }
+        return {(float)sin_sum, (float)cos_sum};
+    }
+
+    // Function to build the table: each entry is reduced to [-45, 45] degrees, then moved to its quarter by swapping and negating
+    static constexpr std::array<Entry, SIZE> build()
+    {
+        std::array<Entry, SIZE> table{};
+        for (int i = 0; i < SIZE; i++)
+        {
+            const int quarter = (i + QUARTER / 2) / QUARTER;
+            const Entry reduced = taylor((double)((i - quarter * QUARTER) * STEP_DEGREES));
+            const Entry turned[4]{{reduced.sin_a, reduced.cos_a}, {reduced.cos_a, -reduced.sin_a}, {-reduced.sin_a, -reduced.cos_a}, {-reduced.cos_a, reduced.sin_a}};
+            table[i] = turned[quarter % 4];
+        }
+        return table;
+    }
+
+    static const std::array<Entry, SIZE> table; // Sine and cosine of every multiple of the step in a turn (defined after the class, built at compile time)
+
+    // Function to get the index of an angle in the table, -1 if it is not a multiple of the step
+    static inline int getIndex(const double degree)
+    {
+        const double steps = degree / STEP_DEGREES;
+        if (!(std::fabs(steps) < 1e9) || steps != std::floor(steps))
+        {
+            return -1; // Not a multiple of the step (or not a finite angle of a reasonable size)
+        }
+        const int index = (int)((long long)steps % SIZE);
+        return index < 0 ? index + SIZE : index;
+    }
+
+public:
+    // Function to get sine and cosine of an angle from the table: returns false, leaving them unchanged, if the angle is not a multiple of the step
+    static inline bool lookup(const double degree, float &sin_a, float &cos_a)
+    {
+        const int index = getIndex(degree);
+        if (index < 0)
+        {
+            return false;
+        }
+        sin_a = table[index].sin_a;
+        cos_a = table[index].cos_a;
+        return true;
+    }
+
+    // Function to get the number of clockwise quarter turns (0 to 3) of an angle, -1 if it is not a multiple of 90 degrees
+    static inline int getQuarterTurns(const double degree)
+    {
+        const int index = getIndex(degree);
+        return index >= 0 && index % QUARTER == 0 ? index / QUARTER : -1;
+    }
+};
+
+// The table is built once the class is complete, when build can be evaluated at compile time
+inline constexpr std::array<MAngleTable::Entry, MAngleTable::SIZE> MAngleTable::table{MAngleTable::build()};
@@ -0,0 +1,160 @@
+#include "MAssetPack.hpp"
+#include "MLog.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// AssetPack's destructor unmaps the file
+MAssetPack::~MAssetPack() { close(); }
+
+// ############################################################################################
+// AssetPack's open function maps the whole pack file into memory
+bool MAssetPack::open(const std::string &file_path)
+{
+    // Close any pack that is already open
+    this->close();
+
+    void *mapping{nullptr};
+    size_t mapping_size{0};
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER file_size{};
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+        {
+            if (HANDLE file_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr); file_mapping != nullptr)
+            {
+                mapping = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+                mapping_size = (size_t)file_size.QuadPart;
+                CloseHandle(file_mapping); // The view keeps the mapping alive
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    if (int fd = ::open(file_path.c_str(), O_RDONLY); fd >= 0)
+    {
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+        {
+            mapping = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            mapping_size = (size_t)file_stat.st_size;
+            if (mapping == MAP_FAILED)
+            {
+                mapping = nullptr;
+            }
+        }
+        ::close(fd); // The mapping stays valid after the file is closed
+    }
+#endif
+
+    if (mapping == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to map asset pack %s\n", file_path.c_str());
+        return false; // Return false if mapping fails
+    }
+
+    this->data = (const Uint8 *)mapping;
+    this->size = mapping_size;
+    this->header = (const MAssetPackHeader *)this->data;
+    this->entries = (const MAssetPackEntry *)(this->data + sizeof(MAssetPackHeader));
+
+    if (!validate())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid asset pack %s\n", file_path.c_str());
+        this->close();
+        return false; // Return false if the file is not a valid pack
+    }
+
+    MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Asset pack mapped successfully from %s (%u entries).\n", file_path.c_str(), this->header->entry_count);
+    return true;
+}
+
+// ############################################################################################
+// AssetPack's validate function checks the header and that every entry lies inside the file
+bool MAssetPack::validate() const
+{
+    if (this->size < sizeof(MAssetPackHeader) || std::memcmp(this->header->magic, MASSET_PACK_MAGIC, sizeof(MASSET_PACK_MAGIC)) != 0 || this->header->version != MASSET_PACK_VERSION)
+    {
+        return false;
+    }
+
+    if (this->header->entry_count > (this->size - sizeof(MAssetPackHeader)) / sizeof(MAssetPackEntry))
+    {
+        return false;
+    }
+
+    for (Uint32 i = 0; i < this->header->entry_count; i++)
+    {
+        const MAssetPackEntry &entry = this->entries[i];
+        const Uint64 pixel_bytes = (Uint64)entry.pitch * entry.height;
+        if (entry.name[sizeof(entry.name) - 1] != '\0' || entry.offset > this->size || pixel_bytes > this->size - entry.offset)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ############################################################################################
+// AssetPack's findEntry function looks an asset up by name in the index
+const MAssetPackEntry *MAssetPack::findEntry(const std::string &name) const
+{
+    for (Uint32 i = 0; i < getEntryCount(); i++)
+    {
+        if (name == this->entries[i].name)
+        {
+            return &this->entries[i];
+        }
+    }
+    return nullptr;
+}
+
+// ############################################################################################
+// AssetPack's createSurface function wraps the mapped pixels of an asset in a surface
+SDL_Surface *MAssetPack::createSurface(const std::string &name) const
+{
+    const MAssetPackEntry *entry = findEntry(name);
+    if (entry == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Asset %s not found in pack\n", name.c_str());
+        return nullptr;
+    }
+
+    // The surface does not own the pixels: SDL only reads them when the texture is created
+    SDL_Surface *surface = SDL_CreateSurfaceFrom((int)entry->width, (int)entry->height, (SDL_PixelFormat)this->header->pixel_format, (void *)(this->data + entry->offset), (int)entry->pitch);
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create surface for asset %s: %s\n", name.c_str(), SDL_GetError());
+    }
+    return surface;
+}
+
+// ############################################################################################
+// AssetPack's close function unmaps the file
+void MAssetPack::close()
+{
+    if (this->data != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(this->data);
+#else
+        munmap((void *)this->data, this->size);
+#endif
+    }
+    this->data = nullptr;
+    this->size = 0;
+    this->header = nullptr;
+    this->entries = nullptr;
+}
+// ############################################################################################
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+
+// Pack file layout (native byte order):
+//   MAssetPackHeader | MAssetPackEntry[entry_count] | pixel data of every entry (each block aligned to MASSET_PACK_ALIGNMENT)
+constexpr char MASSET_PACK_MAGIC[4]{'M', 'P', 'A', 'K'};
+constexpr Uint32 MASSET_PACK_VERSION{1};
+constexpr Uint64 MASSET_PACK_ALIGNMENT{64};
+
+// Structure to hold the header at the start of a pack file
+struct MAssetPackHeader
+{
+    char magic[4];       // Always MASSET_PACK_MAGIC
+    Uint32 version;      // Always MASSET_PACK_VERSION
+    Uint32 pixel_format; // SDL_PixelFormat shared by every entry
+    Uint32 entry_count;  // Number of entries in the index
+};
+
+// Structure to hold the index entry of one pre-decoded image
+struct MAssetPackEntry
+{
+    char name[48];   // Null-terminated asset name (e.g. "06arrow.png")
+    Uint32 width;    // Width of the image in pixels
+    Uint32 height;   // Height of the image in pixels
+    Uint32 pitch;    // Bytes per row
+    Uint32 reserved; // Padding, always 0
+    Uint64 offset;   // Offset of the pixel data from the start of the file
+};
+
+static_assert(sizeof(MAssetPackHeader) == 16, "Unexpected pack header size");
+static_assert(sizeof(MAssetPackEntry) == 72, "Unexpected pack entry size");
+
+class MAssetPack
+{
+private:
+    const Uint8 *data;               // Start of the memory-mapped file
+    size_t size;                     // Size of the memory-mapped file
+    const MAssetPackHeader *header;  // Header of the pack (points into the mapping)
+    const MAssetPackEntry *entries;  // Index of the pack (points into the mapping)
+
+    // Function to check that the mapped bytes hold a valid pack
+    bool validate() const;
+
+public:
+    // Constructor to initialize an empty pack
+    MAssetPack() : data(nullptr), size(0), header(nullptr), entries(nullptr) {};
+
+    // Destructor to unmap the file
+    ~MAssetPack();
+
+    // Function to memory-map a pack file
+    bool open(const std::string &file_path);
+
+    // Function to find the entry of an asset (nullptr if it is not in the pack)
+    const MAssetPackEntry *findEntry(const std::string &name) const;
+
+    // Function to create a surface that points straight at the mapped pixels of an asset (no copy, the pack must stay open)
+    SDL_Surface *createSurface(const std::string &name) const;
+
+    // Function to unmap the file
+    void close();
+
+    // Getters for the pack state inline for efficiency
+    inline const bool isOpen() const { return data != nullptr; }                            // Getter for the open state
+    inline const Uint32 getEntryCount() const { return header ? header->entry_count : 0; } // Getter for the number of entries
+};
@@ -0,0 +1,302 @@
+#include "MAssetWatcher.hpp"
+#include "MLog.hpp"
+#include <algorithm>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// AssetWatcher's destructor stops the watcher thread
+MAssetWatcher::~MAssetWatcher() { stop(); }
+
+// ############################################################################################
+// AssetWatcher's start function creates the watcher thread and the worker that decodes the changed files
+bool MAssetWatcher::start(const Uint64 debounce_ns)
+{
+    // Stop any watcher that is already running
+    this->stop();
+    this->debounce_ns = debounce_ns;
+
+    this->mutex = SDL_CreateMutex();
+    if (this->mutex == nullptr || !this->loader.start(1))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to start the asset watcher: %s\n", SDL_GetError());
+        this->stop();
+        return false; // Return false if the watcher cannot run
+    }
+
+#ifdef __linux__
+    // Without inotify (e.g. no instance left), the watcher falls back to polling the modification times
+    this->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->notify_fd < 0)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "inotify is not available: polling the watched files instead\n");
+    }
+#endif
+
+    if (this->thread = SDL_CreateThread(watcherMain, "MAssetWatcher", this); this->thread == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create asset watcher thread: %s\n", SDL_GetError());
+        this->stop();
+        return false; // Return false if the thread cannot be created
+    }
+
+    MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Asset watcher started (%s, %llu ms debounce).\n", this->isUsingNotify() ? "inotify" : "polling",
+              (unsigned long long)SDL_NS_TO_MS(debounce_ns));
+    return true;
+}
+
+// ############################################################################################
+// AssetWatcher's watch function adds a file to the watched files, and its directory to the watched directories
+bool MAssetWatcher::watch(const std::string_view file_path, const std::shared_ptr<MTexture> &texture, const SDL_Color *color_key, const MColorKeyOptions &key_options)
+{
+    if (this->mutex == nullptr || texture == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to watch %.*s: the watcher is not started or the texture is missing\n", (int)file_path.size(), file_path.data());
+        return false;
+    }
+
+    // Split the path at the last separator: changes are reported per directory entry
+    WatchedAsset asset{};
+    asset.file_path = std::string{file_path};
+    const size_t separator = asset.file_path.find_last_of("/\\");
+    asset.directory = separator == std::string::npos ? std::string{"."} : asset.file_path.substr(0, separator);
+    asset.file_name = separator == std::string::npos ? asset.file_path : asset.file_path.substr(separator + 1);
+    asset.texture = texture;
+    asset.has_color_key = color_key != nullptr;
+    asset.color_key = color_key != nullptr ? *color_key : SDL_Color{};
+    asset.key_options = key_options;
+    SDL_PathInfo info{};
+    asset.modify_time = SDL_GetPathInfo(asset.file_path.c_str(), &info) ? info.modify_time : 0;
+    asset.changed_ns = 0;
+
+    SDL_LockMutex(this->mutex);
+    bool success{true};
+#ifdef __linux__
+    // Watch the directory once, for the files written in place and for the files moved over the old ones
+    const bool watched = std::any_of(this->directories.begin(), this->directories.end(), [&asset](const WatchedDirectory &directory)
+                                     { return directory.path == asset.directory; });
+    if (this->notify_fd >= 0 && !watched)
+    {
+        const int descriptor = inotify_add_watch(this->notify_fd, asset.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (descriptor < 0)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to watch directory %s\n", asset.directory.c_str());
+            success = false;
+        }
+        else
+        {
+            this->directories.push_back(WatchedDirectory{descriptor, asset.directory});
+        }
+    }
+#endif
+    if (success)
+    {
+        this->assets.push_back(std::move(asset));
+    }
+    SDL_UnlockMutex(this->mutex);
+    return success;
+}
+
+// ############################################################################################
+// AssetWatcher's watcherMain function checks for changes until the watcher stops
+int SDLCALL MAssetWatcher::watcherMain(void *data)
+{
+    MAssetWatcher *watcher = (MAssetWatcher *)data;
+
+    while (!watcher->stopping.load())
+    {
+        watcher->waitForChanges();
+        watcher->requestDebounced();
+    }
+    return 0;
+}
+
+// ############################################################################################
+// AssetWatcher's waitForChanges function blocks for at most POLL_INTERVAL_MS and marks the files that changed meanwhile
+void MAssetWatcher::waitForChanges()
+{
+#ifdef __linux__
+    if (this->notify_fd >= 0)
+    {
+        pollfd notify_poll{this->notify_fd, POLLIN, 0};
+        if (poll(&notify_poll, 1, POLL_INTERVAL_MS) <= 0)
+        {
+            return; // Timeout: nothing changed
+        }
+
+        // Read every pending event: each names an entry of a watched directory
+        alignas(inotify_event) char buffer[4096];
+        const ssize_t length = read(this->notify_fd, buffer, sizeof(buffer));
+        const Uint64 now_ns = SDL_GetTicksNS();
+        SDL_LockMutex(this->mutex);
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event *event = (const inotify_event *)(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // The kernel queue overflowed (wd is -1): the events dropped may name any watched file, so every one is reloaded
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "inotify queue overflow: reloading every watched file\n");
+                for (const WatchedAsset &asset : this->assets)
+                {
+                    this->markChanged(asset.directory, asset.file_name.c_str(), now_ns);
+                }
+                continue;
+            }
+            if (event->len == 0)
+            {
+                continue; // Event about the directory itself
+            }
+            for (const WatchedDirectory &directory : this->directories)
+            {
+                if (directory.descriptor == event->wd)
+                {
+                    this->markChanged(directory.path, event->name, now_ns);
+                }
+            }
+        }
+        SDL_UnlockMutex(this->mutex);
+        return;
+    }
+#endif
+
+    // Polling fallback: compare the modification time of every watched file with the last one seen
+    SDL_Delay(POLL_INTERVAL_MS);
+    const Uint64 now_ns = SDL_GetTicksNS();
+    SDL_LockMutex(this->mutex);
+    for (WatchedAsset &asset : this->assets)
+    {
+        SDL_PathInfo info{};
+        if (SDL_GetPathInfo(asset.file_path.c_str(), &info) && info.modify_time != asset.modify_time)
+        {
+            asset.modify_time = info.modify_time;
+            this->markChanged(asset.directory, asset.file_name.c_str(), now_ns);
+        }
+    }
+    SDL_UnlockMutex(this->mutex);
+}
+
+// ############################################################################################
+// AssetWatcher's markChanged function restarts the debounce delay of the files matching a directory entry
+void MAssetWatcher::markChanged(const std::string &directory, const char *file_name, const Uint64 now_ns)
+{
+    for (WatchedAsset &asset : this->assets)
+    {
+        if (asset.file_name == file_name && asset.directory == directory)
+        {
+            asset.changed_ns = now_ns; // A file still being written keeps pushing its reload back
+            this->changes_detected++;
+        }
+    }
+}
+
+// ############################################################################################
+// AssetWatcher's requestDebounced function queues the decode of the files that stopped changing
+void MAssetWatcher::requestDebounced()
+{
+    const Uint64 now_ns = SDL_GetTicksNS();
+    SDL_LockMutex(this->mutex);
+    for (WatchedAsset &asset : this->assets)
+    {
+        // A file changed again while its previous reload is in flight is requested once that one is swapped in
+        if (asset.changed_ns != 0 && now_ns - asset.changed_ns >= this->debounce_ns && asset.load == nullptr)
+        {
+            asset.load = this->loader.request(asset.file_path); // Decoded without the key: update keys it, keeping the plain variant if there is one
+            asset.changed_ns = 0;
+            MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Reloading %s.\n", asset.file_path.c_str());
+        }
+    }
+    SDL_UnlockMutex(this->mutex);
+}
+
+// ############################################################################################
+// AssetWatcher's update function uploads the decoded files into their textures
+int MAssetWatcher::update(SDL_Renderer *renderer, const int max_swaps)
+{
+    int swaps{0};
+
+    while (swaps < max_swaps)
+    {
+        std::shared_ptr<MAsyncLoad> load = this->loader.popCompleted();
+        if (load == nullptr)
+        {
+            break; // Nothing else is ready this frame
+        }
+
+        // Find the texture of the reload, and let the watcher thread request the next one
+        std::shared_ptr<MTexture> texture{};
+        bool has_color_key{false};
+        SDL_Color color_key{};
+        MColorKeyOptions key_options{};
+        SDL_LockMutex(this->mutex);
+        for (WatchedAsset &asset : this->assets)
+        {
+            if (asset.load == load)
+            {
+                texture = asset.texture;
+                has_color_key = asset.has_color_key;
+                color_key = asset.color_key;
+                key_options = asset.key_options;
+                asset.load = nullptr;
+            }
+        }
+        SDL_UnlockMutex(this->mutex);
+        if (texture == nullptr)
+        {
+            continue; // The file was forgotten while the reload was in flight
+        }
+
+        // A file that cannot be decoded (e.g. saved half-way) or uploaded keeps the old texture until the next change
+        SDL_Surface *decoded_surface = load->takeSurface();
+        if (load->state != MAsyncLoad::DECODED)
+        {
+            this->failed_reloads++;
+        }
+        else if (texture->reloadTexture(decoded_surface, renderer, has_color_key ? &color_key : nullptr, key_options))
+        {
+            this->reloads++;
+            MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Texture reloaded from %s.\n", load->file_path.c_str());
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to reload texture from %s\n", load->file_path.c_str());
+            this->failed_reloads++;
+        }
+        SDL_DestroySurface(decoded_surface);
+        swaps++;
+    }
+
+    return swaps;
+}
+
+// ############################################################################################
+// AssetWatcher's stop function joins the watcher thread and forgets the watched files
+void MAssetWatcher::stop()
+{
+    // Ask the watcher thread to exit: it wakes up at least every POLL_INTERVAL_MS
+    this->stopping = true;
+    if (this->thread != nullptr)
+    {
+        SDL_WaitThread(this->thread, nullptr);
+        this->thread = nullptr;
+    }
+    this->loader.stop();
+
+#ifdef __linux__
+    if (this->notify_fd >= 0)
+    {
+        close(this->notify_fd); // Closing the instance removes its watches
+    }
+#endif
+    this->notify_fd = -1;
+    this->assets.clear();
+    this->directories.clear();
+
+    SDL_DestroyMutex(this->mutex);
+    this->mutex = nullptr;
+    this->stopping = false;
+}
+// ############################################################################################
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MTexture.hpp"
+#include "MAsyncLoader.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Hot reload of the image files behind loaded textures: a watcher thread detects the files that changed (inotify on Linux, modification
+// times polled with SDL_GetPathInfo elsewhere), waits until a file stays unchanged for the debounce delay, and has it decoded by its own
+// MAsyncLoader worker; update swaps the new pixels into the same MTexture at the next frame boundary, so every holder of the texture sees them
+// The new textures are created before the old ones are destroyed (MTexture::reloadTexture): a failed reload keeps what is on screen
+// The directories of the files are watched rather than the files themselves, so editors that save by replacing the file are followed too
+class MAssetWatcher
+{
+public:
+    static constexpr Uint64 DEFAULT_DEBOUNCE_NS{200 * SDL_NS_PER_MS}; // Delay without change before a file is reloaded
+    static constexpr Sint32 POLL_INTERVAL_MS{50};                      // Longest wait of the watcher thread between two checks
+
+private:
+    // Structure to hold one watched file
+    struct WatchedAsset
+    {
+        std::string file_path;             // Path of the image file, as given to watch
+        std::string directory;             // Directory of the file ("." for a bare file name)
+        std::string file_name;             // File name inside the directory
+        std::shared_ptr<MTexture> texture; // Texture whose content is replaced on reload
+        bool has_color_key;                // Flag to indicate if a color is made transparent
+        SDL_Color color_key;               // Color made transparent, on the render thread so that a kept plain variant is rebuilt too
+        MColorKeyOptions key_options;      // Options of the color key conversion
+        SDL_Time modify_time;              // Last modification time seen (polling fallback)
+        Uint64 changed_ns;                 // Time of the last change not yet reloaded (0 = none)
+        std::shared_ptr<MAsyncLoad> load;  // Reload in flight, until update swaps it in
+    };
+
+    // Structure to hold one watched directory (inotify)
+    struct WatchedDirectory
+    {
+        int descriptor;   // Watch descriptor returned by inotify_add_watch
+        std::string path; // Path of the directory
+    };
+
+    std::vector<WatchedAsset> assets;          // Watched files (protected by mutex)
+    std::vector<WatchedDirectory> directories; // Watched directories (protected by mutex)
+    MAsyncLoader loader;                       // Worker decoding the changed files
+    SDL_Thread *thread;                        // Watcher thread
+    SDL_Mutex *mutex;                          // Mutex protecting the watched files and directories
+    std::atomic<bool> stopping;                // Flag to ask the watcher thread to exit
+    int notify_fd;                             // inotify instance (-1 when polling)
+    Uint64 debounce_ns;                        // Delay without change before a file is reloaded
+    std::atomic<Uint64> changes_detected;      // Number of file changes seen by the watcher thread
+    Uint64 reloads;                            // Number of textures swapped by update
+    Uint64 failed_reloads;                     // Number of changed files that could not be decoded (the old texture is kept)
+
+    // Function run by the watcher thread
+    static int SDLCALL watcherMain(void *data);
+
+    // Function to wait for file changes and mark the changed files (watcher thread)
+    void waitForChanges();
+
+    // Function to mark the files of a directory entry as changed (watcher thread, mutex held)
+    void markChanged(const std::string &directory, const char *file_name, const Uint64 now_ns);
+
+    // Function to request the reload of the files that stayed unchanged for the debounce delay (watcher thread)
+    void requestDebounced();
+
+public:
+    // Constructor to initialize a stopped watcher
+    MAssetWatcher() : thread(nullptr), mutex(nullptr), stopping(false), notify_fd(-1), debounce_ns(DEFAULT_DEBOUNCE_NS), changes_detected(0), reloads(0), failed_reloads(0) {};
+
+    // Destructor to stop the watcher thread
+    ~MAssetWatcher();
+
+    // Function to start the watcher thread and its decoding worker
+    bool start(const Uint64 debounce_ns = DEFAULT_DEBOUNCE_NS);
+
+    // Function to reload a texture whenever its file changes (render thread): the texture must have been loaded from that file, and its
+    // first load must be done (a reload swapped in before it would be overwritten by it)
+    bool watch(const std::string_view file_path, const std::shared_ptr<MTexture> &texture, const SDL_Color *color_key = nullptr, const MColorKeyOptions &key_options = {});
+
+    // Function to swap the reloaded textures in (render thread, between two frames), at most max_swaps per call: returns the number swapped
+    int update(SDL_Renderer *renderer, const int max_swaps = 1);
+
+    // Function to stop the watcher thread and forget the watched files (must be called before the renderer is destroyed)
+    void stop();
+
+    // Getters for the watcher statistics inline for efficiency
+    inline const Uint64 getChangesDetected() const { return changes_detected.load(); } // Getter for the number of file changes seen
+    inline const Uint64 getReloads() const { return reloads; }                         // Getter for the number of textures reloaded
+    inline const Uint64 getFailedReloads() const { return failed_reloads; }            // Getter for the number of reloads that failed
+    inline const bool isUsingNotify() const { return notify_fd >= 0; }                 // Getter for the inotify state (false when polling)
+    inline const bool isStarted() const { return thread != nullptr; }                  // Getter for the watcher state
+};
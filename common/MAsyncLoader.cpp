@@ -0,0 +1,206 @@
+#include "MAsyncLoader.hpp"
+#include "MLog.hpp"
+#include <algorithm>
+
+// AsyncLoader's destructor stops the worker threads
+MAsyncLoader::~MAsyncLoader() { stop(); }
+
+// ############################################################################################
+// AsyncLoader's start function creates the synchronization objects and the worker threads
+bool MAsyncLoader::start(int thread_count)
+{
+    // Stop any worker that is already running
+    this->stop();
+
+    if (thread_count <= 0)
+    {
+        thread_count = std::max(1, SDL_GetNumLogicalCPUCores() - 1);
+    }
+
+    this->jobs_mutex = SDL_CreateMutex();
+    this->jobs_condition = SDL_CreateCondition();
+    if (this->jobs_mutex == nullptr || this->jobs_condition == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create the async loader synchronization objects: %s\n", SDL_GetError());
+        this->stop();
+        return false; // Return false if the loader cannot run
+    }
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        if (SDL_Thread *worker = SDL_CreateThread(workerMain, "MAsyncLoader", this); worker != nullptr)
+        {
+            this->workers.push_back(worker);
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create async loader thread: %s\n", SDL_GetError());
+        }
+    }
+
+    if (this->workers.empty())
+    {
+        this->stop();
+        return false; // Return false if no worker could be created
+    }
+
+    MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Async loader started with %d worker threads.\n", (int)this->workers.size());
+    return true;
+}
+
+// ############################################################################################
+// AsyncLoader's request function queues an image for the worker threads
+std::shared_ptr<MAsyncLoad> MAsyncLoader::request(const std::string_view file_path, const SDL_Color *color_key)
+{
+    auto load = std::make_shared<MAsyncLoad>(file_path, color_key);
+
+    if (this->workers.empty())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Async loader is not started: cannot load %s\n", load->file_path.c_str());
+        load->state = MAsyncLoad::FAILED;
+        return load;
+    }
+
+    this->pending_count++;
+    SDL_LockMutex(this->jobs_mutex);
+    this->jobs.push_back(load);
+    SDL_UnlockMutex(this->jobs_mutex);
+    SDL_SignalCondition(this->jobs_condition);
+
+    return load;
+}
+
+// ############################################################################################
+// AsyncLoader's workerMain function takes jobs from the queue until the loader stops
+int SDLCALL MAsyncLoader::workerMain(void *data)
+{
+    MAsyncLoader *loader = (MAsyncLoader *)data;
+
+    while (true)
+    {
+        // Wait for a job or for the stop request
+        SDL_LockMutex(loader->jobs_mutex);
+        while (loader->jobs.empty() && !loader->stopping)
+        {
+            SDL_WaitCondition(loader->jobs_condition, loader->jobs_mutex);
+        }
+        if (loader->stopping)
+        {
+            SDL_UnlockMutex(loader->jobs_mutex);
+            return 0;
+        }
+        std::shared_ptr<MAsyncLoad> load = std::move(loader->jobs.front());
+        loader->jobs.pop_front();
+        SDL_UnlockMutex(loader->jobs_mutex);
+
+        // Decode outside the lock so the workers run in parallel
+        decode(*load);
+
+        // Publish the finished load on the lock-free completion stack
+        CompletionNode *node = new CompletionNode{std::move(load), loader->completions.load(std::memory_order_relaxed)};
+        while (!loader->completions.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+// ############################################################################################
+// AsyncLoader's decode function loads an image and converts it so that the upload needs no conversion
+void MAsyncLoader::decode(MAsyncLoad &load)
+{
+    // Declare a pointer to hold the loaded surface
+    SDL_Surface *loaded_surface{nullptr};
+
+    // Load the image from the specified file path
+    if (loaded_surface = IMG_Load(load.file_path.c_str()); loaded_surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load texture from %s: %s\n", load.file_path.c_str(), SDL_GetError());
+        load.state.store(MAsyncLoad::FAILED, std::memory_order_release);
+        return;
+    }
+
+    // Copy the pixels into a transparent ARGB8888 surface: keyed pixels are skipped and stay transparent
+    SDL_Surface *converted_surface = SDL_CreateSurface(loaded_surface->w, loaded_surface->h, SDL_PIXELFORMAT_ARGB8888);
+    SDL_SetSurfaceBlendMode(loaded_surface, SDL_BLENDMODE_NONE);
+    if (load.has_color_key)
+    {
+        SDL_SetSurfaceColorKey(loaded_surface, true, SDL_MapSurfaceRGB(loaded_surface, load.color_key.r, load.color_key.g, load.color_key.b));
+    }
+    if (converted_surface == nullptr || !SDL_BlitSurface(loaded_surface, nullptr, converted_surface, nullptr))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to convert texture from %s: %s\n", load.file_path.c_str(), SDL_GetError());
+        SDL_DestroySurface(converted_surface);
+        SDL_DestroySurface(loaded_surface);
+        load.state.store(MAsyncLoad::FAILED, std::memory_order_release);
+        return;
+    }
+    SDL_DestroySurface(loaded_surface);
+
+    load.surface = converted_surface;
+    load.state.store(MAsyncLoad::DECODED, std::memory_order_release);
+}
+
+// ############################################################################################
+// AsyncLoader's popCompleted function returns the finished loads one at a time, oldest first
+std::shared_ptr<MAsyncLoad> MAsyncLoader::popCompleted()
+{
+    // Take everything published by the workers at once, then restore the completion order
+    if (this->completed.empty())
+    {
+        CompletionNode *node = this->completions.exchange(nullptr, std::memory_order_acquire);
+        while (node != nullptr)
+        {
+            CompletionNode *next = node->next;
+            this->completed.push_front(std::move(node->load));
+            delete node;
+            node = next;
+        }
+    }
+
+    if (this->completed.empty())
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<MAsyncLoad> load = std::move(this->completed.front());
+    this->completed.pop_front();
+    this->pending_count--;
+    return load;
+}
+
+// ############################################################################################
+// AsyncLoader's stop function joins the worker threads and drops the unfinished loads
+void MAsyncLoader::stop()
+{
+    // Ask the workers to exit and wait for them
+    if (this->jobs_mutex != nullptr)
+    {
+        SDL_LockMutex(this->jobs_mutex);
+        this->stopping = true;
+        SDL_UnlockMutex(this->jobs_mutex);
+        SDL_BroadcastCondition(this->jobs_condition);
+    }
+    for (SDL_Thread *worker : this->workers)
+    {
+        SDL_WaitThread(worker, nullptr);
+    }
+    this->workers.clear();
+
+    // Drop the loads that were never started and the ones never collected
+    for (std::shared_ptr<MAsyncLoad> &load : this->jobs)
+    {
+        load->state = MAsyncLoad::FAILED;
+    }
+    this->jobs.clear();
+    while (popCompleted() != nullptr)
+    {
+    }
+    this->pending_count = 0;
+
+    SDL_DestroyCondition(this->jobs_condition);
+    SDL_DestroyMutex(this->jobs_mutex);
+    this->jobs_condition = nullptr;
+    this->jobs_mutex = nullptr;
+    this->stopping = false;
+}
+// ############################################################################################
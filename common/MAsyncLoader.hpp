@@ -0,0 +1,91 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Structure to hold one image load: filled by a worker thread, consumed by the render thread
+struct MAsyncLoad
+{
+    // States of a load
+    enum State
+    {
+        PENDING, // Waiting for or being decoded by a worker
+        DECODED, // Decoded and color keyed, waiting for the render thread to upload it
+        FAILED   // The file could not be decoded
+    };
+
+    std::string file_path;    // Path of the image file
+    bool has_color_key;       // Flag to indicate if a color is made transparent
+    SDL_Color color_key;      // Color made transparent
+    SDL_Surface *surface;     // Decoded surface in SDL_PIXELFORMAT_ARGB8888, owned until it is taken
+    std::atomic<State> state; // Current state, written by the worker and read by the render thread
+
+    // Constructor to initialize a pending load
+    MAsyncLoad(const std::string_view file_path, const SDL_Color *color_key)
+        : file_path(file_path), has_color_key(color_key != nullptr), color_key(color_key ? *color_key : SDL_Color{}), surface(nullptr), state(PENDING) {};
+
+    // Destructor to free a surface that was never taken
+    ~MAsyncLoad() { SDL_DestroySurface(surface); }
+
+    // Function to take ownership of the decoded surface
+    inline SDL_Surface *takeSurface()
+    {
+        SDL_Surface *decoded_surface = surface;
+        surface = nullptr;
+        return decoded_surface;
+    }
+};
+
+class MAsyncLoader
+{
+private:
+    // Structure to hold one node of the completion queue
+    struct CompletionNode
+    {
+        std::shared_ptr<MAsyncLoad> load; // Finished load
+        CompletionNode *next;             // Next node (towards older completions)
+    };
+
+    std::vector<SDL_Thread *> workers;                 // Worker threads
+    std::deque<std::shared_ptr<MAsyncLoad>> jobs;      // Loads waiting for a worker
+    SDL_Mutex *jobs_mutex;                             // Mutex protecting the jobs queue
+    SDL_Condition *jobs_condition;                     // Condition signaled when a job is queued or on stop
+    bool stopping;                                     // Flag to ask the workers to exit (protected by jobs_mutex)
+    std::atomic<CompletionNode *> completions;         // Lock-free stack of finished loads, pushed by the workers
+    std::deque<std::shared_ptr<MAsyncLoad>> completed; // Finished loads in completion order, only used by the render thread
+    std::atomic<int> pending_count;                    // Number of requested loads not yet returned by popCompleted
+
+    // Function run by every worker thread
+    static int SDLCALL workerMain(void *data);
+
+    // Function to decode and color key one image (runs on a worker thread)
+    static void decode(MAsyncLoad &load);
+
+public:
+    // Constructor to initialize a stopped loader
+    MAsyncLoader() : jobs_mutex(nullptr), jobs_condition(nullptr), stopping(false), completions(nullptr), pending_count(0) {};
+
+    // Destructor to stop the worker threads
+    ~MAsyncLoader();
+
+    // Function to start the worker threads (thread_count <= 0 uses one thread per CPU core, minus the render thread)
+    bool start(int thread_count = 0);
+
+    // Function to queue an image load: returns immediately with a handle that tracks its progress
+    std::shared_ptr<MAsyncLoad> request(const std::string_view file_path, const SDL_Color *color_key = nullptr);
+
+    // Function to get the next finished load (render thread only): nullptr when none is ready
+    std::shared_ptr<MAsyncLoad> popCompleted();
+
+    // Function to stop the worker threads, dropping the loads that were not started
+    void stop();
+
+    // Getter for the loader state inline for efficiency
+    inline const int getPendingCount() const { return pending_count.load(); } // Getter for the number of loads still in flight
+};
@@ -0,0 +1,213 @@
+#include "MAtlasPacker.hpp"
+#include "MLog.hpp"
+#include <algorithm>
+
+// AtlasPacker's destructor cleans up the images and the pages
+MAtlasPacker::~MAtlasPacker() { clear(); }
+
+// ############################################################################################
+// AtlasPacker's addImage function loads an image that will be packed by the next pack call
+bool MAtlasPacker::addImage(const std::string &file_path, const SDL_Color *color_key)
+{
+    // Declare a pointer to hold the loaded surface
+    SDL_Surface *loaded_surface{nullptr};
+
+    // Load the image from the specified file path
+    if (loaded_surface = IMG_Load(file_path.c_str()); loaded_surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load atlas image from %s: %s\n", file_path.c_str(), SDL_GetError());
+        return false; // Return false if loading fails
+    }
+
+    // Check that the image fits in a page
+    if (loaded_surface->w + this->padding > this->page_size || loaded_surface->h + this->padding > this->page_size)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Atlas image %s (%dx%d) is bigger than a page (%dx%d)\n", file_path.c_str(), loaded_surface->w, loaded_surface->h, this->page_size, this->page_size);
+        SDL_DestroySurface(loaded_surface);
+        return false; // Return false if the image can never be packed
+    }
+
+    // Copy the pixels as they are, skipping the color key if one is given
+    SDL_SetSurfaceBlendMode(loaded_surface, SDL_BLENDMODE_NONE);
+    if (color_key != nullptr && !SDL_SetSurfaceColorKey(loaded_surface, true, SDL_MapSurfaceRGB(loaded_surface, color_key->r, color_key->g, color_key->b)))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to set color key for atlas image: %s\n", SDL_GetError());
+        SDL_DestroySurface(loaded_surface);
+        return false; // Return false if setting color key fails
+    }
+
+    this->images.push_back(Image{file_path, loaded_surface});
+    return true;
+}
+
+// ############################################################################################
+// AtlasPacker's findPosition function finds the lowest (then leftmost) place where a rectangle fits
+bool MAtlasPacker::findPosition(const std::vector<SkylineNode> &skyline, const int w, const int h, int &x, int &y, size_t &node_index) const
+{
+    bool found{false};
+    int best_y{this->page_size};
+
+    for (size_t i = 0; i < skyline.size(); i++)
+    {
+        // The rectangle starts at the left edge of the node and must not leave the page
+        const int left = skyline[i].x;
+        if (left + w > this->page_size)
+        {
+            break; // Following nodes are further right: none of them can fit either
+        }
+
+        // The rectangle rests on the highest node it spans
+        int top{0};
+        int width_left{w};
+        for (size_t j = i; width_left > 0; j++)
+        {
+            top = std::max(top, skyline[j].y);
+            width_left -= skyline[j].width;
+        }
+
+        if (top + h <= this->page_size && top < best_y)
+        {
+            found = true;
+            best_y = top;
+            x = left;
+            y = top;
+            node_index = i;
+        }
+    }
+
+    return found;
+}
+
+// ############################################################################################
+// AtlasPacker's addSkylineLevel function updates the skyline after placing a rectangle
+void MAtlasPacker::addSkylineLevel(std::vector<SkylineNode> &skyline, const size_t node_index, const int x, const int y, const int w, const int h)
+{
+    // Insert the top edge of the new rectangle
+    skyline.insert(skyline.begin() + node_index, SkylineNode{x, y + h, w});
+
+    // Shrink or remove the nodes now covered by the rectangle
+    for (size_t i = node_index + 1; i < skyline.size();)
+    {
+        const int covered = (skyline[i - 1].x + skyline[i - 1].width) - skyline[i].x;
+        if (covered <= 0)
+        {
+            break; // The rest of the skyline is untouched
+        }
+
+        skyline[i].x += covered;
+        skyline[i].width -= covered;
+        if (skyline[i].width > 0)
+        {
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbour nodes at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+// ############################################################################################
+// AtlasPacker's pack function places every image in the first page with room for it and copies its pixels
+bool MAtlasPacker::pack()
+{
+    // Sort the images so that the layout does not depend on the order they were added in
+    std::sort(this->images.begin(), this->images.end(), [](const Image &a, const Image &b)
+              {
+                  if (a.surface->h != b.surface->h)
+                      return a.surface->h > b.surface->h; // Tallest first
+                  if (a.surface->w != b.surface->w)
+                      return a.surface->w > b.surface->w; // Then widest first
+                  return a.name < b.name;                 // Then by name
+              });
+
+    bool success{true};
+
+    for (Image &image : this->images)
+    {
+        const int w = image.surface->w + this->padding;
+        const int h = image.surface->h + this->padding;
+        int x{0};
+        int y{0};
+        size_t node_index{0};
+
+        // Find the first page with room for the image, opening a new page if none has
+        size_t page = 0;
+        while (page < this->pages.size() && !findPosition(this->skylines[page], w, h, x, y, node_index))
+        {
+            page++;
+        }
+        if (page == this->pages.size())
+        {
+            SDL_Surface *new_page = SDL_CreateSurface(this->page_size, this->page_size, SDL_PIXELFORMAT_RGBA32);
+            if (new_page == nullptr)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create atlas page: %s\n", SDL_GetError());
+                success = false;
+                break;
+            }
+            this->pages.push_back(new_page); // New surfaces are cleared to transparent black
+            this->skylines.push_back({SkylineNode{0, 0, this->page_size}});
+            findPosition(this->skylines[page], w, h, x, y, node_index);
+        }
+        addSkylineLevel(this->skylines[page], node_index, x, y, w, h);
+
+        // Copy the image pixels into the page
+        SDL_Rect dstRect{x, y, image.surface->w, image.surface->h};
+        if (!SDL_BlitSurface(image.surface, nullptr, this->pages[page], &dstRect))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to copy %s into atlas page: %s\n", image.name.c_str(), SDL_GetError());
+            success = false;
+        }
+
+        this->regions[image.name] = MAtlasRegion{(int)page, SDL_FRect{(float)x, (float)y, (float)image.surface->w, (float)image.surface->h}};
+        MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Packed %s into atlas page %d at (%d, %d).\n", image.name.c_str(), (int)page, x, y);
+    }
+
+    // The decoded images are no longer needed once they are copied into the pages
+    for (Image &image : this->images)
+    {
+        SDL_DestroySurface(image.surface);
+    }
+    this->images.clear();
+
+    return success;
+}
+
+// ############################################################################################
+// AtlasPacker's findRegion function returns where an image was packed
+const MAtlasRegion *MAtlasPacker::findRegion(const std::string &name) const
+{
+    auto it = this->regions.find(name);
+    return it != this->regions.end() ? &it->second : nullptr;
+}
+
+// ############################################################################################
+// AtlasPacker's clear function cleans up the images and the pages
+void MAtlasPacker::clear()
+{
+    for (Image &image : this->images)
+    {
+        SDL_DestroySurface(image.surface);
+    }
+    for (SDL_Surface *page : this->pages)
+    {
+        SDL_DestroySurface(page);
+    }
+    this->images.clear();
+    this->pages.clear();
+    this->skylines.clear();
+    this->regions.clear();
+}
+// ############################################################################################
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Structure to hold where a packed image ended up: the atlas page and its rectangle in that page
+struct MAtlasRegion
+{
+    int page;       // Index of the atlas page
+    SDL_FRect rect; // Rectangle of the image in the page, usable as a clip rectangle
+};
+
+class MAtlasPacker
+{
+private:
+    // Structure to hold an image waiting to be packed
+    struct Image
+    {
+        std::string name;     // Name used to look the region up (the file path)
+        SDL_Surface *surface; // Decoded image
+    };
+
+    // Structure to hold one segment of the skyline: the top edge of the packed area
+    struct SkylineNode
+    {
+        int x;     // Left edge of the segment
+        int y;     // Height of the packed area along the segment
+        int width; // Width of the segment
+    };
+
+    int page_size;                                         // Width and height of every page
+    int padding;                                           // Empty pixels kept between two images
+    std::vector<Image> images;                             // Images added since the last pack
+    std::vector<SDL_Surface *> pages;                      // Packed pages
+    std::vector<std::vector<SkylineNode>> skylines;        // Skyline of every page
+    std::unordered_map<std::string, MAtlasRegion> regions; // Packed regions keyed by image name
+
+    // Function to find the lowest position of a rectangle on a skyline (bottom-left rule)
+    bool findPosition(const std::vector<SkylineNode> &skyline, const int w, const int h, int &x, int &y, size_t &node_index) const;
+
+    // Function to raise the skyline where a rectangle has been placed
+    void addSkylineLevel(std::vector<SkylineNode> &skyline, const size_t node_index, const int x, const int y, const int w, const int h);
+
+public:
+    // Constructor to initialize the page size and the padding between images
+    MAtlasPacker(const int page_size = 1024, const int padding = 1) : page_size(page_size), padding(padding) {};
+
+    // Destructor to clean up the images and the pages
+    ~MAtlasPacker();
+
+    // Function to load an image to pack, optionally making one color transparent
+    bool addImage(const std::string &file_path, const SDL_Color *color_key = nullptr);
+
+    // Function to pack every added image into pages (the result only depends on the images, never on the call order)
+    bool pack();
+
+    // Function to find the region of a packed image (nullptr if the image was not packed)
+    const MAtlasRegion *findRegion(const std::string &name) const;
+
+    // Function to clear the images and the pages
+    void clear();
+
+    // Getters for the pages inline for efficiency
+    inline const size_t getPageCount() const { return pages.size(); }              // Getter for the number of pages
+    inline SDL_Surface *getPage(const size_t index) const { return pages[index]; } // Getter for a page surface
+};
@@ -0,0 +1,274 @@
+#include "MColorKeyConverter.hpp"
+
+// The SIMD kernels are only compiled for x86 targets, other targets use the scalar kernel
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MKEY_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MKEY_TARGET_SSE2 __attribute__((target("sse2")))
+#define MKEY_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MKEY_TARGET_SSE2
+#define MKEY_TARGET_AVX2
+#endif
+#endif
+
+// Structure to hold the key and the channel layout of one conversion, shared by the kernels
+struct KeyLayout
+{
+    Uint32 key;        // Key color in the pixel layout, alpha bits cleared
+    Uint32 alpha_mask; // Bits of the alpha channel
+    int alpha_shift;   // Position of the alpha channel
+    Uint8 tolerance;   // Largest difference per color channel
+    bool premultiply;  // Flag to multiply the color channels by alpha
+};
+
+// Function to divide a product of two bytes by 255, rounded to nearest (exact for 0 to 255 * 255)
+static inline Uint32 divide255(const Uint32 x)
+{
+    const Uint32 t = x + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// Function to convert one pixel: keyed pixels lose their alpha (and their color when premultiplied)
+static inline Uint32 convertPixel(const Uint32 pixel, const KeyLayout &layout)
+{
+    // A pixel is keyed when every color channel is within the tolerance of the key (the alpha channel is ignored, like SDL does)
+    bool keyed{true};
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        if (shift != layout.alpha_shift)
+        {
+            const int difference = (int)((pixel >> shift) & 0xFF) - (int)((layout.key >> shift) & 0xFF);
+            keyed = keyed && SDL_abs(difference) <= layout.tolerance;
+        }
+    }
+    if (keyed)
+    {
+        return layout.premultiply ? 0 : pixel & ~layout.alpha_mask;
+    }
+    if (!layout.premultiply)
+    {
+        return pixel;
+    }
+
+    // Multiply the color channels by alpha, the alpha channel is kept as it is
+    const Uint32 alpha = (pixel & layout.alpha_mask) >> layout.alpha_shift;
+    Uint32 result{pixel & layout.alpha_mask};
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        if (shift != layout.alpha_shift)
+        {
+            result |= divide255(((pixel >> shift) & 0xFF) * alpha) << shift;
+        }
+    }
+    return result;
+}
+
+// Function to convert the pixels of a row from first to count (scalar kernel, and the last pixels of the SIMD kernels)
+static void convertScalar(Uint32 *pixels, const int first, const int count, const KeyLayout &layout)
+{
+    for (int i = first; i < count; i++)
+    {
+        pixels[i] = convertPixel(pixels[i], layout);
+    }
+}
+
+#ifdef MKEY_X86
+// Function to multiply the color channels of 4 pixels by their alpha (same rounding as divide255)
+MKEY_TARGET_SSE2 static inline __m128i premultiply4(const __m128i pixels, const __m128i alpha_mask, const int alpha_shift)
+{
+    // Alpha of each pixel copied to its 4 bytes, then 255 in the alpha byte so that the alpha channel is multiplied by 1
+    __m128i alpha = _mm_srl_epi32(_mm_and_si128(pixels, alpha_mask), _mm_cvtsi32_si128(alpha_shift)); // Shift by a register: the shift is not a constant
+    alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 8));
+    alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+    alpha = _mm_or_si128(_mm_andnot_si128(alpha_mask, alpha), alpha_mask);
+
+    // Products on 16 bits (at most 255 * 255), divided by 255 with rounding
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), _mm_unpacklo_epi8(alpha, zero)), _mm_set1_epi16(128));
+    __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), _mm_unpackhi_epi8(alpha, zero)), _mm_set1_epi16(128));
+    low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+    high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+    return _mm_packus_epi16(low, high);
+}
+
+// Function to convert a row, 4 pixels per iteration (SSE2 kernel)
+MKEY_TARGET_SSE2 static void convertSSE2(Uint32 *pixels, const int count, const KeyLayout &layout)
+{
+    const __m128i key = _mm_set1_epi32((int)layout.key);
+    const __m128i alpha_mask = _mm_set1_epi32((int)layout.alpha_mask);
+    const __m128i tolerance = _mm_set1_epi8((char)layout.tolerance);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i pixel = _mm_loadu_si128((const __m128i *)(pixels + i));
+
+        // Absolute difference per byte with saturated subtractions, minus the tolerance: a pixel is keyed when no color byte is left
+        const __m128i difference = _mm_or_si128(_mm_subs_epu8(pixel, key), _mm_subs_epu8(key, pixel));
+        const __m128i over = _mm_andnot_si128(alpha_mask, _mm_subs_epu8(difference, tolerance));
+        const __m128i keyed = _mm_cmpeq_epi32(over, _mm_setzero_si128());
+
+        const __m128i result = layout.premultiply ? _mm_andnot_si128(keyed, premultiply4(pixel, alpha_mask, layout.alpha_shift))
+                                                  : _mm_andnot_si128(_mm_and_si128(keyed, alpha_mask), pixel);
+        _mm_storeu_si128((__m128i *)(pixels + i), result);
+    }
+    convertScalar(pixels, i, count, layout);
+}
+
+// Function to convert a row, 8 pixels per iteration: unpacks and packs stay within each 128-bit half, so the pixel order is kept (AVX2 kernel)
+MKEY_TARGET_AVX2 static void convertAVX2(Uint32 *pixels, const int count, const KeyLayout &layout)
+{
+    const __m256i key = _mm256_set1_epi32((int)layout.key);
+    const __m256i alpha_mask = _mm256_set1_epi32((int)layout.alpha_mask);
+    const __m256i tolerance = _mm256_set1_epi8((char)layout.tolerance);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i rounding = _mm256_set1_epi16(128);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i pixel = _mm256_loadu_si256((const __m256i *)(pixels + i));
+        const __m256i difference = _mm256_or_si256(_mm256_subs_epu8(pixel, key), _mm256_subs_epu8(key, pixel));
+        const __m256i over = _mm256_andnot_si256(alpha_mask, _mm256_subs_epu8(difference, tolerance));
+        const __m256i keyed = _mm256_cmpeq_epi32(over, zero);
+
+        __m256i result{};
+        if (layout.premultiply)
+        {
+            __m256i alpha = _mm256_srl_epi32(_mm256_and_si256(pixel, alpha_mask), _mm_cvtsi32_si128(layout.alpha_shift));
+            alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 8));
+            alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+            alpha = _mm256_or_si256(_mm256_andnot_si256(alpha_mask, alpha), alpha_mask);
+            __m256i low = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pixel, zero), _mm256_unpacklo_epi8(alpha, zero)), rounding);
+            __m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pixel, zero), _mm256_unpackhi_epi8(alpha, zero)), rounding);
+            low = _mm256_srli_epi16(_mm256_add_epi16(low, _mm256_srli_epi16(low, 8)), 8);
+            high = _mm256_srli_epi16(_mm256_add_epi16(high, _mm256_srli_epi16(high, 8)), 8);
+            result = _mm256_andnot_si256(keyed, _mm256_packus_epi16(low, high));
+        }
+        else
+        {
+            result = _mm256_andnot_si256(_mm256_and_si256(keyed, alpha_mask), pixel);
+        }
+        _mm256_storeu_si256((__m256i *)(pixels + i), result);
+    }
+    convertScalar(pixels, i, count, layout);
+}
+#endif
+
+// ############################################################################################
+// ColorKeyConverter's constructor selects the kernel, falling back to the scalar one when the CPU lacks the instructions
+MColorKeyConverter::MColorKeyConverter(const Kernel kernel) : kernel(kernel)
+{
+    if (this->kernel == KERNEL_AUTO)
+    {
+        this->kernel = isSupported(KERNEL_AVX2) ? KERNEL_AVX2 : isSupported(KERNEL_SSE2) ? KERNEL_SSE2 : KERNEL_SCALAR;
+    }
+    else if (!isSupported(this->kernel))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Color key kernel %s is not supported by this CPU, using %s\n", getKernelName(this->kernel), getKernelName(KERNEL_SCALAR));
+        this->kernel = KERNEL_SCALAR;
+    }
+}
+
+// ############################################################################################
+// ColorKeyConverter's convert function keys out a color of every row of the surface with the selected kernel
+bool MColorKeyConverter::convert(SDL_Surface *surface, const SDL_Color key, const MColorKeyOptions &options) const
+{
+    if (!canConvert(surface))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Color key conversion needs a 32-bit surface with alpha, not %s\n",
+                     surface != nullptr ? SDL_GetPixelFormatName(surface->format) : "no surface");
+        return false;
+    }
+
+    // Key and masks in the byte order of the surface
+    const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(surface->format);
+    const KeyLayout layout{SDL_MapRGB(details, nullptr, key.r, key.g, key.b) & ~details->Amask, details->Amask, details->Ashift,
+                           (Uint8)SDL_clamp(options.tolerance, 0, 255), options.premultiply};
+
+    if (SDL_MUSTLOCK(surface) && !SDL_LockSurface(surface))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to lock surface for color key conversion: %s\n", SDL_GetError());
+        return false;
+    }
+    for (int y = 0; y < surface->h; y++)
+    {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+#ifdef MKEY_X86
+        if (this->kernel == KERNEL_AVX2)
+        {
+            convertAVX2(row, surface->w, layout);
+            continue;
+        }
+        if (this->kernel == KERNEL_SSE2)
+        {
+            convertSSE2(row, surface->w, layout);
+            continue;
+        }
+#endif
+        convertScalar(row, 0, surface->w, layout);
+    }
+    if (SDL_MUSTLOCK(surface))
+    {
+        SDL_UnlockSurface(surface);
+    }
+    return true;
+}
+
+// ############################################################################################
+// ColorKeyConverter's canConvert function checks that every channel is one byte of a 32-bit pixel, alpha included
+bool MColorKeyConverter::canConvert(const SDL_Surface *surface)
+{
+    if (surface == nullptr)
+    {
+        return false;
+    }
+    switch (surface->format)
+    {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ############################################################################################
+// ColorKeyConverter's isSupported function checks the instruction sets of the CPU
+bool MColorKeyConverter::isSupported(const Kernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef MKEY_X86
+    case KERNEL_SSE2:
+        return SDL_HasSSE2();
+    case KERNEL_AVX2:
+        return SDL_HasAVX2();
+#endif
+    case KERNEL_AUTO:
+    case KERNEL_SCALAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ############################################################################################
+// ColorKeyConverter's getKernelName function returns the printable name of a kernel
+const char *MColorKeyConverter::getKernelName(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KERNEL_SCALAR:
+        return "scalar";
+    case KERNEL_SSE2:
+        return "sse2";
+    case KERNEL_AVX2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
+// ############################################################################################
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Structure to hold the options of a color key conversion (zero-initialized: exact match, straight alpha)
+struct MColorKeyOptions
+{
+    int tolerance;    // Largest difference per color channel for a pixel to be keyed out, from 0 (exact match, like SDL_SetSurfaceColorKey) to 255
+    bool premultiply; // Flag to multiply the color channels by alpha, for textures rendered with SDL_BLENDMODE_BLEND_PREMULTIPLIED
+};
+
+// Color key to alpha conversion of 32-bit surfaces in place, with SSE2/AVX2 kernels selected at runtime and a scalar fallback
+// Keyed pixels get an alpha of 0 (and a color of 0 when premultiplied), once at load time, instead of SDL keying the pixels while it converts them
+class MColorKeyConverter
+{
+public:
+    // Kernels that can run a conversion
+    enum Kernel
+    {
+        KERNEL_AUTO,   // Best kernel supported by the CPU
+        KERNEL_SCALAR, // Portable C++, the reference for the others
+        KERNEL_SSE2,   // 4 pixels per iteration
+        KERNEL_AVX2    // 8 pixels per iteration
+    };
+
+private:
+    Kernel kernel; // Kernel used by convert
+
+public:
+    // Constructor to select a kernel (KERNEL_AUTO picks the best one the CPU supports)
+    MColorKeyConverter(const Kernel kernel = KERNEL_AUTO);
+
+    // Function to key out a color of a surface in place: returns false when the surface is not a 32-bit format with an alpha channel (see canConvert)
+    bool convert(SDL_Surface *surface, const SDL_Color key, const MColorKeyOptions &options = {}) const;
+
+    // Function to check if a surface can be converted in place (ARGB8888, ABGR8888, RGBA8888 or BGRA8888): others must be converted to ARGB8888 first
+    static bool canConvert(const SDL_Surface *surface);
+
+    // Function to check if the CPU can run a kernel
+    static bool isSupported(const Kernel kernel);
+
+    // Getter for the converter state inline for efficiency
+    inline const Kernel getKernel() const { return kernel; } // Getter for the kernel in use
+    static const char *getKernelName(const Kernel kernel);   // Getter for the printable name of a kernel
+};
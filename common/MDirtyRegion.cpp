@@ -0,0 +1,91 @@
+#include "MDirtyRegion.hpp"
+
+// ############################################################################################
+// DirtyRegion's constructor initializes the region with the whole surface dirty
+MDirtyRegion::MDirtyRegion(const int width, const int height, const int max_rects)
+    : bounds{0, 0, width, height}, max_rects(max_rects > 0 ? max_rects : 1), frames_presented(0), frames_skipped(0), pixels_presented(0)
+{
+    this->addAll();
+}
+
+// ############################################################################################
+// DirtyRegion's reset function changes the size of the tracked surface
+void MDirtyRegion::reset(const int width, const int height)
+{
+    this->bounds = {0, 0, width, height};
+    this->addAll();
+}
+
+// ############################################################################################
+// DirtyRegion's add function inserts a changed rectangle, merging it with the rectangles it overlaps
+void MDirtyRegion::add(const SDL_Rect &rect)
+{
+    // Only the part inside the surface can change
+    SDL_Rect merged{};
+    if (!SDL_GetRectIntersection(&rect, &this->bounds, &merged))
+    {
+        return;
+    }
+
+    // Merge with every overlapping rectangle: the union may overlap other rectangles, so the scan restarts after each merge
+    for (size_t i = 0; i < this->rects.size();)
+    {
+        if (SDL_HasRectIntersection(&merged, &this->rects[i]))
+        {
+            SDL_GetRectUnion(&merged, &this->rects[i], &merged);
+            this->rects[i] = this->rects.back();
+            this->rects.pop_back();
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    this->rects.push_back(merged);
+
+    // Too many small rectangles cost more to present than their bounding box
+    if ((int)this->rects.size() > this->max_rects)
+    {
+        SDL_Rect box = this->rects[0];
+        for (const SDL_Rect &dirty : this->rects)
+        {
+            SDL_GetRectUnion(&box, &dirty, &box);
+        }
+        this->rects.assign(1, box);
+    }
+}
+
+// ############################################################################################
+// DirtyRegion's addAll function replaces the region with the whole surface
+void MDirtyRegion::addAll()
+{
+    this->rects.assign(1, this->bounds);
+}
+
+// ############################################################################################
+// DirtyRegion's present function updates the changed rectangles of the window, or nothing when the frame is static
+bool MDirtyRegion::present(SDL_Window *window)
+{
+    if (this->rects.empty())
+    {
+        this->frames_skipped++;
+        return true; // Static frame: nothing to copy
+    }
+
+    bool success{true};
+    if (!SDL_UpdateWindowSurfaceRects(window, this->rects.data(), (int)this->rects.size()))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to update window surface rectangles: %s\n", SDL_GetError());
+        success = false;
+    }
+
+    for (const SDL_Rect &dirty : this->rects)
+    {
+        this->pixels_presented += (Uint64)dirty.w * dirty.h;
+    }
+    this->frames_presented++;
+    this->rects.clear();
+    return success;
+}
+// ############################################################################################
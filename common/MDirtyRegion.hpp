@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Set of the rectangles of a surface that changed since the last present, merged so that no two of them overlap
+class MDirtyRegion
+{
+private:
+    std::vector<SDL_Rect> rects; // Changed rectangles, clipped to the surface and without overlaps
+    SDL_Rect bounds;             // Rectangle of the whole surface
+    int max_rects;               // Number of rectangles above which the region collapses into their bounding box
+    Uint64 frames_presented;     // Number of presents that updated at least one rectangle
+    Uint64 frames_skipped;       // Number of presents with nothing to update
+    Uint64 pixels_presented;     // Number of pixels updated by all the presents
+
+public:
+    // Constructor to track a surface of the given size, entirely dirty so that the first frame is drawn
+    MDirtyRegion(const int width, const int height, const int max_rects = 16);
+
+    // Function to track a surface of a new size (window resized), marking all of it dirty
+    void reset(const int width, const int height);
+
+    // Function to mark a rectangle as changed, merging it with the rectangles it overlaps
+    void add(const SDL_Rect &rect);
+
+    // Function to mark the whole surface as changed
+    void addAll();
+
+    // Function to copy the changed rectangles of the window surface to the screen and clear the region
+    bool present(SDL_Window *window);
+
+    // Function to forget the changed rectangles without presenting them
+    inline void clear() { rects.clear(); }
+
+    // Getters for the region and its statistics inline for efficiency
+    inline const std::vector<SDL_Rect> &getRects() const { return rects; }      // Getter for the changed rectangles
+    inline const bool isEmpty() const { return rects.empty(); }                 // Getter for the "nothing changed" state
+    inline const Uint64 getFramesPresented() const { return frames_presented; } // Getter for the number of presents with changes
+    inline const Uint64 getFramesSkipped() const { return frames_skipped; }     // Getter for the number of presents without changes
+    inline const Uint64 getPixelsPresented() const { return pixels_presented; } // Getter for the number of pixels presented
+};
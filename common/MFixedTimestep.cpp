@@ -0,0 +1,57 @@
+#include "MFixedTimestep.hpp"
+
+// ############################################################################################
+// FixedTimestep's constructor starts the clock
+MFixedTimestep::MFixedTimestep(const Uint64 step_ns, const int max_steps, const Clock clock)
+    : clock(clock), step_ns(step_ns > 0 ? step_ns : DEFAULT_STEP_NS), max_steps(max_steps > 0 ? max_steps : 1), previous_ns(0), accumulator_ns(0), steps(0), frames(0), dropped_ns(0), dropped_frames(0)
+{
+    this->reset();
+}
+
+// ############################################################################################
+// FixedTimestep's reset function forgets the time elapsed since the last advance
+void MFixedTimestep::reset()
+{
+    this->previous_ns = this->clock();
+    this->accumulator_ns = 0;
+}
+
+// ############################################################################################
+// FixedTimestep's advance function converts the elapsed time into whole steps
+int MFixedTimestep::advance()
+{
+    const Uint64 now_ns = this->clock();
+    this->accumulator_ns += now_ns > this->previous_ns ? now_ns - this->previous_ns : 0; // A clock going back adds nothing
+    this->previous_ns = now_ns;
+    this->frames++;
+
+    // Whole steps in the accumulator, the remainder is kept for the next frame
+    Uint64 step_count = this->accumulator_ns / this->step_ns;
+    this->accumulator_ns -= step_count * this->step_ns;
+
+    // Spiral-of-death protection: when the steps cannot keep up (stall, debugger, slow machine), drop the time beyond max_steps
+    if (step_count > (Uint64)this->max_steps)
+    {
+        this->dropped_ns += (step_count - this->max_steps) * this->step_ns;
+        this->dropped_frames++;
+        step_count = this->max_steps;
+    }
+
+    this->steps += step_count;
+    return (int)step_count;
+}
+
+// ############################################################################################
+// FixedTimestep's getAlpha function returns how far the current time is between the last step and the next one
+float MFixedTimestep::getAlpha() const
+{
+    return (float)((double)this->accumulator_ns / (double)this->step_ns);
+}
+
+// ############################################################################################
+// FixedTimestep's getTimeToNextStep function returns the time the accumulator still needs to hold a step
+Uint64 MFixedTimestep::getTimeToNextStep() const
+{
+    return this->step_ns - this->accumulator_ns;
+}
+// ############################################################################################
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Fixed-timestep game loop: the time elapsed between two frames is added to an accumulator, and the simulation advances in steps of
+// a constant duration while the accumulator holds one, so its result does not depend on the frame rate; the frame then renders the
+// state interpolated between the last two steps by the fraction of a step left in the accumulator (getAlpha), so that the motion is
+// smooth at any refresh rate
+// Spiral-of-death protection: a frame runs at most max_steps steps, the time beyond them is dropped (the simulation slows down instead
+// of needing ever more steps to catch up after a stall)
+// The time comes from a clock function, SDL_GetTicksNS by default: a fake clock makes the loop deterministic in tests
+class MFixedTimestep
+{
+public:
+    typedef Uint64(SDLCALL *Clock)(void); // Function returning the current time in nanoseconds
+
+    static constexpr Uint64 DEFAULT_STEP_NS{SDL_NS_PER_SECOND / 60}; // Duration of a simulation step (60 updates per second)
+    static constexpr int DEFAULT_MAX_STEPS{5};                        // Most steps run by one frame
+
+private:
+    Clock clock;           // Source of the current time
+    Uint64 step_ns;        // Duration of a simulation step
+    int max_steps;         // Most steps run by one frame
+    Uint64 previous_ns;    // Time of the last advance
+    Uint64 accumulator_ns; // Elapsed time not yet simulated, less than a step after advance
+    Uint64 steps;          // Number of steps run
+    Uint64 frames;         // Number of advance calls
+    Uint64 dropped_ns;     // Time dropped by the spiral-of-death protection
+    Uint64 dropped_frames; // Number of frames that dropped time
+
+public:
+    // Constructor to initialize the loop with the clock started
+    MFixedTimestep(const Uint64 step_ns = DEFAULT_STEP_NS, const int max_steps = DEFAULT_MAX_STEPS, const Clock clock = SDL_GetTicksNS);
+
+    // Function to restart the clock with an empty accumulator, e.g. when the simulation resumes after the loop was idle or paused
+    void reset();
+
+    // Function to add the time elapsed since the last call to the accumulator: returns the number of steps to run this frame (0 to max_steps)
+    int advance();
+
+    // Function to get the fraction of a step left in the accumulator, in [0, 1): the weight of the last step for the interpolation
+    float getAlpha() const;
+
+    // Function to get the time until the next step is due, from the last advance (e.g. to sleep when nothing else has to be rendered)
+    Uint64 getTimeToNextStep() const;
+
+    // Function to interpolate a value (position, angle, ...) between its state at the previous step and at the last step
+    static inline float interpolate(const float previous, const float current, const float alpha) { return previous + (current - previous) * alpha; }
+
+    // Getters for the loop settings and statistics inline for efficiency
+    inline const Uint64 getStepNS() const { return step_ns; }                                // Getter for the duration of a step
+    inline const float getStepSeconds() const { return (float)step_ns / SDL_NS_PER_SECOND; } // Getter for the duration of a step in seconds
+    inline const Uint64 getSteps() const { return steps; }                                   // Getter for the number of steps run
+    inline const Uint64 getFrames() const { return frames; }                                 // Getter for the number of frames
+    inline const Uint64 getDroppedNS() const { return dropped_ns; }                          // Getter for the time dropped by the protection
+    inline const Uint64 getDroppedFrames() const { return dropped_frames; }                  // Getter for the number of frames that dropped time
+};
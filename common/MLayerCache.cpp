@@ -0,0 +1,163 @@
+#include "MLayerCache.hpp"
+
+// ############################################################################################
+// LayerCache's constructor initializes an empty cache with no layer being rendered
+MLayerCache::MLayerCache() : active_layer(-1), previous_target(nullptr), renders(0), replays(0)
+{
+}
+
+// ############################################################################################
+// LayerCache's destructor destroys the layer textures
+MLayerCache::~MLayerCache()
+{
+    this->clear();
+}
+
+// ############################################################################################
+// LayerCache's beginLayer function redirects the draws into the layer texture when its content is out of date
+bool MLayerCache::beginLayer(SDL_Renderer *renderer, const int layer, const Uint64 key, const int width, const int height, const SDL_Color &clear_color)
+{
+    if (this->active_layer >= 0 || layer < 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to begin layer %d: invalid layer or layer %d not ended\n", layer, this->active_layer);
+        return false;
+    }
+    if ((size_t)layer >= this->layers.size())
+    {
+        this->layers.resize(layer + 1, Layer{nullptr, 0, 0, 0, false});
+    }
+    Layer &entry = this->layers[layer];
+
+    // A new size needs a new texture (e.g. the window was resized)
+    if (entry.texture != nullptr && (entry.width != width || entry.height != height))
+    {
+        SDL_DestroyTexture(entry.texture);
+        entry.texture = nullptr;
+        entry.valid = false;
+    }
+
+    // The cached content is still valid: the layer is only replayed
+    if (entry.texture != nullptr && entry.valid && entry.key == key)
+    {
+        return false;
+    }
+
+    // Create the target texture on first use, kept from then on so that a new key does not allocate
+    if (entry.texture == nullptr)
+    {
+        if (entry.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height); entry.texture == nullptr)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create layer texture: %s\n", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(entry.texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        entry.width = width;
+        entry.height = height;
+    }
+
+    // Draw into the layer texture until endLayer
+    this->previous_target = SDL_GetRenderTarget(renderer);
+    if (!SDL_SetRenderTarget(renderer, entry.texture))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to set layer render target: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Clear the layer, then restore the draw color so that the state cached by a render queue stays valid
+    Uint8 r{0}, g{0}, b{0}, a{0};
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, clear_color.r, clear_color.g, clear_color.b, clear_color.a);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+    entry.key = key;
+    entry.valid = true;
+    this->active_layer = layer;
+    this->renders++;
+    return true;
+}
+
+// ############################################################################################
+// LayerCache's endLayer function restores the render target that was active before beginLayer
+bool MLayerCache::endLayer(SDL_Renderer *renderer)
+{
+    if (this->active_layer < 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to end layer: no layer begun\n");
+        return false;
+    }
+    this->active_layer = -1;
+    const bool restored = SDL_SetRenderTarget(renderer, this->previous_target);
+    this->previous_target = nullptr;
+    if (!restored)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to restore render target: %s\n", SDL_GetError());
+    }
+    return restored;
+}
+
+// ############################################################################################
+// LayerCache's add function records a single draw of the layer texture
+void MLayerCache::add(MRenderQueue &queue, const int layer, const float x, const float y, const int queue_layer)
+{
+    SDL_Texture *texture = this->getTexture(layer);
+    if (texture == nullptr)
+    {
+        return; // Nothing rendered yet (e.g. the texture creation failed)
+    }
+    const Layer &entry = this->layers[layer];
+    queue.add(texture, nullptr, SDL_FRect{x, y, (float)entry.width, (float)entry.height}, queue_layer);
+    this->replays++;
+}
+
+// ############################################################################################
+// LayerCache's invalidate function marks the content of a layer as out of date
+void MLayerCache::invalidate(const int layer)
+{
+    if (layer >= 0 && (size_t)layer < this->layers.size())
+    {
+        this->layers[layer].valid = false;
+    }
+}
+
+// ############################################################################################
+// LayerCache's invalidateAll function marks the content of every layer as out of date
+void MLayerCache::invalidateAll()
+{
+    for (Layer &entry : this->layers)
+    {
+        entry.valid = false;
+    }
+}
+
+// ############################################################################################
+// LayerCache's handleEvent function invalidates the layers when the renderer lost the content of its target textures
+void MLayerCache::handleEvent(const SDL_Event &event)
+{
+    if (event.type == SDL_EVENT_RENDER_TARGETS_RESET || event.type == SDL_EVENT_RENDER_DEVICE_RESET)
+    {
+        this->invalidateAll();
+    }
+}
+
+// ############################################################################################
+// LayerCache's clear function destroys the layer textures
+void MLayerCache::clear()
+{
+    for (Layer &entry : this->layers)
+    {
+        if (entry.texture != nullptr)
+        {
+            SDL_DestroyTexture(entry.texture);
+        }
+    }
+    this->layers.clear();
+}
+
+// ############################################################################################
+// LayerCache's getTexture function returns the texture of a layer
+SDL_Texture *MLayerCache::getTexture(const int layer) const
+{
+    return layer >= 0 && (size_t)layer < this->layers.size() ? this->layers[layer].texture : nullptr;
+}
+// ############################################################################################
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MRenderQueue.hpp"
+#include <vector>
+
+// Cache of composited layers: the draws of a static group are rendered once into a target texture (SDL_TEXTUREACCESS_TARGET),
+// then the layer is replayed with a single draw until its invalidation key changes (e.g. a flag or a counter of the scene state)
+// Static backgrounds and dynamic sprites are separated by caching the former and drawing the latter on top of the replayed layer
+// The layer texture holds premultiplied colors (draws blended over a transparent clear), so it is drawn with SDL_BLENDMODE_BLEND_PREMULTIPLIED
+class MLayerCache
+{
+private:
+    // Structure to hold one cached layer
+    struct Layer
+    {
+        SDL_Texture *texture; // Target texture holding the composited draws (nullptr until the first render)
+        int width;            // Width of the texture
+        int height;           // Height of the texture
+        Uint64 key;           // Invalidation key the content was rendered with
+        bool valid;           // Flag to indicate that the texture content matches the key
+    };
+
+    std::vector<Layer> layers;    // Layers indexed by their identifier
+    int active_layer;             // Layer being rendered between beginLayer and endLayer (-1 = none)
+    SDL_Texture *previous_target; // Render target to restore at endLayer
+    Uint64 renders;               // Number of times a layer was rendered into its texture
+    Uint64 replays;               // Number of times a layer was replayed from its texture
+
+public:
+    // Constructor to initialize an empty cache
+    MLayerCache();
+
+    // Destructor to destroy the layer textures
+    ~MLayerCache();
+
+    // The cache owns its textures: no copies
+    MLayerCache(const MLayerCache &) = delete;
+    MLayerCache &operator=(const MLayerCache &) = delete;
+
+    // Function to start a layer: returns true when it must be rendered (first use, new key or new size), the draws then go into the layer
+    // texture, cleared with clear_color, until endLayer; returns false when the cached content is still valid (do not call endLayer)
+    bool beginLayer(SDL_Renderer *renderer, const int layer, const Uint64 key, const int width, const int height, const SDL_Color &clear_color = {0, 0, 0, 0});
+
+    // Function to finish the layer started by beginLayer and restore the previous render target
+    bool endLayer(SDL_Renderer *renderer);
+
+    // Function to record the replay of a layer into a render queue: one draw of the layer texture at a position
+    void add(MRenderQueue &queue, const int layer, const float x, const float y, const int queue_layer = 0);
+
+    // Function to force a layer to be rendered again on its next beginLayer
+    void invalidate(const int layer);
+
+    // Function to force every layer to be rendered again (the content of target textures is lost on a render device reset)
+    void invalidateAll();
+
+    // Function to invalidate the layers for events that lose the content of target textures
+    void handleEvent(const SDL_Event &event);
+
+    // Function to destroy the layer textures
+    void clear();
+
+    // Getters for the cache statistics inline for efficiency
+    inline const Uint64 getRenders() const { return renders; } // Getter for the number of layer renders
+    inline const Uint64 getReplays() const { return replays; } // Getter for the number of layer replays
+    SDL_Texture *getTexture(const int layer) const;            // Getter for the texture of a layer (nullptr if never rendered)
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+
+// Log levels, from the most to the least verbose
+#define MLOG_LEVEL_DEBUG 0 // Detailed traces, e.g. one line per texture operation
+#define MLOG_LEVEL_INFO 1  // Progress messages, e.g. one line per loaded file
+#define MLOG_LEVEL_WARN 2  // Unexpected but recoverable situations
+#define MLOG_LEVEL_ERROR 3 // Failures
+#define MLOG_LEVEL_NONE 4  // Nothing is logged
+
+// Compile-time threshold: calls below it are removed entirely, including the evaluation of their arguments
+// Override it with -DMLOG_LEVEL=MLOG_LEVEL_..., by default release builds (NDEBUG) drop debug and info messages
+#ifndef MLOG_LEVEL
+#ifdef NDEBUG
+#define MLOG_LEVEL MLOG_LEVEL_WARN
+#else
+#define MLOG_LEVEL MLOG_LEVEL_DEBUG
+#endif
+#endif
+
+// Runtime threshold of the categories below SDL_LOG_CATEGORY_CUSTOM, cached so that a disabled call costs one compare
+// (SDL_LOG_PRIORITY_INVALID means "not read from SDL yet")
+// The cache does not see SDL's own setters: change the priorities with MLogSetPriority and MLogResetPriorities only, as a direct
+// SDL_SetLogPriority, SDL_SetLogPriorities or SDL_ResetLogPriorities call leaves the macros filtering with the old thresholds
+inline std::atomic<SDL_LogPriority> mlog_priorities[SDL_LOG_CATEGORY_CUSTOM]{};
+
+// Function to change the runtime threshold of a category (kept in sync with SDL's own priority)
+inline void MLogSetPriority(const int category, const SDL_LogPriority priority)
+{
+    SDL_SetLogPriority(category, priority);
+    if (category >= 0 && category < SDL_LOG_CATEGORY_CUSTOM)
+    {
+        mlog_priorities[category].store(priority, std::memory_order_relaxed);
+    }
+}
+
+// Function to reset every category to SDL's default priority, read again from SDL on the next call
+inline void MLogResetPriorities()
+{
+    SDL_ResetLogPriorities();
+    for (std::atomic<SDL_LogPriority> &category_priority : mlog_priorities)
+    {
+        category_priority.store(SDL_LOG_PRIORITY_INVALID, std::memory_order_relaxed);
+    }
+}
+
+// Function to check the runtime threshold before any argument is formatted
+inline bool MLogEnabled(const int category, const SDL_LogPriority priority)
+{
+    if (category < 0 || category >= SDL_LOG_CATEGORY_CUSTOM)
+    {
+        return priority >= SDL_GetLogPriority(category); // Custom categories are looked up in SDL
+    }
+
+    // Read the priority from SDL the first time the category is used
+    SDL_LogPriority category_priority = mlog_priorities[category].load(std::memory_order_relaxed);
+    if (category_priority == SDL_LOG_PRIORITY_INVALID)
+    {
+        category_priority = SDL_GetLogPriority(category);
+        mlog_priorities[category].store(category_priority, std::memory_order_relaxed);
+    }
+    return priority >= category_priority;
+}
+
+// Macro shared by the level macros: the level is checked at compile time, the category at runtime
+#define MLOG_MESSAGE(level, priority, category, ...)                 \
+    do                                                               \
+    {                                                                \
+        if constexpr ((level) >= MLOG_LEVEL)                         \
+        {                                                            \
+            if (MLogEnabled((category), (priority)))                 \
+            {                                                        \
+                SDL_LogMessage((category), (priority), __VA_ARGS__); \
+            }                                                        \
+        }                                                            \
+    } while (0)
+
+// Compile-time check of the gating: a message below MLOG_LEVEL must be discarded, not compiled behind a runtime test. The argument is
+// ill-formed for T = int, so the function only instantiates if the message (runtime check, SDL call and arguments) is dropped entirely
+template <typename T>
+constexpr bool MLogDisabledLevelIsEmpty()
+{
+    MLOG_MESSAGE(MLOG_LEVEL - 1, SDL_LOG_PRIORITY_DEBUG, SDL_LOG_CATEGORY_APPLICATION, "%d", T::value_never_compiled);
+    return true;
+}
+static_assert(MLogDisabledLevelIsEmpty<int>(), "MLOG_MESSAGE must compile the levels below MLOG_LEVEL to nothing");
+
+// Macros to log at each level, with the same arguments as SDL_LogInfo and friends
+#define MLOG_DEBUG(category, ...) MLOG_MESSAGE(MLOG_LEVEL_DEBUG, SDL_LOG_PRIORITY_DEBUG, category, __VA_ARGS__)
+#define MLOG_INFO(category, ...) MLOG_MESSAGE(MLOG_LEVEL_INFO, SDL_LOG_PRIORITY_INFO, category, __VA_ARGS__)
+#define MLOG_WARN(category, ...) MLOG_MESSAGE(MLOG_LEVEL_WARN, SDL_LOG_PRIORITY_WARN, category, __VA_ARGS__)
+#define MLOG_ERROR(category, ...) MLOG_MESSAGE(MLOG_LEVEL_ERROR, SDL_LOG_PRIORITY_ERROR, category, __VA_ARGS__)
@@ -0,0 +1,234 @@
+#include "MProfiler.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Constants for the on-screen overlay
+constexpr int OVERLAY_ZONES{10};       // Number of zones of the last frame listed under the frame times
+constexpr int OVERLAY_LINE_LENGTH{64}; // Longest line of the overlay, in characters
+constexpr float OVERLAY_LINE_HEIGHT{SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2.f};
+constexpr float OVERLAY_PADDING{4.f};
+
+// ############################################################################################
+// Profiler's start function opens the first frame, then publishes the recording thread: the other threads only read thread_id
+void MProfiler::start()
+{
+    if constexpr (MPROFILER_ENABLED != 0)
+    {
+        if (thread_id.load(std::memory_order_relaxed) != 0)
+        {
+            return; // Already started
+        }
+        origin_ns = SDL_GetTicksNS();
+        frames[0].open_ns = origin_ns;
+        frames[0].start_ns = origin_ns;
+        thread_id.store(SDL_GetCurrentThreadID(), std::memory_order_release);
+    }
+}
+
+// ############################################################################################
+// Profiler's beginZone function adds a zone to the current frame, or merges it with the previous one if it is the same
+int MProfiler::beginZone(const char *name, const Uint64 start_ns)
+{
+    // The thread is checked before the frame is touched: the frames belong to the render thread, and nothing is recorded before start
+    if (SDL_GetCurrentThreadID() != thread_id.load(std::memory_order_acquire))
+    {
+        return -1; // Only the render thread is profiled
+    }
+    Frame &frame = getCurrentFrame();
+
+    // A zone called in a loop (e.g. one draw per sprite, or the event polling of an idle loop) is kept as one zone with a call count
+    const int zone_depth = depth++;
+    if (frame.zone_count > 0)
+    {
+        Zone &last = frame.zones[frame.zone_count - 1];
+        if (last.name == name && last.depth == zone_depth)
+        {
+            last.calls++;
+            return frame.zone_count - 1;
+        }
+    }
+
+    // A full frame keeps its zones: the new one only counts as dropped, its slot past the end still tracks the nesting
+    if (frame.zone_count == MAX_ZONES)
+    {
+        dropped_zones++;
+        return MAX_ZONES;
+    }
+    frame.zones[frame.zone_count] = Zone{name, start_ns, 0, 1, zone_depth};
+    return frame.zone_count++;
+}
+
+// ############################################################################################
+// Profiler's endZone function adds the time of the call to its zone
+void MProfiler::endZone(const int slot, const Uint64 frame, const Uint64 start_ns)
+{
+    if (slot < 0)
+    {
+        return; // Not recorded
+    }
+    depth = depth > 0 ? depth - 1 : 0;
+    if (slot >= MAX_ZONES || frame_count - frame >= FRAME_HISTORY)
+    {
+        return; // Dropped, or its frame already left the ring buffer
+    }
+
+    // A zone that outlives its frame (e.g. endFrame called inside it) is still closed in the frame it started in
+    frames[frame % FRAME_HISTORY].zones[slot].duration_ns += SDL_GetTicksNS() - start_ns;
+}
+
+// ############################################################################################
+// Profiler's beginFrame function restarts the frame time, so that the idle loop iterations before a frame are not counted
+void MProfiler::beginFrame()
+{
+    if constexpr (MPROFILER_ENABLED != 0)
+    {
+        start();
+        getCurrentFrame().start_ns = SDL_GetTicksNS();
+    }
+}
+
+// ############################################################################################
+// Profiler's endFrame function closes the current frame and opens the next slot of the ring buffer
+void MProfiler::endFrame()
+{
+    if constexpr (MPROFILER_ENABLED != 0)
+    {
+        start();
+        Frame &ended = getCurrentFrame();
+        ended.end_ns = SDL_GetTicksNS();
+        frame_count++;
+
+        Frame &next = frames[frame_count % FRAME_HISTORY];
+        next.open_ns = ended.end_ns;
+        next.start_ns = ended.end_ns;
+        next.end_ns = 0;
+        next.zone_count = 0;
+    }
+}
+
+// ############################################################################################
+// Profiler's getFrameTimePercentile function sorts the frame times kept just enough to pick the percentile
+double MProfiler::getFrameTimePercentile(const double percentile)
+{
+    const int count = (int)SDL_min(frame_count, (Uint64)FRAME_HISTORY - 1);
+    if (count == 0)
+    {
+        return 0.0; // No frame ended yet
+    }
+
+    Uint64 durations[FRAME_HISTORY];
+    for (int age = 0; age < count; age++)
+    {
+        const Frame &frame = getEndedFrame(age);
+        durations[age] = frame.end_ns - frame.start_ns;
+    }
+    const int rank = (int)(SDL_max(0.0, SDL_min(percentile, 100.0)) / 100.0 * (count - 1) + 0.5);
+    std::nth_element(durations, durations + rank, durations + count);
+    return (double)durations[rank] / SDL_NS_PER_MS;
+}
+
+// ############################################################################################
+// Profiler's getZones function returns the zones of a frame still in the ring buffer
+const MProfiler::Zone *MProfiler::getZones(const Uint64 age, int &count)
+{
+    count = 0;
+    if (age >= SDL_min(frame_count, (Uint64)FRAME_HISTORY - 1))
+    {
+        return nullptr; // Not ended yet, or already overwritten
+    }
+    const Frame &frame = getEndedFrame(age);
+    count = frame.zone_count;
+    return frame.zones;
+}
+
+// ############################################################################################
+// Profiler's exportTrace function writes every frame kept and its zones as complete events ("ph":"X"), oldest first
+bool MProfiler::exportTrace(const char *file_path)
+{
+    SDL_IOStream *file = SDL_IOFromFile(file_path, "w");
+    if (file == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to open trace file %s: %s\n", file_path, SDL_GetError());
+        return false;
+    }
+
+    // Timestamps are in microseconds since the first record
+    SDL_IOprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    const Uint64 count = SDL_min(frame_count, (Uint64)FRAME_HISTORY - 1);
+    const char *separator = "";
+    for (Uint64 age = count; age-- > 0;)
+    {
+        const Frame &frame = getEndedFrame(age);
+        SDL_IOprintf(file, "%s{\"name\":\"frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+                     separator, (frame.start_ns - origin_ns) / 1000.0, (frame.end_ns - frame.start_ns) / 1000.0, (unsigned long long)(frame_count - 1 - age));
+        separator = ",\n";
+        for (int i = 0; i < frame.zone_count; i++)
+        {
+            const Zone &zone = frame.zones[i];
+            SDL_IOprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"calls\":%u}}",
+                         zone.name, (zone.start_ns - origin_ns) / 1000.0, zone.duration_ns / 1000.0, (unsigned int)zone.calls);
+        }
+    }
+    SDL_IOprintf(file, "\n]}\n");
+
+    if (!SDL_CloseIO(file))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to write trace file %s: %s\n", file_path, SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+// ############################################################################################
+// Profiler's renderOverlay function draws white text on a translucent box, then restores the draw state of the renderer
+void MProfiler::renderOverlay(SDL_Renderer *renderer, const float x, const float y)
+{
+    if constexpr (MPROFILER_ENABLED == 0)
+    {
+        return; // Nothing recorded
+    }
+
+    // Format the lines first to size the box
+    char lines[2 + OVERLAY_ZONES][OVERLAY_LINE_LENGTH]{};
+    int line_count{2};
+    SDL_snprintf(lines[0], OVERLAY_LINE_LENGTH, "frame p50 %.2f ms  p99 %.2f ms", getFrameTimePercentile(50.0), getFrameTimePercentile(99.0));
+    if (frame_count == 0)
+    {
+        SDL_snprintf(lines[1], OVERLAY_LINE_LENGTH, "no frame yet");
+    }
+    else
+    {
+        const Frame &last = getEndedFrame(0);
+        SDL_snprintf(lines[1], OVERLAY_LINE_LENGTH, "last %.2f ms, frame %llu", (double)(last.end_ns - last.start_ns) / SDL_NS_PER_MS, (unsigned long long)frame_count);
+        for (int i = 0; i < last.zone_count && line_count < 2 + OVERLAY_ZONES; i++)
+        {
+            const Zone &zone = last.zones[i];
+            SDL_snprintf(lines[line_count++], OVERLAY_LINE_LENGTH, "%*s%s %.2f ms x%u", zone.depth * 2, "", zone.name, (double)zone.duration_ns / SDL_NS_PER_MS, (unsigned int)zone.calls);
+        }
+    }
+    size_t longest{0};
+    for (int i = 0; i < line_count; i++)
+    {
+        longest = SDL_max(longest, std::strlen(lines[i]));
+    }
+
+    // Save the draw state: MRenderQueue skips setting a draw color it believes is already set
+    Uint8 r{0}, g{0}, b{0}, a{0};
+    SDL_BlendMode blend_mode{SDL_BLENDMODE_NONE};
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blend_mode);
+
+    const SDL_FRect box{x, y, longest * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2 * OVERLAY_PADDING, line_count * OVERLAY_LINE_HEIGHT + 2 * OVERLAY_PADDING};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xB0);
+    SDL_RenderFillRect(renderer, &box);
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    for (int i = 0; i < line_count; i++)
+    {
+        SDL_RenderDebugText(renderer, x + OVERLAY_PADDING, y + OVERLAY_PADDING + i * OVERLAY_LINE_HEIGHT, lines[i]);
+    }
+
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+}
+// ############################################################################################
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+
+// Compile-time switch: when 0, every zone and frame call is removed and the profiler records nothing
+// Override it with -DMPROFILER_ENABLED=0 or 1, by default release builds (NDEBUG) are not profiled
+#ifndef MPROFILER_ENABLED
+#ifdef NDEBUG
+#define MPROFILER_ENABLED 0
+#else
+#define MPROFILER_ENABLED 1
+#endif
+#endif
+
+// Frame profiler of the render loop: named zones are timed into a ring buffer of the last frames, which can be
+// exported as a Chrome trace (chrome://tracing or ui.perfetto.dev) and summarized on screen with the rolling p50/p99 frame time
+// Zones are only recorded on the thread that started the profiler (start, or the first beginFrame or endFrame: the render thread);
+// the other threads (e.g. the MAsyncLoader workers) may open zones, which are ignored; names must be string literals
+class MProfiler
+{
+public:
+    static constexpr int FRAME_HISTORY{240}; // Number of frames kept, the one being recorded included
+    static constexpr int MAX_ZONES{64};      // Number of zones kept per frame, the next ones are dropped
+
+    // Structure to hold one zone of a frame: consecutive calls of the same zone at the same depth are merged
+    struct Zone
+    {
+        const char *name;   // Name of the zone (string literal)
+        Uint64 start_ns;    // Start of the first call
+        Uint64 duration_ns; // Time spent in every call
+        Uint32 calls;       // Number of merged calls
+        int depth;          // Nesting depth, 0 for the outermost zones
+    };
+
+private:
+    // Structure to hold one frame of the ring buffer
+    struct Frame
+    {
+        Uint64 open_ns;        // Time the previous frame ended: zones recorded since then belong to this frame
+        Uint64 start_ns;       // Time the frame work started (beginFrame), open_ns if it was not called
+        Uint64 end_ns;         // Time the frame ended (endFrame)
+        int zone_count;        // Number of zones recorded
+        Zone zones[MAX_ZONES]; // Zones in the order they started
+    };
+
+    inline static Frame frames[FRAME_HISTORY]{};          // Ring buffer of the last frames, indexed by frame number
+    inline static Uint64 frame_count{0};                  // Number of frames ended, also the number of the frame being recorded
+    inline static Uint64 dropped_zones{0};                // Number of zones dropped because their frame was full or had ended
+    inline static Uint64 origin_ns{0};                    // Time the profiler started, the zero of the exported trace
+    inline static std::atomic<SDL_ThreadID> thread_id{0}; // Thread that records zones, set by start (0 until then): read by every thread
+    inline static int depth{0};                           // Number of zones open on the recording thread
+
+    // Function to get the frame being recorded (on the recording thread, once started)
+    static inline Frame &getCurrentFrame() { return frames[frame_count % FRAME_HISTORY]; }
+
+    // Function to get a frame that ended, 0 being the most recent one
+    static inline const Frame &getEndedFrame(const Uint64 age) { return frames[(frame_count - 1 - age) % FRAME_HISTORY]; }
+
+public:
+    // Function to start the profiler on the calling thread, the render thread: the first frame opens now, and only this thread records zones
+    // (beginFrame and endFrame start it if it was not started, the zones opened before are not recorded)
+    static void start();
+
+    // Function to open a zone: returns its slot in the current frame, -1 if it is not recorded
+    static int beginZone(const char *name, const Uint64 start_ns);
+
+    // Function to close a zone opened during the given frame
+    static void endZone(const int slot, const Uint64 frame, const Uint64 start_ns);
+
+    // Function to mark the start of the frame work (may be called again, e.g. every loop iteration until a frame is presented)
+    static void beginFrame();
+
+    // Function to end the frame after it is presented, the zones recorded next belong to the next frame
+    static void endFrame();
+
+    // Function to get a percentile (0 to 100) of the frame time of the frames kept, in milliseconds
+    static double getFrameTimePercentile(const double percentile);
+
+    // Function to write the frames kept as a Chrome trace JSON file
+    static bool exportTrace(const char *file_path);
+
+    // Function to get the zones of a frame that ended, 0 being the most recent one (nullptr if it is not kept)
+    static const Zone *getZones(const Uint64 age, int &count);
+
+    // Function to draw the rolling p50/p99 frame time and the zones of the last frame with SDL_RenderDebugText
+    static void renderOverlay(SDL_Renderer *renderer, const float x, const float y);
+
+    // Getters for the profiler state inline for efficiency
+    inline static const Uint64 getFrameCount() { return frame_count; }     // Getter for the number of frames ended
+    inline static const Uint64 getDroppedZones() { return dropped_zones; } // Getter for the number of zones dropped
+};
+
+// Timer that records a zone from its construction to the end of its scope (compiled out when the profiler is disabled)
+class MProfileZone
+{
+private:
+    int slot;        // Slot of the zone in its frame, -1 if it is not recorded
+    Uint64 frame;    // Frame the zone was opened in
+    Uint64 start_ns; // Time the zone was opened
+
+public:
+    // Constructor to open the zone
+    explicit MProfileZone(const char *name) : slot(-1), frame(0), start_ns(0)
+    {
+        if constexpr (MPROFILER_ENABLED != 0)
+        {
+            this->start_ns = SDL_GetTicksNS();
+            this->slot = MProfiler::beginZone(name, this->start_ns);
+            this->frame = this->slot >= 0 ? MProfiler::getFrameCount() : 0; // Read on the render thread only: the other threads get -1 first
+        }
+    }
+
+    // Destructor to close the zone
+    ~MProfileZone()
+    {
+        if constexpr (MPROFILER_ENABLED != 0)
+        {
+            MProfiler::endZone(this->slot, this->frame, this->start_ns);
+        }
+    }
+
+    // A zone is tied to its scope: no copies
+    MProfileZone(const MProfileZone &) = delete;
+    MProfileZone &operator=(const MProfileZone &) = delete;
+};
+
+// Macro to time the rest of the enclosing scope as a zone, e.g. MPROFILE_ZONE("present");
+#define MPROFILE_CONCAT_INNER(a, b) a##b
+#define MPROFILE_CONCAT(a, b) MPROFILE_CONCAT_INNER(a, b)
+#if MPROFILER_ENABLED
+#define MPROFILE_ZONE(name) MProfileZone MPROFILE_CONCAT(mprofile_zone_, __LINE__)(name)
+#else
+#define MPROFILE_ZONE(name) \
+    do                      \
+    {                       \
+    } while (0)
+#endif
@@ -0,0 +1,287 @@
+#include "MQuadGenerator.hpp"
+#include <cmath>
+
+// The SIMD kernels are only compiled for x86 targets, other targets use the scalar kernel
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MQUAD_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MQUAD_TARGET_SSE2 __attribute__((target("sse2")))
+#define MQUAD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MQUAD_TARGET_SSE2
+#define MQUAD_TARGET_AVX2
+#endif
+#endif
+
+// Constants of the polynomial sine and cosine: the angle is reduced to [-45, 45] degrees, where Taylor series converge quickly
+constexpr float QUARTER_TURNS_PER_DEGREE{1.f / 90.f};
+constexpr float RADIANS_PER_DEGREE{SDL_PI_F / 180.f};
+constexpr float SIN_C3{-1.f / 6.f};
+constexpr float SIN_C5{1.f / 120.f};
+constexpr float SIN_C7{-1.f / 5040.f};
+constexpr float COS_C2{-1.f / 2.f};
+constexpr float COS_C4{1.f / 24.f};
+constexpr float COS_C6{-1.f / 720.f};
+constexpr float COS_C8{1.f / 40320.f};
+
+// Function to write the four vertices of one quad from its sine and cosine
+static inline void writeQuad(const MQuadArrays &quads, const int i, const float sin_a, const float cos_a, SDL_Vertex *vertex)
+{
+    // Half extents of the rotated quad along its own x and y axes
+    const float ax = quads.half_w[i] * cos_a;
+    const float ay = quads.half_w[i] * sin_a;
+    const float bx = -quads.half_h[i] * sin_a;
+    const float by = quads.half_h[i] * cos_a;
+    const float cx = quads.center_x[i];
+    const float cy = quads.center_y[i];
+    const SDL_FPoint min = quads.tex_min[i];
+    const SDL_FPoint max = quads.tex_max[i];
+    const SDL_FColor white{1.f, 1.f, 1.f, 1.f};
+
+    vertex[0] = SDL_Vertex{{cx - ax - bx, cy - ay - by}, white, {min.x, min.y}};
+    vertex[1] = SDL_Vertex{{cx + ax - bx, cy + ay - by}, white, {max.x, min.y}};
+    vertex[2] = SDL_Vertex{{cx + ax + bx, cy + ay + by}, white, {max.x, max.y}};
+    vertex[3] = SDL_Vertex{{cx - ax + bx, cy - ay + by}, white, {min.x, max.y}};
+}
+
+// Function to compute sine and cosine of an angle in degrees with the polynomial of the SIMD kernels (used for their last quads)
+static inline void sinCosPolynomial(const float degree, float &sin_a, float &cos_a)
+{
+    // Quarter turn count and remainder in [-45, 45] degrees
+    const int quarter = (int)std::lrint(degree * QUARTER_TURNS_PER_DEGREE);
+    const float x = (degree - (float)quarter * 90.f) * RADIANS_PER_DEGREE;
+    const float x2 = x * x;
+    const float s = x + x * x2 * (SIN_C3 + x2 * (SIN_C5 + x2 * SIN_C7));
+    const float c = 1.f + x2 * (COS_C2 + x2 * (COS_C4 + x2 * (COS_C6 + x2 * COS_C8)));
+
+    // Each quarter turn swaps sine and cosine and changes the sign of one of them
+    const bool swap = (quarter & 1) != 0;
+    sin_a = swap ? c : s;
+    cos_a = swap ? s : c;
+    sin_a = (quarter & 2) ? -sin_a : sin_a;
+    cos_a = ((quarter + 1) & 2) ? -cos_a : cos_a;
+}
+
+// Function to generate the quads with the C library sine and cosine (scalar kernel)
+static void generateScalar(const MQuadArrays &quads, const int first, const int count, SDL_Vertex *vertices)
+{
+    for (int i = first; i < count; i++)
+    {
+        const float radians = quads.degree[i] * RADIANS_PER_DEGREE;
+        writeQuad(quads, i, std::sin(radians), std::cos(radians), vertices + (size_t)i * 4);
+    }
+}
+
+// Function to generate the quads left over by a SIMD kernel, with the same polynomial
+static void generateTail(const MQuadArrays &quads, const int first, const int count, SDL_Vertex *vertices)
+{
+    for (int i = first; i < count; i++)
+    {
+        float sin_a{0.f}, cos_a{0.f};
+        sinCosPolynomial(quads.degree[i], sin_a, cos_a);
+        writeQuad(quads, i, sin_a, cos_a, vertices + (size_t)i * 4);
+    }
+}
+
+#ifdef MQUAD_X86
+// Function to compute sine and cosine of 4 angles in degrees (same operations, in the same order, as sinCosPolynomial)
+MQUAD_TARGET_SSE2 static inline void sinCos4(const __m128 degree, __m128 &sin_a, __m128 &cos_a)
+{
+    const __m128i quarter = _mm_cvtps_epi32(_mm_mul_ps(degree, _mm_set1_ps(QUARTER_TURNS_PER_DEGREE))); // Rounded to nearest, like lrint
+    const __m128 x = _mm_mul_ps(_mm_sub_ps(degree, _mm_mul_ps(_mm_cvtepi32_ps(quarter), _mm_set1_ps(90.f))), _mm_set1_ps(RADIANS_PER_DEGREE));
+    const __m128 x2 = _mm_mul_ps(x, x);
+    __m128 s = _mm_add_ps(_mm_set1_ps(SIN_C5), _mm_mul_ps(x2, _mm_set1_ps(SIN_C7)));
+    s = _mm_add_ps(_mm_set1_ps(SIN_C3), _mm_mul_ps(x2, s));
+    s = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), s));
+    __m128 c = _mm_add_ps(_mm_set1_ps(COS_C6), _mm_mul_ps(x2, _mm_set1_ps(COS_C8)));
+    c = _mm_add_ps(_mm_set1_ps(COS_C4), _mm_mul_ps(x2, c));
+    c = _mm_add_ps(_mm_set1_ps(COS_C2), _mm_mul_ps(x2, c));
+    c = _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(x2, c));
+
+    // Swap the odd quarters with a mask, then flip the sign bits of the negative quarters
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quarter, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    const __m128 swapped_sin = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+    const __m128 swapped_cos = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+    const __m128 sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quarter, _mm_set1_epi32(2)), 30));
+    const __m128 cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quarter, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+    sin_a = _mm_xor_ps(swapped_sin, sin_sign);
+    cos_a = _mm_xor_ps(swapped_cos, cos_sign);
+}
+
+// Function to write the vertices of 4 quads from their corners: positions interleaved, constant color, texture coordinates selected per corner
+MQUAD_TARGET_SSE2 static inline void storeQuads4(const __m128 *corner_x, const __m128 *corner_y, const SDL_FPoint *tex_min, const SDL_FPoint *tex_max, SDL_Vertex *vertex)
+{
+    const __m128 white = _mm_set1_ps(1.f);
+    const __m128 x_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, -1)); // Selects the u of two (u, v) pairs
+    for (int pair = 0; pair < 2; pair++)
+    {
+        // Texture coordinates of two quads: (u, v) of the top-left and bottom-right corners, mixed for the other two corners
+        const __m128 min = _mm_loadu_ps(&tex_min[pair * 2].x);
+        const __m128 max = _mm_loadu_ps(&tex_max[pair * 2].x);
+        const __m128 tex[4]{min, _mm_or_ps(_mm_and_ps(x_mask, max), _mm_andnot_ps(x_mask, min)), max, _mm_or_ps(_mm_and_ps(x_mask, min), _mm_andnot_ps(x_mask, max))};
+
+        for (int corner = 0; corner < 4; corner++)
+        {
+            // (x, y) of the two quads of this pair
+            const __m128 position = pair == 0 ? _mm_unpacklo_ps(corner_x[corner], corner_y[corner]) : _mm_unpackhi_ps(corner_x[corner], corner_y[corner]);
+            float *first = &vertex[(pair * 2) * 4 + corner].position.x;
+            float *second = first + 4 * (sizeof(SDL_Vertex) / sizeof(float));
+
+            // A vertex is 8 floats (x, y, r, g, b, a, u, v): written as (x, y, 1, 1) and (1, 1, u, v)
+            _mm_storeu_ps(first, _mm_movelh_ps(position, white));
+            _mm_storeu_ps(first + 4, _mm_movelh_ps(white, tex[corner]));
+            _mm_storeu_ps(second, _mm_movehl_ps(white, position));
+            _mm_storeu_ps(second + 4, _mm_shuffle_ps(white, tex[corner], _MM_SHUFFLE(3, 2, 1, 0)));
+        }
+    }
+}
+
+// Function to compute the corners of 4 quads from their sine and cosine
+MQUAD_TARGET_SSE2 static inline void cornersQuads4(const MQuadArrays &quads, const int i, const __m128 sin_a, const __m128 cos_a, __m128 *corner_x, __m128 *corner_y)
+{
+    const __m128 half_w = _mm_loadu_ps(quads.half_w + i);
+    const __m128 half_h = _mm_loadu_ps(quads.half_h + i);
+    const __m128 cx = _mm_loadu_ps(quads.center_x + i);
+    const __m128 cy = _mm_loadu_ps(quads.center_y + i);
+    const __m128 ax = _mm_mul_ps(half_w, cos_a);
+    const __m128 ay = _mm_mul_ps(half_w, sin_a);
+    const __m128 bx = _mm_xor_ps(_mm_mul_ps(half_h, sin_a), _mm_set1_ps(-0.f)); // Negation by the sign bit, exactly like -x
+    const __m128 by = _mm_mul_ps(half_h, cos_a);
+
+    // Same additions, in the same order, as writeQuad
+    corner_x[0] = _mm_sub_ps(_mm_sub_ps(cx, ax), bx);
+    corner_y[0] = _mm_sub_ps(_mm_sub_ps(cy, ay), by);
+    corner_x[1] = _mm_sub_ps(_mm_add_ps(cx, ax), bx);
+    corner_y[1] = _mm_sub_ps(_mm_add_ps(cy, ay), by);
+    corner_x[2] = _mm_add_ps(_mm_add_ps(cx, ax), bx);
+    corner_y[2] = _mm_add_ps(_mm_add_ps(cy, ay), by);
+    corner_x[3] = _mm_add_ps(_mm_sub_ps(cx, ax), bx);
+    corner_y[3] = _mm_add_ps(_mm_sub_ps(cy, ay), by);
+}
+
+// Function to generate the quads, 4 per iteration (SSE2 kernel)
+MQUAD_TARGET_SSE2 static void generateSSE2(const MQuadArrays &quads, const int count, SDL_Vertex *vertices)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 sin_a, cos_a, corner_x[4], corner_y[4];
+        sinCos4(_mm_loadu_ps(quads.degree + i), sin_a, cos_a);
+        cornersQuads4(quads, i, sin_a, cos_a, corner_x, corner_y);
+        storeQuads4(corner_x, corner_y, quads.tex_min + i, quads.tex_max + i, vertices + (size_t)i * 4);
+    }
+    generateTail(quads, i, count, vertices);
+}
+
+// Function to generate the quads, 8 per iteration: sine and cosine on 8 lanes, corners and stores on two halves of 4 (AVX2 kernel)
+MQUAD_TARGET_AVX2 static void generateAVX2(const MQuadArrays &quads, const int count, SDL_Vertex *vertices)
+{
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 degree = _mm256_loadu_ps(quads.degree + i);
+        const __m256i quarter = _mm256_cvtps_epi32(_mm256_mul_ps(degree, _mm256_set1_ps(QUARTER_TURNS_PER_DEGREE)));
+        const __m256 x = _mm256_mul_ps(_mm256_sub_ps(degree, _mm256_mul_ps(_mm256_cvtepi32_ps(quarter), _mm256_set1_ps(90.f))), _mm256_set1_ps(RADIANS_PER_DEGREE));
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        __m256 s = _mm256_add_ps(_mm256_set1_ps(SIN_C5), _mm256_mul_ps(x2, _mm256_set1_ps(SIN_C7)));
+        s = _mm256_add_ps(_mm256_set1_ps(SIN_C3), _mm256_mul_ps(x2, s));
+        s = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(x, x2), s));
+        __m256 c = _mm256_add_ps(_mm256_set1_ps(COS_C6), _mm256_mul_ps(x2, _mm256_set1_ps(COS_C8)));
+        c = _mm256_add_ps(_mm256_set1_ps(COS_C4), _mm256_mul_ps(x2, c));
+        c = _mm256_add_ps(_mm256_set1_ps(COS_C2), _mm256_mul_ps(x2, c));
+        c = _mm256_add_ps(_mm256_set1_ps(1.f), _mm256_mul_ps(x2, c));
+
+        // Swap the odd quarters with a blend, then flip the sign bits of the negative quarters
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quarter, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        const __m256 sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quarter, _mm256_set1_epi32(2)), 30));
+        const __m256 cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quarter, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+        const __m256 sin_a = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sin_sign);
+        const __m256 cos_a = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cos_sign);
+
+        // Corners and vertices of the two halves
+        for (int half = 0; half < 2; half++)
+        {
+            const int first = i + half * 4;
+            const __m128 half_sin = half == 0 ? _mm256_castps256_ps128(sin_a) : _mm256_extractf128_ps(sin_a, 1);
+            const __m128 half_cos = half == 0 ? _mm256_castps256_ps128(cos_a) : _mm256_extractf128_ps(cos_a, 1);
+            __m128 corner_x[4], corner_y[4];
+            cornersQuads4(quads, first, half_sin, half_cos, corner_x, corner_y);
+            storeQuads4(corner_x, corner_y, quads.tex_min + first, quads.tex_max + first, vertices + (size_t)first * 4);
+        }
+    }
+    generateTail(quads, i, count, vertices);
+}
+#endif
+
+// ############################################################################################
+// QuadGenerator's constructor selects the kernel, falling back to the scalar one when the CPU lacks the instructions
+MQuadGenerator::MQuadGenerator(const Kernel kernel) : kernel(kernel)
+{
+    if (this->kernel == KERNEL_AUTO)
+    {
+        this->kernel = isSupported(KERNEL_AVX2) ? KERNEL_AVX2 : isSupported(KERNEL_SSE2) ? KERNEL_SSE2 : KERNEL_SCALAR;
+    }
+    else if (!isSupported(this->kernel))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Quad kernel %s is not supported by this CPU, using %s\n", getKernelName(this->kernel), getKernelName(KERNEL_SCALAR));
+        this->kernel = KERNEL_SCALAR;
+    }
+}
+
+// ############################################################################################
+// QuadGenerator's generate function writes the vertices of every quad with the selected kernel
+void MQuadGenerator::generate(const MQuadArrays &quads, const int count, SDL_Vertex *vertices) const
+{
+#ifdef MQUAD_X86
+    if (this->kernel == KERNEL_AVX2)
+    {
+        generateAVX2(quads, count, vertices);
+        return;
+    }
+    if (this->kernel == KERNEL_SSE2)
+    {
+        generateSSE2(quads, count, vertices);
+        return;
+    }
+#endif
+    generateScalar(quads, 0, count, vertices);
+}
+
+// ############################################################################################
+// QuadGenerator's isSupported function checks the instruction sets of the CPU
+bool MQuadGenerator::isSupported(const Kernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef MQUAD_X86
+    case KERNEL_SSE2:
+        return SDL_HasSSE2();
+    case KERNEL_AVX2:
+        return SDL_HasAVX2();
+#endif
+    case KERNEL_AUTO:
+    case KERNEL_SCALAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ############################################################################################
+// QuadGenerator's getKernelName function returns the printable name of a kernel
+const char *MQuadGenerator::getKernelName(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KERNEL_SCALAR:
+        return "scalar";
+    case KERNEL_SSE2:
+        return "sse2";
+    case KERNEL_AVX2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
+// ############################################################################################
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Structure to hold a batch of rotated quads in structure-of-arrays form: every pointer has one element per quad
+struct MQuadArrays
+{
+    const float *center_x;     // Horizontal position of the quad center
+    const float *center_y;     // Vertical position of the quad center
+    const float *half_w;       // Half width of the quad
+    const float *half_h;       // Half height of the quad
+    const float *degree;       // Clockwise rotation around the center, in degrees
+    const SDL_FPoint *tex_min; // Texture coordinates of the top-left corner, with the flip already applied (swapped)
+    const SDL_FPoint *tex_max; // Texture coordinates of the bottom-right corner, with the flip already applied (swapped)
+};
+
+// Generator of the vertices of rotated quads, with SSE2/AVX2 kernels selected at runtime and a scalar fallback
+// The SIMD kernels compute sine and cosine with a polynomial (error below 1e-6) instead of calling the C library per quad
+class MQuadGenerator
+{
+public:
+    // Kernels that can generate the vertices
+    enum Kernel
+    {
+        KERNEL_AUTO,   // Best kernel supported by the CPU
+        KERNEL_SCALAR, // Portable C++ with std::sin and std::cos, the reference for the others
+        KERNEL_SSE2,   // 4 quads per iteration
+        KERNEL_AVX2    // 8 quads per iteration
+    };
+
+private:
+    Kernel kernel; // Kernel used by generate
+
+public:
+    // Constructor to select a kernel (KERNEL_AUTO picks the best one the CPU supports)
+    MQuadGenerator(const Kernel kernel = KERNEL_AUTO);
+
+    // Function to write the four vertices of every quad (top-left, top-right, bottom-right, bottom-left), rotated clockwise like SDL_RenderTextureRotated
+    void generate(const MQuadArrays &quads, const int count, SDL_Vertex *vertices) const;
+
+    // Function to check if the CPU can run a kernel
+    static bool isSupported(const Kernel kernel);
+
+    // Getter for the generator state inline for efficiency
+    inline const Kernel getKernel() const { return kernel; } // Getter for the kernel in use
+    static const char *getKernelName(const Kernel kernel);   // Getter for the printable name of a kernel
+};
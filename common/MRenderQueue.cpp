@@ -0,0 +1,203 @@
+#include "MRenderQueue.hpp"
+#include <algorithm>
+
+// ############################################################################################
+// RenderQueue's constructor initializes an empty queue with an unknown renderer state
+MRenderQueue::MRenderQueue()
+    : clear_color{0, 0, 0, 0}, clear_requested(false), draw_color{0, 0, 0, 0}, draw_color_known(false),
+      commands_submitted(0), draw_calls(0), state_changes(0), state_changes_skipped(0)
+{
+}
+
+// ############################################################################################
+// RenderQueue's clear function records the clear of the frame (the last request of a frame wins)
+void MRenderQueue::clear(const SDL_Color &color)
+{
+    this->clear_color = color;
+    this->clear_requested = true;
+}
+
+// ############################################################################################
+// RenderQueue's add function records a draw of a texture
+void MRenderQueue::add(SDL_Texture *texture, const SDL_FRect *srcRect, const SDL_FRect &dstRect, const int layer, const double degree, const SDL_FlipMode flip_mode, const SDL_BlendMode blend_mode)
+{
+    if (texture == nullptr)
+    {
+        return; // Nothing to draw (e.g. a texture that is still loading)
+    }
+
+    // The texture table gives a small sort key to the texture and remembers its blend mode
+    const Uint32 slot = this->getTextureSlot(texture);
+    MRenderCommand command{};
+    command.layer = layer;
+    command.texture_slot = slot;
+    command.blend_mode = blend_mode != SDL_BLENDMODE_INVALID ? blend_mode : this->textures[slot].blend_mode;
+    command.sequence = (Uint32)this->commands.size();
+    command.texture = texture;
+    command.srcRect = srcRect != nullptr ? *srcRect : SDL_FRect{0.f, 0.f, -1.f, -1.f};
+    command.dstRect = dstRect;
+    command.degree = degree;
+    command.flip_mode = flip_mode;
+    this->commands.push_back(command);
+    this->commands_submitted++;
+}
+
+// ############################################################################################
+// RenderQueue's add function records a draw of an MTexture, sized like MTexture::renderTexture
+void MRenderQueue::add(const MTexture &texture, const float x, const float y, const int layer, const SDL_FRect *clipRect)
+{
+    this->add(texture, x, y, 0.0, SDL_FLIP_NONE, layer, clipRect);
+}
+
+// ############################################################################################
+// RenderQueue's add function records a rotated and flipped draw of an MTexture, sized like MTexture::renderTexture
+void MRenderQueue::add(const MTexture &texture, const float x, const float y, const double degree, const SDL_FlipMode flip_mode, const int layer, const SDL_FRect *clipRect)
+{
+    // The destination has the size of the clip rectangle, or of the whole texture
+    SDL_FRect dstRect{x, y, texture.getWidth(), texture.getHeight()};
+    if (clipRect != nullptr)
+    {
+        dstRect.w = clipRect->w;
+        dstRect.h = clipRect->h;
+    }
+    this->add(texture.getTexture(), clipRect, dstRect, layer, degree, flip_mode);
+}
+
+// ############################################################################################
+// RenderQueue's flush function issues the clear and the sorted draws of the frame
+bool MRenderQueue::flush(SDL_Renderer *renderer)
+{
+    bool success{true};
+
+    // The clear needs the draw color, which usually has not changed since the previous frame
+    if (this->clear_requested)
+    {
+        const SDL_Color &color = this->clear_color;
+        if (this->draw_color_known && color.r == this->draw_color.r && color.g == this->draw_color.g && color.b == this->draw_color.b && color.a == this->draw_color.a)
+        {
+            this->state_changes_skipped++;
+        }
+        else
+        {
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            this->draw_color = color;
+            this->draw_color_known = true;
+            this->state_changes++;
+        }
+        if (!SDL_RenderClear(renderer))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to clear render target: %s\n", SDL_GetError());
+            success = false;
+        }
+        this->draw_calls++;
+        this->clear_requested = false;
+    }
+
+    // Sort by layer, then texture and blend mode, so that the draws sharing a state become consecutive (the sequence keeps them in order)
+    std::sort(this->commands.begin(), this->commands.end(), [](const MRenderCommand &a, const MRenderCommand &b)
+              {
+                  if (a.layer != b.layer)
+                  {
+                      return a.layer < b.layer;
+                  }
+                  if (a.texture_slot != b.texture_slot)
+                  {
+                      return a.texture_slot < b.texture_slot;
+                  }
+                  if (a.blend_mode != b.blend_mode)
+                  {
+                      return a.blend_mode < b.blend_mode;
+                  }
+                  return a.sequence < b.sequence;
+              });
+
+    // Issue one run of commands per (layer, texture, blend mode)
+    for (size_t first = 0; first < this->commands.size();)
+    {
+        const MRenderCommand &command = this->commands[first];
+        size_t last = first + 1;
+        while (last < this->commands.size() && this->commands[last].layer == command.layer && this->commands[last].texture == command.texture && this->commands[last].blend_mode == command.blend_mode)
+        {
+            last++;
+        }
+
+        // Set the blend mode of the texture only when it differs from the one it already has
+        TextureState &state = this->textures[command.texture_slot];
+        if (state.blend_mode == command.blend_mode)
+        {
+            this->state_changes_skipped++;
+        }
+        else
+        {
+            SDL_SetTextureBlendMode(command.texture, command.blend_mode);
+            state.blend_mode = command.blend_mode;
+            this->state_changes++;
+        }
+
+        success = this->drawRun(renderer, first, last) && success;
+        first = last;
+    }
+
+    // The buffers keep their capacity, so a steady-state frame does not allocate
+    this->commands.clear();
+    this->textures.clear();
+    return success;
+}
+
+// ############################################################################################
+// RenderQueue's drawRun function draws a run of commands of one texture with a single SDL call
+bool MRenderQueue::drawRun(SDL_Renderer *renderer, const size_t first, const size_t last)
+{
+    const MRenderCommand &command = this->commands[first];
+    this->draw_calls++;
+
+    // A single draw goes straight to SDL, exactly like MTexture::renderTexture
+    if (last - first == 1)
+    {
+        const SDL_FRect *srcRect = command.srcRect.w >= 0.f ? &command.srcRect : nullptr;
+        const bool drawn = command.degree == 0.0 && command.flip_mode == SDL_FLIP_NONE
+                               ? SDL_RenderTexture(renderer, command.texture, srcRect, &command.dstRect)
+                               : SDL_RenderTextureRotated(renderer, command.texture, srcRect, &command.dstRect, command.degree, nullptr, command.flip_mode);
+        if (!drawn)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render queued texture: %s\n", SDL_GetError());
+        }
+        return drawn;
+    }
+
+    // Several draws are merged into one geometry call (the whole texture is the clip rectangle of the draws without one)
+    float texture_w{0.f}, texture_h{0.f};
+    SDL_GetTextureSize(command.texture, &texture_w, &texture_h);
+    this->batch.begin(command.texture);
+    for (size_t i = first; i < last; i++)
+    {
+        const MRenderCommand &quad = this->commands[i];
+        this->batch.add(quad.srcRect.w >= 0.f ? quad.srcRect : SDL_FRect{0.f, 0.f, texture_w, texture_h}, quad.dstRect, quad.flip_mode, quad.degree);
+    }
+    return this->batch.submit(renderer);
+}
+
+// ############################################################################################
+// RenderQueue's getTextureSlot function finds or adds a texture in the texture table of the frame
+Uint32 MRenderQueue::getTextureSlot(SDL_Texture *texture)
+{
+    // Draws of the same texture usually follow each other: check the last one first
+    if (!this->commands.empty() && this->commands.back().texture == texture)
+    {
+        return this->commands.back().texture_slot;
+    }
+    for (size_t slot = 0; slot < this->textures.size(); slot++)
+    {
+        if (this->textures[slot].texture == texture)
+        {
+            return (Uint32)slot;
+        }
+    }
+
+    // First use of the texture in this frame: remember its blend mode, so that unchanged modes are not set again
+    SDL_BlendMode blend_mode{SDL_BLENDMODE_BLEND};
+    SDL_GetTextureBlendMode(texture, &blend_mode);
+    this->textures.push_back(TextureState{texture, blend_mode});
+    return (Uint32)(this->textures.size() - 1);
+}
+// ############################################################################################
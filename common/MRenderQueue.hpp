@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MTexture.hpp"
+#include "MSpriteBatch.hpp"
+#include <vector>
+
+// Structure to hold one deferred draw of a texture
+struct MRenderCommand
+{
+    int layer;                // Drawing layer: lower layers are drawn first
+    Uint32 texture_slot;      // Index of the texture in the frame's texture table, in order of first use
+    SDL_BlendMode blend_mode; // Blend mode the texture is drawn with
+    Uint32 sequence;          // Submission order, keeps the draws of a texture in order
+    SDL_Texture *texture;     // Texture to draw
+    SDL_FRect srcRect;        // Clip rectangle of the texture (w < 0 = whole texture)
+    SDL_FRect dstRect;        // Destination rectangle on the render target
+    double degree;            // Clockwise rotation around the destination center
+    SDL_FlipMode flip_mode;   // Flip applied to the texture
+};
+
+// Deferred render queue: the draws of a frame are recorded, sorted by (layer, texture, blend mode) and issued at flush
+// Inside a layer the draws of different textures may be reordered: put sprites that must overlap in a given order on different layers
+class MRenderQueue
+{
+private:
+    // Structure to hold the state of a texture used in the current frame
+    struct TextureState
+    {
+        SDL_Texture *texture;     // Texture used by at least one command of the frame
+        SDL_BlendMode blend_mode; // Blend mode currently set on the texture
+    };
+
+    std::vector<MRenderCommand> commands; // Commands recorded since the last flush, reused from one frame to the next
+    std::vector<TextureState> textures;   // Textures used by the recorded commands
+    MSpriteBatch batch;                   // Geometry of the consecutive draws of one texture
+    SDL_Color clear_color;                // Color of the clear requested for the frame
+    bool clear_requested;                 // Flag to clear the render target before the draws
+    SDL_Color draw_color;                 // Draw color last set on the renderer
+    bool draw_color_known;                // Flag to indicate that draw_color matches the renderer state
+    Uint64 commands_submitted;            // Number of draws recorded
+    Uint64 draw_calls;                    // Number of SDL draw calls issued (clears included)
+    Uint64 state_changes;                 // Number of render state changes issued
+    Uint64 state_changes_skipped;         // Number of state changes dropped because the state was already set
+
+    // Function to get the slot of a texture in the frame's texture table, adding it on first use
+    Uint32 getTextureSlot(SDL_Texture *texture);
+
+    // Function to issue the draws of consecutive commands that share a texture and a blend mode
+    bool drawRun(SDL_Renderer *renderer, const size_t first, const size_t last);
+
+public:
+    // Constructor to initialize an empty queue
+    MRenderQueue();
+
+    // Function to request a clear of the render target with a color before the draws of the frame
+    void clear(const SDL_Color &color);
+
+    // Function to record a draw of a texture (srcRect = nullptr draws the whole texture, blend_mode = SDL_BLENDMODE_INVALID keeps the texture's)
+    void add(SDL_Texture *texture, const SDL_FRect *srcRect, const SDL_FRect &dstRect, const int layer = 0, const double degree = 0.0,
+             const SDL_FlipMode flip_mode = SDL_FLIP_NONE, const SDL_BlendMode blend_mode = SDL_BLENDMODE_INVALID);
+
+    // Function to record a draw of an MTexture at a position, sized like MTexture::renderTexture
+    void add(const MTexture &texture, const float x, const float y, const int layer = 0, const SDL_FRect *clipRect = nullptr);
+
+    // Function to record a rotated and flipped draw of an MTexture at a position, sized like MTexture::renderTexture
+    void add(const MTexture &texture, const float x, const float y, const double degree, const SDL_FlipMode flip_mode, const int layer = 0, const SDL_FRect *clipRect = nullptr);
+
+    // Function to sort the recorded commands and issue them, merging the draws of a texture into one geometry call
+    bool flush(SDL_Renderer *renderer);
+
+    // Function to forget the cached renderer state, when something else changed it (e.g. another SDL_SetRenderDrawColor)
+    inline void invalidateState() { draw_color_known = false; }
+
+    // Getters for the queue statistics inline for efficiency
+    inline const size_t getPendingCount() const { return commands.size(); }              // Getter for the number of commands waiting for flush
+    inline const Uint64 getCommandsSubmitted() const { return commands_submitted; }      // Getter for the number of recorded draws
+    inline const Uint64 getDrawCalls() const { return draw_calls; }                      // Getter for the number of SDL draw calls
+    inline const Uint64 getStateChanges() const { return state_changes; }                // Getter for the number of state changes issued
+    inline const Uint64 getStateChangesSkipped() const { return state_changes_skipped; } // Getter for the number of redundant state changes dropped
+};
@@ -0,0 +1,80 @@
+#include "MRenderScheduler.hpp"
+
+// ############################################################################################
+// RenderScheduler's setFixedRate function enables frame pacing at the given rate
+void MRenderScheduler::setFixedRate(const int frames_per_second)
+{
+    this->frame_period_ns = frames_per_second > 0 ? SDL_NS_PER_SECOND / frames_per_second : 0;
+    this->next_frame_ns = SDL_GetTicksNS();
+}
+
+// ############################################################################################
+// RenderScheduler's getWaitTimeout function returns the event wait timeout in milliseconds
+Sint32 MRenderScheduler::getWaitTimeout() const
+{
+    // Event-driven mode: do not block if a redraw is pending, otherwise sleep until the next event
+    if (this->frame_period_ns == 0)
+    {
+        return this->dirty ? 0 : -1;
+    }
+
+    // Fixed-rate mode: sleep until the next frame tick, rounded up to a whole millisecond (a truncated timeout wakes before the tick,
+    // and the loop would spin until it is reached)
+    const Uint64 now_ns = SDL_GetTicksNS();
+    if (now_ns >= this->next_frame_ns)
+    {
+        return 0;
+    }
+    return (Sint32)((this->next_frame_ns - now_ns + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS);
+}
+
+// ############################################################################################
+// RenderScheduler's waitEvent function blocks until an event arrives or a frame is due
+bool MRenderScheduler::waitEvent(SDL_Event *event)
+{
+    return SDL_WaitEventTimeout(event, getWaitTimeout());
+}
+
+// ############################################################################################
+// RenderScheduler's handleEvent function invalidates the frame for events that affect the window content
+void MRenderScheduler::handleEvent(const SDL_Event &event)
+{
+    if (event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST)
+    {
+        this->dirty = true;
+    }
+}
+
+// ############################################################################################
+// RenderScheduler's shouldRender function decides if the current iteration redraws the frame
+bool MRenderScheduler::shouldRender()
+{
+    // Fixed-rate mode: nothing to do until the next frame tick
+    if (this->frame_period_ns != 0)
+    {
+        const Uint64 now_ns = SDL_GetTicksNS();
+        if (now_ns < this->next_frame_ns)
+        {
+            return false;
+        }
+
+        // Schedule the next tick, without trying to catch up if the loop fell behind
+        this->next_frame_ns += this->frame_period_ns;
+        if (this->next_frame_ns < now_ns)
+        {
+            this->next_frame_ns = now_ns + this->frame_period_ns;
+        }
+    }
+
+    // Skip the frame if nothing changed since the last present
+    if (!this->dirty)
+    {
+        this->frames_skipped++;
+        return false;
+    }
+
+    this->dirty = false;
+    this->frames_rendered++;
+    return true;
+}
+// ############################################################################################
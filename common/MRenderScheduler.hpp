@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+class MRenderScheduler
+{
+private:
+    bool dirty;              // Flag to indicate that the frame content changed since the last present
+    Uint64 frame_period_ns;  // Time between two frames in fixed-rate mode (0 = event-driven mode)
+    Uint64 next_frame_ns;    // Time of the next frame tick in fixed-rate mode
+    Uint64 frames_rendered;  // Number of frames that were redrawn and presented
+    Uint64 frames_skipped;   // Number of wake-ups that did not need a redraw
+
+    // Function to compute how long the event wait may block before the next frame is due
+    Sint32 getWaitTimeout() const;
+
+public:
+    // Constructor to initialize the scheduler in event-driven mode, with a first frame pending
+    MRenderScheduler() : dirty(true), frame_period_ns(0), next_frame_ns(0), frames_rendered(0), frames_skipped(0) {};
+
+    // Function to switch to fixed-rate mode with frame pacing (frames_per_second = 0 switches back to event-driven mode)
+    void setFixedRate(const int frames_per_second);
+
+    // Function to wait for the next event: blocks while idle, returns false on timeout
+    bool waitEvent(SDL_Event *event);
+
+    // Function to mark the frame as changed when an event affects what is on screen (window events always do)
+    void handleEvent(const SDL_Event &event);
+
+    // Function to check if a frame must be rendered now: clears the dirty flag and updates the counters
+    bool shouldRender();
+
+    // Function to request a redraw on the next frame (input, animation tick, ...)
+    inline void invalidate() { dirty = true; }
+
+    // Getters for the scheduler statistics inline for efficiency
+    inline const Uint64 getFramesRendered() const { return frames_rendered; } // Getter for the number of rendered frames
+    inline const Uint64 getFramesSkipped() const { return frames_skipped; }   // Getter for the number of skipped frames
+};
@@ -0,0 +1,209 @@
+#include "MRotationCache.hpp"
+#include "MAngleTable.hpp"
+#include <cmath>
+
+// ############################################################################################
+// RotationCache's constructor initializes an empty cache (at least one bucket: no rotation)
+MRotationCache::MRotationCache(const int bucket_count)
+    : source(nullptr), bucket_count(bucket_count > 0 ? bucket_count : 1), build_count(0), hit_count(0)
+{
+}
+
+// ############################################################################################
+// RotationCache's destructor frees the source copy and every rotated texture
+MRotationCache::~MRotationCache()
+{
+    this->clear();
+    SDL_DestroySurface(this->source);
+}
+
+// ############################################################################################
+// RotationCache's load function keeps an ARGB8888 copy of the sprite, with transparent pixels where the color key was
+bool MRotationCache::load(SDL_Surface *surface)
+{
+    this->clear();
+    SDL_DestroySurface(this->source);
+    this->source = nullptr;
+    if (surface == nullptr)
+    {
+        return false;
+    }
+
+    if (this->source = SDL_CreateSurface(surface->w, surface->h, SDL_PIXELFORMAT_ARGB8888); this->source == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create rotation cache surface: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // Copy without blending, so that the alpha of the sprite is kept as is; the keyed pixels are skipped and stay transparent
+    SDL_BlendMode blend_mode{SDL_BLENDMODE_NONE};
+    SDL_GetSurfaceBlendMode(surface, &blend_mode);
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    SDL_FillSurfaceRect(this->source, nullptr, 0);
+    const bool copied = SDL_BlitSurface(surface, nullptr, this->source, nullptr);
+    SDL_SetSurfaceBlendMode(surface, blend_mode);
+    if (!copied)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to copy sprite into rotation cache: %s\n", SDL_GetError());
+        SDL_DestroySurface(this->source);
+        this->source = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// ############################################################################################
+// RotationCache's clear function frees the rotated textures, keeping the source so that they can be built again
+void MRotationCache::clear()
+{
+    for (SDL_Texture *texture : this->entries)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    this->entries.clear();
+}
+
+// ############################################################################################
+// RotationCache's getBucket function snaps an angle to the nearest bucket of the turn
+int MRotationCache::getBucket(const double degree) const
+{
+    const double buckets = std::nearbyint(degree * this->bucket_count / 360.0);
+    const int bucket = (int)std::fmod(buckets, (double)this->bucket_count);
+    return bucket < 0 ? bucket + this->bucket_count : bucket;
+}
+
+// ############################################################################################
+// RotationCache's rotateSource function samples the nearest source pixel of every pixel of the rotated bounding box
+SDL_Surface *MRotationCache::rotateSource(const int bucket, const SDL_FlipMode flip_mode) const
+{
+    // The table gives exact quarter turns, so that they are pure pixel permutations without rounding at the borders
+    const double degree = this->getBucketDegree(bucket);
+    float sin_a{0.f}, cos_a{1.f};
+    if (!MAngleTable::lookup(degree, sin_a, cos_a))
+    {
+        sin_a = (float)std::sin(degree * (SDL_PI_D / 180.0));
+        cos_a = (float)std::cos(degree * (SDL_PI_D / 180.0));
+    }
+
+    // Bounding box of the rotated sprite
+    const int src_w = this->source->w;
+    const int src_h = this->source->h;
+    const int dst_w = (int)std::ceil(std::fabs(src_w * cos_a) + std::fabs(src_h * sin_a) - 1e-3f);
+    const int dst_h = (int)std::ceil(std::fabs(src_w * sin_a) + std::fabs(src_h * cos_a) - 1e-3f);
+    SDL_Surface *rotated = SDL_CreateSurface(dst_w, dst_h, SDL_PIXELFORMAT_ARGB8888);
+    if (rotated == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create rotated surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+
+    // Every destination pixel center is rotated back (counterclockwise) into the source, outside of it the pixel is transparent
+    for (int y = 0; y < dst_h; y++)
+    {
+        Uint32 *dst_row = (Uint32 *)((Uint8 *)rotated->pixels + (size_t)y * rotated->pitch);
+        const float py = y + 0.5f - dst_h / 2.f;
+        for (int x = 0; x < dst_w; x++)
+        {
+            const float px = x + 0.5f - dst_w / 2.f;
+            const int sx = (int)std::floor(px * cos_a + py * sin_a + src_w / 2.f);
+            const int sy = (int)std::floor(-px * sin_a + py * cos_a + src_h / 2.f);
+            if (sx < 0 || sy < 0 || sx >= src_w || sy >= src_h)
+            {
+                dst_row[x] = 0;
+                continue;
+            }
+
+            // The flip is applied to the sprite before the rotation
+            const int flipped_x = (flip_mode & SDL_FLIP_HORIZONTAL) ? src_w - 1 - sx : sx;
+            const int flipped_y = (flip_mode & SDL_FLIP_VERTICAL) ? src_h - 1 - sy : sy;
+            dst_row[x] = ((const Uint32 *)((const Uint8 *)this->source->pixels + (size_t)flipped_y * this->source->pitch))[flipped_x];
+        }
+    }
+    return rotated;
+}
+
+// ############################################################################################
+// RotationCache's buildEntry function rotates the source into the texture of one (bucket, flip) entry
+bool MRotationCache::buildEntry(SDL_Renderer *renderer, const size_t entry)
+{
+    SDL_Surface *rotated = this->rotateSource((int)(entry / 4), (SDL_FlipMode)(entry % 4));
+    if (rotated == nullptr)
+    {
+        return false;
+    }
+    this->entries[entry] = SDL_CreateTextureFromSurface(renderer, rotated);
+    SDL_DestroySurface(rotated);
+    if (this->entries[entry] == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create rotated texture: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(this->entries[entry], SDL_BLENDMODE_BLEND);
+    this->build_count++;
+    return true;
+}
+
+// ############################################################################################
+// RotationCache's buildAll function builds every entry up front, so that no draw has to allocate a rotation later
+bool MRotationCache::buildAll(SDL_Renderer *renderer)
+{
+    if (this->source == nullptr)
+    {
+        return false; // Nothing loaded
+    }
+    if (this->entries.empty())
+    {
+        this->entries.resize((size_t)this->bucket_count * 4, nullptr);
+    }
+
+    for (size_t entry = 0; entry < this->entries.size(); entry++)
+    {
+        if (this->entries[entry] == nullptr && !this->buildEntry(renderer, entry))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ############################################################################################
+// RotationCache's render function draws the pre-rotated texture of the angle bucket, building it on first use
+bool MRotationCache::render(SDL_Renderer *renderer, const float x, const float y, const double degree, const SDL_FlipMode flip_mode)
+{
+    if (this->source == nullptr)
+    {
+        return false; // Nothing loaded
+    }
+
+    // One entry per bucket and flip mode (none, horizontal, vertical, both)
+    const int flip = (int)flip_mode & (SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL);
+    const size_t entry = (size_t)this->getBucket(degree) * 4 + flip;
+    if (this->entries.empty())
+    {
+        this->entries.resize((size_t)this->bucket_count * 4, nullptr);
+    }
+
+    if (this->entries[entry] == nullptr)
+    {
+        if (!this->buildEntry(renderer, entry))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        this->hit_count++;
+    }
+
+    // The rotated bounding box shares the center of the unrotated sprite at (x, y)
+    float rotated_w{0.f}, rotated_h{0.f};
+    SDL_GetTextureSize(this->entries[entry], &rotated_w, &rotated_h);
+    const SDL_FRect dstRect{x + (this->source->w - rotated_w) / 2.f, y + (this->source->h - rotated_h) / 2.f, rotated_w, rotated_h};
+    if (!SDL_RenderTexture(renderer, this->entries[entry], nullptr, &dstRect))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render rotated texture: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+// ############################################################################################
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Cache of a sprite pre-rotated into a fixed number of angle buckets, for renderers that rotate on the CPU (the software renderer
+// rotates the whole surface on every SDL_RenderTextureRotated call): each (bucket, flip) is rotated once, then drawn as a plain copy
+// Angles are snapped to the nearest bucket: 12 buckets keep the 30 degree steps of tutorial 06 exact, more buckets suit free rotations
+class MRotationCache
+{
+private:
+    SDL_Surface *source;                // ARGB8888 copy of the sprite, with the color key turned into transparency
+    int bucket_count;                   // Number of angles in a turn
+    std::vector<SDL_Texture *> entries; // Pre-rotated texture of each (bucket, flip), nullptr until first drawn
+    Uint64 build_count;                 // Number of rotated textures built
+    Uint64 hit_count;                   // Number of draws served by a texture already built
+
+    // Function to rotate and flip the source like SDL_RenderTextureRotated, into a surface the size of its bounding box
+    SDL_Surface *rotateSource(const int bucket, const SDL_FlipMode flip_mode) const;
+
+    // Function to build the texture of one (bucket, flip) entry
+    bool buildEntry(SDL_Renderer *renderer, const size_t entry);
+
+public:
+    // Constructor to initialize an empty cache with a number of angle buckets
+    MRotationCache(const int bucket_count = 12);
+
+    // Destructor to free the source copy and the rotated textures
+    ~MRotationCache();
+
+    // The cache owns its surface and textures: no copies
+    MRotationCache(const MRotationCache &) = delete;
+    MRotationCache &operator=(const MRotationCache &) = delete;
+
+    // Function to copy the sprite to rotate (owned by the caller), dropping the rotations of the previous one
+    bool load(SDL_Surface *surface);
+
+    // Function to draw the sprite rotated clockwise around its center and flipped, like MTexture::renderTexture at (x, y)
+    bool render(SDL_Renderer *renderer, const float x, const float y, const double degree, const SDL_FlipMode flip_mode);
+
+    // Function to build every (bucket, flip) texture at once, e.g. at load time so that the frames never rotate nor allocate
+    bool buildAll(SDL_Renderer *renderer);
+
+    // Function to free the rotated textures (e.g. before destroying the renderer they were created with)
+    void clear();
+
+    // Function to get the angle bucket of an angle
+    int getBucket(const double degree) const;
+
+    // Getters for the cache state inline for efficiency
+    inline const int getBucketCount() const { return bucket_count; }                                      // Getter for the number of angle buckets
+    inline const double getBucketDegree(const int bucket) const { return bucket * 360.0 / bucket_count; } // Getter for the angle a bucket is rotated by
+    inline const Uint64 getBuildCount() const { return build_count; }                                     // Getter for the number of rotations built
+    inline const Uint64 getHitCount() const { return hit_count; }                                         // Getter for the number of cache hits
+};
@@ -0,0 +1,96 @@
+#include "MScaledSurfaceCache.hpp"
+#include "MLog.hpp"
+
+// ScaledSurfaceCache's destructor frees the scaled copy
+MScaledSurfaceCache::~MScaledSurfaceCache() { invalidate(); }
+
+// ############################################################################################
+// ScaledSurfaceCache's acquire function returns the scaled copy, scaling the source again only when the key changed
+SDL_Surface *MScaledSurfaceCache::acquire(SDL_Surface *src, const int width, const int height, const SDL_PixelFormat format, const SDL_ScaleMode mode)
+{
+    if (src == nullptr || width <= 0 || height <= 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid source or size for the scaled surface cache\n");
+        return nullptr;
+    }
+
+    // A source with an alpha channel keeps its own format, so that its transparency survives the scaling
+    const SDL_PixelFormat scaled_format = SDL_ISPIXELFORMAT_ALPHA(src->format) ? src->format : format;
+
+    // Cache hit: same source, same size, same format and same scale mode
+    if (this->scaled != nullptr && this->source == src && this->scaled->w == width && this->scaled->h == height && this->scaled->format == scaled_format && this->scale_mode == mode)
+    {
+        this->hit_count++;
+        return this->scaled;
+    }
+
+    this->invalidate();
+    if (this->scaled = SDL_CreateSurface(width, height, scaled_format); this->scaled == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create scaled surface: %s\n", SDL_GetError());
+        return nullptr;
+    }
+
+    // Scale the raw source pixels: blending and color key are disabled while scaling and applied later, when the scaled copy is blitted
+    SDL_BlendMode blend_mode{SDL_BLENDMODE_NONE};
+    Uint32 color_key{0};
+    const bool has_color_key = SDL_GetSurfaceColorKey(src, &color_key);
+    SDL_GetSurfaceBlendMode(src, &blend_mode);
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorKey(src, false, 0);
+    const bool scaled_ok = this->blitter.blitScaled(src, nullptr, this->scaled, nullptr, mode);
+    SDL_SetSurfaceBlendMode(src, blend_mode);
+    SDL_SetSurfaceColorKey(src, has_color_key, color_key);
+    if (!scaled_ok)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to scale surface: %s\n", SDL_GetError());
+        this->invalidate();
+        return nullptr;
+    }
+
+    // The scaled copy is blitted the way the source would be: same blend mode, modulation and color key
+    Uint8 r{0xFF}, g{0xFF}, b{0xFF}, a{0xFF};
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_SetSurfaceBlendMode(this->scaled, blend_mode);
+    SDL_SetSurfaceColorMod(this->scaled, r, g, b);
+    SDL_SetSurfaceAlphaMod(this->scaled, a);
+    SDL_SetSurfaceColorKey(this->scaled, has_color_key, color_key);
+
+    this->source = src;
+    this->scale_mode = mode;
+    this->rebuild_count++;
+    MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Scaled surface rebuilt at %dx%d.\n", width, height);
+    return this->scaled;
+}
+
+// ############################################################################################
+// ScaledSurfaceCache's blit function copies the cached scaled surface to the destination without scaling
+bool MScaledSurfaceCache::blit(SDL_Surface *src, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_ScaleMode mode)
+{
+    if (dst == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid destination for the scaled surface cache\n");
+        return false;
+    }
+    const SDL_Rect dst_rect = dstrect != nullptr ? *dstrect : SDL_Rect{0, 0, dst->w, dst->h};
+
+    SDL_Surface *scaled_surface = this->acquire(src, dst_rect.w, dst_rect.h, dst->format, mode);
+    if (scaled_surface == nullptr)
+    {
+        return false;
+    }
+
+    // Same size and, for opaque sources, same format: SDL copies the rows as they are
+    return SDL_BlitSurface(scaled_surface, nullptr, dst, &dst_rect);
+}
+
+// ############################################################################################
+// ScaledSurfaceCache's invalidate function frees the scaled copy
+void MScaledSurfaceCache::invalidate()
+{
+    SDL_DestroySurface(this->scaled);
+    this->scaled = nullptr;
+    this->source = nullptr;
+}
+// ############################################################################################
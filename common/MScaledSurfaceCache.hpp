@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MSurfaceBlitter.hpp"
+
+// Cache of one surface scaled to a fixed size, for images that are redrawn every frame at the same size
+// The cache is keyed on (source surface, size, format, scale mode): the pixels of the source are assumed not to change, call invalidate after editing them
+class MScaledSurfaceCache
+{
+private:
+    SDL_Surface *source;      // Surface the cached surface was scaled from
+    SDL_Surface *scaled;      // Scaled copy of the source, nullptr when the cache is empty
+    SDL_ScaleMode scale_mode; // Scale mode used to build the scaled copy
+    MSurfaceBlitter blitter;  // Blitter used to build the scaled copy
+    Uint64 rebuild_count;     // Number of times the scaled copy was built
+    Uint64 hit_count;         // Number of requests served by the scaled copy already built
+
+public:
+    // Constructor to initialize an empty cache
+    MScaledSurfaceCache() : source(nullptr), scaled(nullptr), scale_mode(SDL_SCALEMODE_LINEAR), rebuild_count(0), hit_count(0) {};
+
+    // Destructor to free the scaled copy
+    ~MScaledSurfaceCache();
+
+    // The cache owns its surface: no copies
+    MScaledSurfaceCache(const MScaledSurfaceCache &) = delete;
+    MScaledSurfaceCache &operator=(const MScaledSurfaceCache &) = delete;
+
+    // Function to get the source scaled to a size, building it only when the key changed
+    SDL_Surface *acquire(SDL_Surface *src, const int width, const int height, const SDL_PixelFormat format, const SDL_ScaleMode mode);
+
+    // Function to draw the source scaled to the destination rectangle (nullptr = whole surface) with an unscaled copy of the cached surface
+    bool blit(SDL_Surface *src, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_ScaleMode mode);
+
+    // Function to free the scaled copy, so that the next request builds it again (window resized, source pixels edited)
+    void invalidate();
+
+    // Getters for the cache statistics inline for efficiency
+    inline const Uint64 getRebuildCount() const { return rebuild_count; } // Getter for the number of rebuilds
+    inline const Uint64 getHitCount() const { return hit_count; }         // Getter for the number of cache hits
+    inline SDL_Surface *getSurface() const { return scaled; }             // Getter for the scaled copy (nullptr when empty)
+};
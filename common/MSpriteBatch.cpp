@@ -0,0 +1,112 @@
+#include "MSpriteBatch.hpp"
+#include "MAngleTable.hpp"
+#include <cmath>
+#include <utility>
+
+// ############################################################################################
+// SpriteBatch's begin function resets the batch for a new texture
+void MSpriteBatch::begin(SDL_Texture *texture)
+{
+    this->texture = texture;
+    this->vertices.clear(); // Capacity is kept, so a steady-state frame does not allocate
+
+    // Get the texture dimensions to convert clip rectangles into texture coordinates
+    if (!SDL_GetTextureSize(texture, &this->texture_width, &this->texture_height))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to get texture size for sprite batch: %s\n", SDL_GetError());
+        this->texture_width = 0;
+        this->texture_height = 0;
+    }
+}
+
+// ############################################################################################
+// SpriteBatch's add function appends the four vertices of a quad
+void MSpriteBatch::add(const SDL_FRect &srcRect, const SDL_FRect &dstRect, const SDL_FlipMode flip_mode, const double degree)
+{
+    if (this->texture_width <= 0 || this->texture_height <= 0)
+    {
+        return; // Nothing can be drawn without a valid texture
+    }
+
+    // Texture coordinates of the clip rectangle, swapped for the flipped axes
+    float u0 = srcRect.x / this->texture_width;
+    float v0 = srcRect.y / this->texture_height;
+    float u1 = (srcRect.x + srcRect.w) / this->texture_width;
+    float v1 = (srcRect.y + srcRect.h) / this->texture_height;
+    if (flip_mode & SDL_FLIP_HORIZONTAL)
+    {
+        std::swap(u0, u1);
+    }
+    if (flip_mode & SDL_FLIP_VERTICAL)
+    {
+        std::swap(v0, v1);
+    }
+
+    // Corners relative to the center of the destination rectangle (top-left, top-right, bottom-right, bottom-left)
+    const float half_w = dstRect.w / 2.f;
+    const float half_h = dstRect.h / 2.f;
+    const float center_x = dstRect.x + half_w;
+    const float center_y = dstRect.y + half_h;
+    const SDL_FPoint corners[4]{{-half_w, -half_h}, {half_w, -half_h}, {half_w, half_h}, {-half_w, half_h}};
+    const SDL_FPoint tex_coords[4]{{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    const SDL_FColor white{1.f, 1.f, 1.f, 1.f};
+
+    // Quarter turns (including the common unrotated case) keep the quad axis-aligned: the texture coordinates move to the next corners
+    const int quarter_turns = MAngleTable::getQuarterTurns(degree);
+    if (quarter_turns >= 0)
+    {
+        const float extent_w = quarter_turns % 2 == 0 ? half_w : half_h; // Odd turns swap width and height
+        const float extent_h = quarter_turns % 2 == 0 ? half_h : half_w;
+        const SDL_FPoint box[4]{{-extent_w, -extent_h}, {extent_w, -extent_h}, {extent_w, extent_h}, {-extent_w, extent_h}};
+        for (int i = 0; i < 4; i++)
+        {
+            this->vertices.push_back(SDL_Vertex{{center_x + box[i].x, center_y + box[i].y}, white, tex_coords[(i - quarter_turns + 4) % 4]});
+        }
+        return;
+    }
+
+    // Rotate clockwise around the center like SDL_RenderTextureRotated: multiples of 15 degrees (the 30 degree steps of tutorial 06) come from the table
+    float cos_a{1.f}, sin_a{0.f};
+    if (!MAngleTable::lookup(degree, sin_a, cos_a))
+    {
+        const double radians = degree * (SDL_PI_D / 180.0);
+        cos_a = (float)std::cos(radians);
+        sin_a = (float)std::sin(radians);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        const float x = center_x + corners[i].x * cos_a - corners[i].y * sin_a;
+        const float y = center_y + corners[i].x * sin_a + corners[i].y * cos_a;
+        this->vertices.push_back(SDL_Vertex{{x, y}, white, tex_coords[i]});
+    }
+}
+
+// ############################################################################################
+// SpriteBatch's submit function draws every collected quad at once
+bool MSpriteBatch::submit(SDL_Renderer *renderer)
+{
+    const size_t quad_count = getQuadCount();
+    if (quad_count == 0)
+    {
+        return true; // Nothing to draw
+    }
+
+    // Extend the index buffer only when the batch is bigger than any previous one (two triangles per quad)
+    for (size_t quad = this->indices.size() / 6; quad < quad_count; quad++)
+    {
+        const int first = (int)(quad * 4);
+        this->indices.insert(this->indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    // Render every quad of the batch with a single draw call
+    this->draw_calls++;
+    if (!SDL_RenderGeometry(renderer, this->texture, this->vertices.data(), (int)this->vertices.size(), this->indices.data(), (int)(quad_count * 6)))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render sprite batch: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+// ############################################################################################
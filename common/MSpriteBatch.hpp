@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+class MSpriteBatch
+{
+private:
+    SDL_Texture *texture;             // Texture shared by every quad of the batch
+    float texture_width;              // Width of the texture, used to normalize the texture coordinates
+    float texture_height;             // Height of the texture, used to normalize the texture coordinates
+    std::vector<SDL_Vertex> vertices; // Four vertices per quad, reused from one frame to the next
+    std::vector<int> indices;         // Six indices per quad, only extended when the batch grows
+    Uint64 draw_calls;                // Number of SDL_RenderGeometry calls issued
+
+public:
+    // Constructor to initialize an empty batch
+    MSpriteBatch() : texture(nullptr), texture_width(0), texture_height(0), draw_calls(0) {};
+
+    // Function to start collecting quads for a texture (keeps the buffers allocated)
+    void begin(SDL_Texture *texture);
+
+    // Function to add a quad: clip rectangle of the texture, destination rectangle, flip and rotation around the destination center
+    void add(const SDL_FRect &srcRect, const SDL_FRect &dstRect, const SDL_FlipMode flip_mode = SDL_FLIP_NONE, const double degree = 0.0);
+
+    // Function to render every collected quad with a single SDL_RenderGeometry call
+    bool submit(SDL_Renderer *renderer);
+
+    // Getters for the batch state inline for efficiency
+    inline const size_t getQuadCount() const { return vertices.size() / 4; } // Getter for the number of collected quads
+    inline const Uint64 getDrawCalls() const { return draw_calls; }         // Getter for the number of draw calls issued
+};
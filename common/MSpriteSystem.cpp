@@ -0,0 +1,272 @@
+#include "MSpriteSystem.hpp"
+#include <cmath>
+#include <utility>
+
+// ############################################################################################
+// SpriteSystem's addTexture function registers a texture and remembers its size
+int MSpriteSystem::addTexture(SDL_Texture *texture)
+{
+    // The texture id is stored in 16 bits per sprite
+    if (texture == nullptr || this->textures.size() > 0xFFFF)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to add texture to sprite system: %s\n", texture == nullptr ? "null texture" : "too many textures");
+        return -1;
+    }
+
+    SDL_FPoint size{0.f, 0.f};
+    if (!SDL_GetTextureSize(texture, &size.x, &size.y))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to get texture size for sprite system: %s\n", SDL_GetError());
+        return -1;
+    }
+    this->textures.push_back(texture);
+    this->texture_sizes.push_back(size);
+    return (int)this->textures.size() - 1;
+}
+
+// ############################################################################################
+// SpriteSystem's add function appends a sprite to every array
+int MSpriteSystem::add(const int texture_id, const SDL_FRect &dstRect, const SDL_FRect *clipRect, const float degree, const SDL_FlipMode flip_mode, const float spin)
+{
+    if (texture_id < 0 || texture_id >= (int)this->textures.size())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to add sprite: unknown texture id %d\n", texture_id);
+        return -1;
+    }
+
+    const SDL_FPoint &size = this->texture_sizes[texture_id];
+    this->center_x.push_back(dstRect.x + dstRect.w / 2.f);
+    this->center_y.push_back(dstRect.y + dstRect.h / 2.f);
+    this->half_w.push_back(dstRect.w / 2.f);
+    this->half_h.push_back(dstRect.h / 2.f);
+    this->degree.push_back(0.f);
+    this->spin.push_back(spin);
+    this->tex_min.push_back(SDL_FPoint{0.f, 0.f});
+    this->tex_max.push_back(SDL_FPoint{1.f, 1.f});
+    this->texture_id.push_back((Uint16)texture_id);
+    this->clip.push_back(clipRect != nullptr ? *clipRect : SDL_FRect{0.f, 0.f, size.x, size.y});
+    this->flip.push_back(flip_mode);
+
+    const int index = this->getCount() - 1;
+    this->setRotation(index, degree);
+    this->updateTexCoords(index);
+    return index;
+}
+
+// ############################################################################################
+// SpriteSystem's remove function moves the last sprite into the removed one, so that the arrays stay packed
+void MSpriteSystem::remove(const int index)
+{
+    const int last = this->getCount() - 1;
+    if (index < 0 || index > last)
+    {
+        return; // Nothing to remove
+    }
+
+    this->center_x[index] = this->center_x[last];
+    this->center_y[index] = this->center_y[last];
+    this->half_w[index] = this->half_w[last];
+    this->half_h[index] = this->half_h[last];
+    this->degree[index] = this->degree[last];
+    this->spin[index] = this->spin[last];
+    this->tex_min[index] = this->tex_min[last];
+    this->tex_max[index] = this->tex_max[last];
+    this->texture_id[index] = this->texture_id[last];
+    this->clip[index] = this->clip[last];
+    this->flip[index] = this->flip[last];
+
+    this->center_x.pop_back();
+    this->center_y.pop_back();
+    this->half_w.pop_back();
+    this->half_h.pop_back();
+    this->degree.pop_back();
+    this->spin.pop_back();
+    this->tex_min.pop_back();
+    this->tex_max.pop_back();
+    this->texture_id.pop_back();
+    this->clip.pop_back();
+    this->flip.pop_back();
+}
+
+// ############################################################################################
+// SpriteSystem's clear function removes every sprite (capacities are kept)
+void MSpriteSystem::clear()
+{
+    this->center_x.clear();
+    this->center_y.clear();
+    this->half_w.clear();
+    this->half_h.clear();
+    this->degree.clear();
+    this->spin.clear();
+    this->tex_min.clear();
+    this->tex_max.clear();
+    this->texture_id.clear();
+    this->clip.clear();
+    this->flip.clear();
+}
+
+// ############################################################################################
+// SpriteSystem's reserve function allocates every array for a number of sprites at once
+void MSpriteSystem::reserve(const size_t count)
+{
+    this->center_x.reserve(count);
+    this->center_y.reserve(count);
+    this->half_w.reserve(count);
+    this->half_h.reserve(count);
+    this->degree.reserve(count);
+    this->spin.reserve(count);
+    this->tex_min.reserve(count);
+    this->tex_max.reserve(count);
+    this->texture_id.reserve(count);
+    this->clip.reserve(count);
+    this->flip.reserve(count);
+    this->vertices.reserve(count * 4);
+}
+
+// ############################################################################################
+// SpriteSystem's setPosition function moves a sprite, given the top-left corner of its unrotated destination
+void MSpriteSystem::setPosition(const int index, const float x, const float y)
+{
+    this->center_x[index] = x + this->half_w[index];
+    this->center_y[index] = y + this->half_h[index];
+}
+
+// ############################################################################################
+// SpriteSystem's setRotation function sets the rotation of a sprite, wrapped into [0, 360)
+void MSpriteSystem::setRotation(const int index, const float degree)
+{
+    float wrapped = std::fmod(degree, 360.f);
+    this->degree[index] = wrapped < 0.f ? wrapped + 360.f : wrapped;
+}
+
+// ############################################################################################
+// SpriteSystem's setSpin function sets the rotation speed of a sprite
+void MSpriteSystem::setSpin(const int index, const float spin)
+{
+    this->spin[index] = spin;
+}
+
+// ############################################################################################
+// SpriteSystem's setFlip function sets the flip of a sprite and swaps its texture coordinates
+void MSpriteSystem::setFlip(const int index, const SDL_FlipMode flip_mode)
+{
+    this->flip[index] = flip_mode;
+    this->updateTexCoords(index);
+}
+
+// ############################################################################################
+// SpriteSystem's updateTexCoords function normalizes the clip rectangle of a sprite and applies its flip
+void MSpriteSystem::updateTexCoords(const int index)
+{
+    const SDL_FPoint &size = this->texture_sizes[this->texture_id[index]];
+    const SDL_FRect &rect = this->clip[index];
+    SDL_FPoint min{rect.x / size.x, rect.y / size.y};
+    SDL_FPoint max{(rect.x + rect.w) / size.x, (rect.y + rect.h) / size.y};
+
+    // A flip is a swap of the texture coordinates of the flipped axis
+    if (this->flip[index] & SDL_FLIP_HORIZONTAL)
+    {
+        std::swap(min.x, max.x);
+    }
+    if (this->flip[index] & SDL_FLIP_VERTICAL)
+    {
+        std::swap(min.y, max.y);
+    }
+    this->tex_min[index] = min;
+    this->tex_max[index] = max;
+}
+
+// ############################################################################################
+// SpriteSystem's update function advances every rotation in one pass over two arrays
+void MSpriteSystem::update(const float seconds)
+{
+    const int count = this->getCount();
+    float *degree = this->degree.data();
+    const float *spin = this->spin.data();
+
+    // No calls and no data dependencies between iterations: the compiler vectorizes this loop
+    for (int i = 0; i < count; i++)
+    {
+        float value = degree[i] + spin[i] * seconds;
+        value -= 360.f * std::floor(value * (1.f / 360.f)); // Wrap into [0, 360) so that the angle keeps its precision
+        degree[i] = value;
+    }
+}
+
+// ############################################################################################
+// SpriteSystem's render function draws every sprite with one geometry call per texture
+bool MSpriteSystem::render(SDL_Renderer *renderer, const float offset_seconds)
+{
+    const int count = this->getCount();
+    if (count == 0)
+    {
+        return true; // Nothing to draw
+    }
+
+    // Generate the four rotated corners of every sprite straight into the vertex buffer, several sprites per instruction
+    this->vertices.resize((size_t)count * 4);
+    const float *degree = this->degree.data();
+    if (offset_seconds != 0.f)
+    {
+        // Same loop as update, into a separate array: the stored rotations stay those of the last update
+        this->render_degree.resize((size_t)count);
+        float *offset_degree = this->render_degree.data();
+        const float *spin = this->spin.data();
+        for (int i = 0; i < count; i++)
+        {
+            float value = degree[i] + spin[i] * offset_seconds;
+            value -= 360.f * std::floor(value * (1.f / 360.f));
+            offset_degree[i] = value;
+        }
+        degree = offset_degree;
+    }
+    const MQuadArrays quads{this->center_x.data(), this->center_y.data(), this->half_w.data(), this->half_h.data(), degree, this->tex_min.data(), this->tex_max.data()};
+    this->generator.generate(quads, count, this->vertices.data());
+
+    // Extend the index buffer only when the system is bigger than ever before (two triangles per sprite)
+    for (int sprite = (int)(this->indices.size() / 6); sprite < count; sprite++)
+    {
+        const int first = sprite * 4;
+        this->indices.insert(this->indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    // A single texture draws every sprite in one call with the shared index buffer
+    if (this->textures.size() == 1)
+    {
+        this->draw_calls++;
+        if (!SDL_RenderGeometry(renderer, this->textures[0], this->vertices.data(), count * 4, this->indices.data(), count * 6))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render sprite system: %s\n", SDL_GetError());
+            return false;
+        }
+        return true;
+    }
+
+    // Several textures: the vertices are shared, each texture draws the sprites it selects through its own index list
+    bool success{true};
+    for (size_t id = 0; id < this->textures.size(); id++)
+    {
+        this->texture_indices.clear();
+        for (int i = 0; i < count; i++)
+        {
+            if (this->texture_id[i] == id)
+            {
+                const int *quad = &this->indices[(size_t)i * 6];
+                this->texture_indices.insert(this->texture_indices.end(), quad, quad + 6);
+            }
+        }
+        if (this->texture_indices.empty())
+        {
+            continue; // No sprite uses this texture
+        }
+
+        this->draw_calls++;
+        if (!SDL_RenderGeometry(renderer, this->textures[id], this->vertices.data(), count * 4, this->texture_indices.data(), (int)this->texture_indices.size()))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render sprite system: %s\n", SDL_GetError());
+            success = false;
+        }
+    }
+    return success;
+}
+// ############################################################################################
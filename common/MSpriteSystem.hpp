@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include "MQuadGenerator.hpp"
+#include <vector>
+
+// Sprite storage in structure-of-arrays form: each property of the sprites is a contiguous array, so that the
+// transform update and the vertex generation run as tight loops over the data they need, and every sprite of a
+// texture is drawn with one SDL_RenderGeometry call
+// Sprites are drawn texture by texture (in order of addTexture), in the order they were added inside a texture
+class MSpriteSystem
+{
+private:
+    // Hot data: read for every sprite by update or render
+    std::vector<float> center_x;     // Horizontal position of the sprite center
+    std::vector<float> center_y;     // Vertical position of the sprite center
+    std::vector<float> half_w;       // Half width of the destination rectangle
+    std::vector<float> half_h;       // Half height of the destination rectangle
+    std::vector<float> degree;       // Clockwise rotation around the center, kept in [0, 360)
+    std::vector<float> spin;         // Rotation speed in degrees per second (0 = static)
+    std::vector<SDL_FPoint> tex_min; // Texture coordinates of the top-left corner, flip applied
+    std::vector<SDL_FPoint> tex_max; // Texture coordinates of the bottom-right corner, flip applied
+    std::vector<Uint16> texture_id;  // Index of the sprite texture in the texture table
+
+    // Cold data: only read when a sprite changes
+    std::vector<SDL_FRect> clip;    // Clip rectangle of the texture
+    std::vector<SDL_FlipMode> flip; // Flip applied to the texture
+
+    // Textures and draw buffers shared by every sprite
+    std::vector<SDL_Texture *> textures;   // Texture table, indexed by texture_id
+    std::vector<SDL_FPoint> texture_sizes; // Size of each texture, to normalize the clip rectangles
+    std::vector<SDL_Vertex> vertices;      // Four vertices per sprite, reused from one frame to the next
+    std::vector<float> render_degree;      // Rotations advanced for the draw only (render with a time offset), reused from one frame to the next
+    std::vector<int> indices;              // Six indices per sprite in sprite order, only extended when the system grows
+    std::vector<int> texture_indices;      // Indices of the sprites of one texture, when there is more than one texture
+    MQuadGenerator generator;              // SIMD generator of the rotated corners
+    Uint64 draw_calls;                     // Number of SDL_RenderGeometry calls issued
+
+    // Function to compute the texture coordinates of a sprite from its clip rectangle and flip
+    void updateTexCoords(const int index);
+
+public:
+    // Constructor to initialize an empty system (KERNEL_AUTO generates the vertices with the best kernel the CPU supports)
+    MSpriteSystem(const MQuadGenerator::Kernel kernel = MQuadGenerator::KERNEL_AUTO) : generator(kernel), draw_calls(0) {};
+
+    // Function to add a texture to the texture table: returns its id, -1 on failure
+    int addTexture(SDL_Texture *texture);
+
+    // Function to add a sprite (clipRect = nullptr uses the whole texture): returns its index, -1 on failure
+    int add(const int texture_id, const SDL_FRect &dstRect, const SDL_FRect *clipRect = nullptr, const float degree = 0.f,
+            const SDL_FlipMode flip_mode = SDL_FLIP_NONE, const float spin = 0.f);
+
+    // Function to remove a sprite: the last sprite takes its index
+    void remove(const int index);
+
+    // Function to remove every sprite, keeping the texture table and the buffers allocated
+    void clear();
+
+    // Function to reserve the storage of a number of sprites, so that adding them does not reallocate
+    void reserve(const size_t count);
+
+    // Functions to change one sprite
+    void setPosition(const int index, const float x, const float y); // Top-left corner of the unrotated destination, like MTexture::renderTexture
+    void setRotation(const int index, const float degree);           // Clockwise rotation in degrees
+    void setSpin(const int index, const float spin);                 // Rotation speed in degrees per second
+    void setFlip(const int index, const SDL_FlipMode flip_mode);     // Flip of the texture
+
+    // Function to advance the rotation of every sprite by its spin
+    void update(const float seconds);
+
+    // Function to generate the vertices of every sprite and draw them with one SDL_RenderGeometry call per texture
+    // The rotations are drawn advanced by their spin for offset_seconds, without changing them: a negative offset interpolates
+    // between two fixed updates (e.g. (alpha - 1) * step with MFixedTimestep)
+    bool render(SDL_Renderer *renderer, const float offset_seconds = 0.f);
+
+    // Getters for the system state inline for efficiency
+    inline const int getCount() const { return (int)center_x.size(); }                      // Getter for the number of sprites
+    inline const float getRotation(const int index) const { return degree[index]; }         // Getter for the rotation of a sprite
+    inline const Uint64 getDrawCalls() const { return draw_calls; }                         // Getter for the number of draw calls issued
+    inline const MQuadGenerator::Kernel getKernel() const { return generator.getKernel(); } // Getter for the vertex generation kernel
+};
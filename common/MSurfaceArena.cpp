@@ -0,0 +1,225 @@
+#include "MSurfaceArena.hpp"
+#include "MLog.hpp"
+
+// SurfaceArena's constructor reserves the list of buffers, so that the first loads do not grow it
+MSurfaceArena::MSurfaceArena() : system_allocations(0), reuses(0), reserved_bytes(0)
+{
+    blocks.reserve(32);
+    decoded_surfaces.reserve(32);
+}
+
+// ############################################################################################
+// SurfaceArena's destructor frees the surfaces and their buffers
+MSurfaceArena::~MSurfaceArena()
+{
+    this->releaseAll();
+    for (Block &block : this->blocks)
+    {
+        SDL_DestroySurface(block.surface);
+        SDL_aligned_free(block.memory);
+    }
+}
+
+// ############################################################################################
+// SurfaceArena's acquireBlock function takes a free buffer of the size class, or allocates one when the class has none
+int MSurfaceArena::acquireBlock(const size_t size, const int width, const int height, const SDL_PixelFormat format)
+{
+    int size_class{MIN_CLASS_SHIFT};
+    while (size_class <= MAX_CLASS_SHIFT && ((size_t)1 << size_class) < size)
+    {
+        size_class++;
+    }
+    if (size_class > MAX_CLASS_SHIFT)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Surface arena: %llu bytes is above the largest size class\n", (unsigned long long)size);
+        return -1;
+    }
+
+    // Reuse a free buffer of the same class (a power of two at most twice the request), preferably one whose surface already matches
+    int found{-1};
+    for (size_t i = 0; i < this->blocks.size(); i++)
+    {
+        const Block &block = this->blocks[i];
+        if (block.in_use || block.size_class != size_class)
+        {
+            continue;
+        }
+        const bool matches = block.surface != nullptr && block.surface->w == width && block.surface->h == height && block.surface->format == format;
+        if (found < 0 || matches)
+        {
+            found = (int)i;
+            if (matches)
+            {
+                break;
+            }
+        }
+    }
+    if (found >= 0)
+    {
+        this->blocks[found].in_use = true;
+        this->reuses++;
+        return found;
+    }
+
+    // The class has no free buffer: this is the only call that reaches the system allocator
+    void *memory = SDL_aligned_alloc(ALIGNMENT, (size_t)1 << size_class);
+    if (memory == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Surface arena: failed to allocate %llu bytes\n", (unsigned long long)((size_t)1 << size_class));
+        return -1;
+    }
+    this->blocks.push_back(Block{memory, size_class, nullptr, true});
+    this->system_allocations++;
+    this->reserved_bytes += (size_t)1 << size_class;
+    return (int)this->blocks.size() - 1;
+}
+
+// ############################################################################################
+// SurfaceArena's createSurface function wraps a buffer of the arena in a surface, reusing the surface of the buffer when it matches
+SDL_Surface *MSurfaceArena::createSurface(const int width, const int height, const SDL_PixelFormat format)
+{
+    if (width <= 0 || height <= 0 || SDL_BYTESPERPIXEL(format) == 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Surface arena: invalid surface %dx%d %s\n", width, height, SDL_GetPixelFormatName(format));
+        return nullptr;
+    }
+
+    // Rows are padded to 4 bytes, as SDL_CreateSurface does
+    const int pitch = (width * SDL_BYTESPERPIXEL(format) + 3) & ~3;
+    const int index = this->acquireBlock((size_t)pitch * height, width, height, format);
+    if (index < 0)
+    {
+        return nullptr;
+    }
+    Block &block = this->blocks[index];
+
+    // An image of the same size and format (e.g. the same file loaded again) reuses the surface, reset to the state of a new one
+    if (block.surface != nullptr && block.surface->w == width && block.surface->h == height && block.surface->format == format)
+    {
+        SDL_SetSurfaceColorKey(block.surface, false, 0);
+        SDL_SetSurfaceBlendMode(block.surface, SDL_ISPIXELFORMAT_ALPHA(format) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceColorMod(block.surface, 0xFF, 0xFF, 0xFF);
+        SDL_SetSurfaceAlphaMod(block.surface, 0xFF);
+        SDL_SetSurfaceClipRect(block.surface, nullptr);
+        return block.surface;
+    }
+
+    SDL_DestroySurface(block.surface);
+    if (block.surface = SDL_CreateSurfaceFrom(width, height, format, block.memory, pitch); block.surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Surface arena: failed to create surface: %s\n", SDL_GetError());
+        block.in_use = false;
+        return nullptr;
+    }
+    return block.surface;
+}
+
+// ############################################################################################
+// SurfaceArena's load function decodes the file, converting it into a surface of the arena unless it is 32-bit with alpha
+SDL_Surface *MSurfaceArena::load(const std::string_view file_path)
+{
+    // A view is not null-terminated: copy it to the stack for SDL_IOFromFile
+    char path[MAX_PATH_LENGTH];
+    if (file_path.size() >= MAX_PATH_LENGTH)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Surface arena: path longer than %d characters\n", (int)MAX_PATH_LENGTH - 1);
+        return nullptr;
+    }
+    file_path.copy(path, file_path.size());
+    path[file_path.size()] = '\0';
+
+    // Decode straight from the file: the decoder reads it through the stream buffer, without a copy of the whole file
+    SDL_IOStream *file = SDL_IOFromFile(path, "rb");
+    SDL_Surface *decoded_surface = file != nullptr ? IMG_Load_IO(file, true) : nullptr;
+    if (decoded_surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to decode image %s: %s\n", path, SDL_GetError());
+        return nullptr;
+    }
+
+    // A 32-bit image with alpha is used as decoded (the color key converts it in place): a copy would only add a pass over the pixels
+    if (SDL_BITSPERPIXEL(decoded_surface->format) == 32 && SDL_ISPIXELFORMAT_ALPHA(decoded_surface->format))
+    {
+        this->decoded_surfaces.push_back(decoded_surface);
+        MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Image %s decoded without conversion.\n", path);
+        return decoded_surface;
+    }
+
+    // Copy the pixels as they are into an ARGB8888 surface of the arena (the blit also expands paletted and 24-bit images)
+    SDL_Surface *surface = this->createSurface(decoded_surface->w, decoded_surface->h, SDL_PIXELFORMAT_ARGB8888);
+    SDL_SetSurfaceBlendMode(decoded_surface, SDL_BLENDMODE_NONE);
+    if (surface != nullptr && !SDL_BlitSurface(decoded_surface, nullptr, surface, nullptr))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to convert image %s: %s\n", path, SDL_GetError());
+        this->release(surface);
+        surface = nullptr;
+    }
+    SDL_DestroySurface(decoded_surface);
+
+    MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Image %s decoded into the surface arena.\n", path);
+    return surface;
+}
+
+// ############################################################################################
+// SurfaceArena's release function marks the buffer of a surface as free, keeping the buffer and the surface for the next request
+void MSurfaceArena::release(SDL_Surface *surface)
+{
+    if (surface == nullptr)
+    {
+        return;
+    }
+    for (size_t i = 0; i < this->decoded_surfaces.size(); i++)
+    {
+        if (this->decoded_surfaces[i] == surface)
+        {
+            SDL_DestroySurface(surface);
+            this->decoded_surfaces[i] = this->decoded_surfaces.back();
+            this->decoded_surfaces.pop_back();
+            return;
+        }
+    }
+    for (Block &block : this->blocks)
+    {
+        if (block.surface == surface)
+        {
+            block.in_use = false;
+            return;
+        }
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Surface arena: released a surface that does not belong to it\n");
+}
+
+// ############################################################################################
+// SurfaceArena's releaseAll function marks every buffer as free and destroys the surfaces kept as decoded
+void MSurfaceArena::releaseAll()
+{
+    for (SDL_Surface *surface : this->decoded_surfaces)
+    {
+        SDL_DestroySurface(surface);
+    }
+    this->decoded_surfaces.clear();
+    for (Block &block : this->blocks)
+    {
+        block.in_use = false;
+    }
+}
+
+// ############################################################################################
+// SurfaceArena's trim function gives the free buffers back to the system allocator
+void MSurfaceArena::trim()
+{
+    size_t kept{0};
+    for (Block &block : this->blocks)
+    {
+        if (block.in_use)
+        {
+            this->blocks[kept++] = block;
+            continue;
+        }
+        SDL_DestroySurface(block.surface);
+        SDL_aligned_free(block.memory);
+        this->reserved_bytes -= (size_t)1 << block.size_class;
+    }
+    this->blocks.resize(kept);
+}
+// ############################################################################################
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <string_view>
+#include <vector>
+
+// Arena of pixel buffers for decoded images: buffers are bucketed by power-of-two size class and kept after use, so that the next
+// image of the same class (e.g. the same file loaded again) reuses them instead of going back to the system allocator
+// Images are decoded from a file stream with IMG_Load_IO: a 32-bit image with alpha is kept as SDL_image decoded it (its pixels come
+// from SDL's allocator: with MAllocTracker's pooling, a reload takes the blocks of the previous decode back instead of the system
+// allocator), any other format is converted to ARGB8888 into a surface of the arena (SDL_CreateSurfaceFrom)
+// Not thread-safe: use one arena per loading thread
+class MSurfaceArena
+{
+public:
+    static constexpr int MIN_CLASS_SHIFT{12};      // Smallest size class: 4 KiB
+    static constexpr int MAX_CLASS_SHIFT{28};      // Largest size class: 256 MiB
+    static constexpr size_t ALIGNMENT{64};         // Alignment of every buffer, enough for the AVX2 kernels
+    static constexpr size_t MAX_PATH_LENGTH{1024}; // Longest file path accepted by load
+
+private:
+    // Structure to hold one buffer of the arena
+    struct Block
+    {
+        void *memory;         // Buffer of the size of its class
+        int size_class;       // Size class: the buffer holds 1 << size_class bytes
+        SDL_Surface *surface; // Surface over the buffer, kept to be reused by an image of the same size and format
+        bool in_use;          // Flag set from acquire to release
+    };
+
+    std::vector<Block> blocks;                   // Every buffer of the arena
+    std::vector<SDL_Surface *> decoded_surfaces; // Surfaces kept as decoded by load, destroyed on release
+    Uint64 system_allocations; // Number of buffers allocated
+    Uint64 reuses;             // Number of requests served by a buffer already allocated
+    size_t reserved_bytes;     // Bytes held by the buffers
+
+    // Function to get a free buffer of at least size bytes, preferably one with a surface of the given size and format: returns its
+    // index in blocks, -1 on failure
+    int acquireBlock(const size_t size, const int width, const int height, const SDL_PixelFormat format);
+
+public:
+    // Constructor to initialize an empty arena
+    MSurfaceArena();
+
+    // Destructor to free every buffer (the surfaces of the arena must not be used afterwards)
+    ~MSurfaceArena();
+
+    // The arena owns its buffers: no copies
+    MSurfaceArena(const MSurfaceArena &) = delete;
+    MSurfaceArena &operator=(const MSurfaceArena &) = delete;
+
+    // Function to create a surface over a buffer of the arena (content undefined), given back with release or releaseAll
+    SDL_Surface *createSurface(const int width, const int height, const SDL_PixelFormat format);
+
+    // Function to decode an image file into a 32-bit surface with alpha (as decoded, or ARGB8888), given back with release or releaseAll
+    SDL_Surface *load(const std::string_view file_path);
+
+    // Function to give a surface back to the arena, to be reused by the next surface of its size class (do not destroy it): a surface
+    // kept as decoded is destroyed, its pixels going back to SDL's allocator
+    void release(SDL_Surface *surface);
+
+    // Function to give every surface back at once, e.g. when a loading phase finishes
+    void releaseAll();
+
+    // Function to free the buffers that are not in use
+    void trim();
+
+    // Getters for the arena state inline for efficiency
+    inline const Uint64 getSystemAllocations() const { return system_allocations; } // Getter for the number of buffers allocated
+    inline const Uint64 getReuses() const { return reuses; }                         // Getter for the number of buffers reused
+    inline const size_t getReservedBytes() const { return reserved_bytes; }          // Getter for the bytes held by the buffers
+    inline const size_t getBlockCount() const { return blocks.size(); }              // Getter for the number of buffers
+};
@@ -0,0 +1,382 @@
+#include "MSurfaceBlitter.hpp"
+#include <algorithm>
+
+// The SIMD kernels are only compiled for x86 targets, other targets use the scalar kernel
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MBLIT_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MBLIT_TARGET_SSE2 __attribute__((target("sse2")))
+#define MBLIT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MBLIT_TARGET_SSE2
+#define MBLIT_TARGET_AVX2
+#endif
+#endif
+
+// Linear interpolation of the four channels of two pixels, with a weight from 0 to 127 (same rounding as the SIMD kernels)
+static inline Uint32 lerpPixel(const Uint32 a, const Uint32 b, const int weight)
+{
+    Uint32 result{0};
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const int channel_a = (int)((a >> shift) & 0xFF);
+        const int channel_b = (int)((b >> shift) & 0xFF);
+        result |= (Uint32)(channel_a + (((channel_b - channel_a) * weight) >> 7)) << shift;
+    }
+    return result;
+}
+
+// Function to resample one destination row with the nearest source pixels (scalar kernel)
+static void nearestRowScalar(const Uint32 *src_row, Uint32 *dst_row, const int *columns, const int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        dst_row[i] = src_row[columns[i]];
+    }
+}
+
+// Function to resample one destination row by bilinear interpolation of two source rows (scalar kernel)
+static void linearRowScalar(const Uint32 *src_row0, const Uint32 *src_row1, const int weight_y, Uint32 *dst_row, const int *columns0, const int *columns1, const int *weights, const int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const Uint32 top = lerpPixel(src_row0[columns0[i]], src_row0[columns1[i]], weights[i]);
+        const Uint32 bottom = lerpPixel(src_row1[columns0[i]], src_row1[columns1[i]], weights[i]);
+        dst_row[i] = lerpPixel(top, bottom, weight_y);
+    }
+}
+
+#ifdef MBLIT_X86
+// Linear interpolation of 16-bit channels: x + ((y - x) * w) >> 7
+MBLIT_TARGET_SSE2 static inline __m128i lerp16(const __m128i x, const __m128i y, const __m128i w)
+{
+    return _mm_add_epi16(x, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(y, x), w), 7));
+}
+
+// Function to resample one destination row by bilinear interpolation, 4 pixels per iteration (SSE2 kernel)
+MBLIT_TARGET_SSE2 static void linearRowSSE2(const Uint32 *src_row0, const Uint32 *src_row1, const int weight_y, Uint32 *dst_row, const int *columns0, const int *columns1, const int *weights, const int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wy = _mm_set1_epi16((short)weight_y);
+
+    int i{0};
+    for (; i + 4 <= count; i += 4)
+    {
+        // SSE2 has no gather: the 16 source pixels are loaded one by one
+        const __m128i a = _mm_set_epi32((int)src_row0[columns0[i + 3]], (int)src_row0[columns0[i + 2]], (int)src_row0[columns0[i + 1]], (int)src_row0[columns0[i]]);
+        const __m128i b = _mm_set_epi32((int)src_row0[columns1[i + 3]], (int)src_row0[columns1[i + 2]], (int)src_row0[columns1[i + 1]], (int)src_row0[columns1[i]]);
+        const __m128i c = _mm_set_epi32((int)src_row1[columns0[i + 3]], (int)src_row1[columns0[i + 2]], (int)src_row1[columns0[i + 1]], (int)src_row1[columns0[i]]);
+        const __m128i d = _mm_set_epi32((int)src_row1[columns1[i + 3]], (int)src_row1[columns1[i + 2]], (int)src_row1[columns1[i + 1]], (int)src_row1[columns1[i]]);
+
+        // Spread each pixel weight over the four 16-bit channels of its pixel
+        const __m128i w32 = _mm_loadu_si128((const __m128i *)(weights + i));
+        const __m128i w16 = _mm_or_si128(w32, _mm_slli_epi32(w32, 16));
+        const __m128i wx_lo = _mm_unpacklo_epi32(w16, w16); // Pixels 0 and 1
+        const __m128i wx_hi = _mm_unpackhi_epi32(w16, w16); // Pixels 2 and 3
+
+        // Interpolate horizontally on both rows, then vertically
+        const __m128i top_lo = lerp16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), wx_lo);
+        const __m128i top_hi = lerp16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero), wx_hi);
+        const __m128i bottom_lo = lerp16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(d, zero), wx_lo);
+        const __m128i bottom_hi = lerp16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(d, zero), wx_hi);
+        const __m128i result = _mm_packus_epi16(lerp16(top_lo, bottom_lo, wy), lerp16(top_hi, bottom_hi, wy));
+        _mm_storeu_si128((__m128i *)(dst_row + i), result);
+    }
+
+    // Remaining pixels of the row
+    linearRowScalar(src_row0, src_row1, weight_y, dst_row + i, columns0 + i, columns1 + i, weights + i, count - i);
+}
+
+// Linear interpolation of 16-bit channels: x + ((y - x) * w) >> 7
+MBLIT_TARGET_AVX2 static inline __m256i lerp16(const __m256i x, const __m256i y, const __m256i w)
+{
+    return _mm256_add_epi16(x, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(y, x), w), 7));
+}
+
+// Function to resample one destination row with the nearest source pixels, 8 pixels per iteration (AVX2 kernel)
+MBLIT_TARGET_AVX2 static void nearestRowAVX2(const Uint32 *src_row, Uint32 *dst_row, const int *columns, const int count)
+{
+    int i{0};
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i indices = _mm256_loadu_si256((const __m256i *)(columns + i));
+        _mm256_storeu_si256((__m256i *)(dst_row + i), _mm256_i32gather_epi32((const int *)src_row, indices, 4));
+    }
+
+    // Remaining pixels of the row
+    nearestRowScalar(src_row, dst_row + i, columns + i, count - i);
+}
+
+// Function to resample one destination row by bilinear interpolation, 8 pixels per iteration (AVX2 kernel)
+MBLIT_TARGET_AVX2 static void linearRowAVX2(const Uint32 *src_row0, const Uint32 *src_row1, const int weight_y, Uint32 *dst_row, const int *columns0, const int *columns1, const int *weights, const int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i wy = _mm256_set1_epi16((short)weight_y);
+
+    int i{0};
+    for (; i + 8 <= count; i += 8)
+    {
+        // Gather the left and right neighbours on both source rows
+        const __m256i indices0 = _mm256_loadu_si256((const __m256i *)(columns0 + i));
+        const __m256i indices1 = _mm256_loadu_si256((const __m256i *)(columns1 + i));
+        const __m256i a = _mm256_i32gather_epi32((const int *)src_row0, indices0, 4);
+        const __m256i b = _mm256_i32gather_epi32((const int *)src_row0, indices1, 4);
+        const __m256i c = _mm256_i32gather_epi32((const int *)src_row1, indices0, 4);
+        const __m256i d = _mm256_i32gather_epi32((const int *)src_row1, indices1, 4);
+
+        // Spread each pixel weight over the four 16-bit channels of its pixel (the unpacks work inside each 128-bit lane)
+        const __m256i w32 = _mm256_loadu_si256((const __m256i *)(weights + i));
+        const __m256i w16 = _mm256_or_si256(w32, _mm256_slli_epi32(w32, 16));
+        const __m256i wx_lo = _mm256_unpacklo_epi32(w16, w16); // Pixels 0, 1, 4 and 5
+        const __m256i wx_hi = _mm256_unpackhi_epi32(w16, w16); // Pixels 2, 3, 6 and 7
+
+        // Interpolate horizontally on both rows, then vertically
+        const __m256i top_lo = lerp16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero), wx_lo);
+        const __m256i top_hi = lerp16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero), wx_hi);
+        const __m256i bottom_lo = lerp16(_mm256_unpacklo_epi8(c, zero), _mm256_unpacklo_epi8(d, zero), wx_lo);
+        const __m256i bottom_hi = lerp16(_mm256_unpackhi_epi8(c, zero), _mm256_unpackhi_epi8(d, zero), wx_hi);
+        const __m256i result = _mm256_packus_epi16(lerp16(top_lo, bottom_lo, wy), lerp16(top_hi, bottom_hi, wy));
+        _mm256_storeu_si256((__m256i *)(dst_row + i), result);
+    }
+
+    // Remaining pixels of the row
+    linearRowScalar(src_row0, src_row1, weight_y, dst_row + i, columns0 + i, columns1 + i, weights + i, count - i);
+}
+#endif
+
+// ############################################################################################
+// SurfaceBlitter's constructor selects the kernel, falling back to the scalar one when the CPU lacks the instructions
+MSurfaceBlitter::MSurfaceBlitter(const Kernel kernel) : kernel(kernel), fallback_count(0)
+{
+    if (this->kernel == KERNEL_AUTO)
+    {
+        this->kernel = isSupported(KERNEL_AVX2) ? KERNEL_AVX2 : isSupported(KERNEL_SSE2) ? KERNEL_SSE2 : KERNEL_SCALAR;
+    }
+    else if (!isSupported(this->kernel))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Blit kernel %s is not supported by this CPU, using %s\n", getKernelName(this->kernel), getKernelName(KERNEL_SCALAR));
+        this->kernel = KERNEL_SCALAR;
+    }
+}
+
+// ############################################################################################
+// SurfaceBlitter's blitScaled function resamples the source rectangle into the destination rectangle
+bool MSurfaceBlitter::blitScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_ScaleMode scale_mode)
+{
+    const SDL_Rect src_bounds{0, 0, src != nullptr ? src->w : 0, src != nullptr ? src->h : 0};
+    const SDL_Rect src_rect = srcrect != nullptr ? *srcrect : src_bounds;
+    const SDL_Rect dst_rect = dstrect != nullptr ? *dstrect : SDL_Rect{0, 0, dst != nullptr ? dst->w : 0, dst != nullptr ? dst->h : 0};
+
+    // Blits the kernels cannot do exactly like SDL, including source rectangles outside the surface, are handed to SDL
+    SDL_Rect src_visible{};
+    if (!canBlit(src, dst, scale_mode) || !SDL_GetRectIntersection(&src_rect, &src_bounds, &src_visible) || !SDL_RectsEqual(&src_visible, &src_rect))
+    {
+        this->fallback_count++;
+        return SDL_BlitSurfaceScaled(src, srcrect, dst, dstrect, scale_mode);
+    }
+
+    // Only the part of the destination rectangle inside the clip rectangle is written
+    SDL_Rect clip_rect{};
+    SDL_Rect dst_visible{};
+    SDL_GetSurfaceClipRect(dst, &clip_rect);
+    if (dst_rect.w <= 0 || dst_rect.h <= 0 || !SDL_GetRectIntersection(&dst_rect, &clip_rect, &dst_visible))
+    {
+        return true; // Nothing to draw
+    }
+
+    if (!SDL_LockSurface(src))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to lock source surface for blitting: %s\n", SDL_GetError());
+        return false;
+    }
+    if (!SDL_LockSurface(dst))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to lock destination surface for blitting: %s\n", SDL_GetError());
+        SDL_UnlockSurface(src);
+        return false;
+    }
+
+    // The columns are the same for every row: compute them once per blit
+    this->buildColumns(src_rect.x, src_rect.w, dst_rect.w, scale_mode);
+    const int first_column = dst_visible.x - dst_rect.x;
+    const int *columns0 = this->columns[0].data() + first_column;
+    const int *columns1 = this->columns[1].data() + first_column;
+    const int *column_weights = this->weights.data() + first_column;
+
+    for (int y = dst_visible.y; y < dst_visible.y + dst_visible.h; y++)
+    {
+        Uint32 *dst_row = (Uint32 *)((Uint8 *)dst->pixels + (size_t)y * dst->pitch) + dst_visible.x;
+        const Sint64 row_center = 2 * (Sint64)(y - dst_rect.y) + 1; // Twice the position of the pixel center in the destination
+
+        if (scale_mode == SDL_SCALEMODE_NEAREST)
+        {
+            // The source row whose span contains the destination pixel center
+            const int src_y = src_rect.y + (int)std::min<Sint64>(row_center * src_rect.h / (2 * (Sint64)dst_rect.h), src_rect.h - 1);
+            const Uint32 *src_row = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)src_y * src->pitch);
+#ifdef MBLIT_X86
+            if (this->kernel == KERNEL_AVX2)
+            {
+                nearestRowAVX2(src_row, dst_row, columns0, dst_visible.w);
+                continue;
+            }
+#endif
+            nearestRowScalar(src_row, dst_row, columns0, dst_visible.w); // A gather-less SSE2 loop would be the same as the scalar one
+        }
+        else
+        {
+            // The two source rows around the destination pixel center, in 1/128 of a pixel
+            const Sint64 position = std::clamp<Sint64>(row_center * src_rect.h * 128 / (2 * (Sint64)dst_rect.h) - 64, 0, (Sint64)(src_rect.h - 1) * 128);
+            const int row0 = (int)(position >> 7);
+            const int row1 = std::min(row0 + 1, src_rect.h - 1);
+            const int weight_y = (int)(position & 127);
+            const Uint32 *src_row0 = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)(src_rect.y + row0) * src->pitch);
+            const Uint32 *src_row1 = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)(src_rect.y + row1) * src->pitch);
+#ifdef MBLIT_X86
+            if (this->kernel == KERNEL_AVX2)
+            {
+                linearRowAVX2(src_row0, src_row1, weight_y, dst_row, columns0, columns1, column_weights, dst_visible.w);
+                continue;
+            }
+            if (this->kernel == KERNEL_SSE2)
+            {
+                linearRowSSE2(src_row0, src_row1, weight_y, dst_row, columns0, columns1, column_weights, dst_visible.w);
+                continue;
+            }
+#endif
+            linearRowScalar(src_row0, src_row1, weight_y, dst_row, columns0, columns1, column_weights, dst_visible.w);
+        }
+    }
+
+    SDL_UnlockSurface(dst);
+    SDL_UnlockSurface(src);
+    return true;
+}
+
+// ############################################################################################
+// SurfaceBlitter's buildColumns function maps every destination column to its source columns and weight
+void MSurfaceBlitter::buildColumns(const int src_x, const int src_w, const int dst_w, const SDL_ScaleMode scale_mode)
+{
+    // The vectors keep their capacity, so blits of the same size do not allocate
+    this->columns[0].resize(dst_w);
+    this->columns[1].resize(dst_w);
+    this->weights.resize(dst_w);
+
+    for (int x = 0; x < dst_w; x++)
+    {
+        const Sint64 column_center = 2 * (Sint64)x + 1; // Twice the position of the pixel center in the destination
+        if (scale_mode == SDL_SCALEMODE_NEAREST)
+        {
+            this->columns[0][x] = src_x + (int)std::min<Sint64>(column_center * src_w / (2 * (Sint64)dst_w), src_w - 1);
+            this->columns[1][x] = this->columns[0][x];
+            this->weights[x] = 0;
+        }
+        else
+        {
+            const Sint64 position = std::clamp<Sint64>(column_center * src_w * 128 / (2 * (Sint64)dst_w) - 64, 0, (Sint64)(src_w - 1) * 128);
+            const int column0 = (int)(position >> 7);
+            this->columns[0][x] = src_x + column0;
+            this->columns[1][x] = src_x + std::min(column0 + 1, src_w - 1);
+            this->weights[x] = (int)(position & 127);
+        }
+    }
+}
+
+// ############################################################################################
+// SurfaceBlitter's canBlit function checks that a plain copy of the resampled pixels gives the same result as SDL
+bool MSurfaceBlitter::canBlit(SDL_Surface *src, const SDL_Surface *dst, const SDL_ScaleMode scale_mode)
+{
+    if (src == nullptr || dst == nullptr || src == dst || (scale_mode != SDL_SCALEMODE_NEAREST && scale_mode != SDL_SCALEMODE_LINEAR))
+    {
+        return false;
+    }
+
+    // Both surfaces must store 32-bit pixels with the color and alpha channels at the same place: the kernels copy all 4 bytes, so an
+    // XRGB8888 source into an ARGB8888 destination would write its undefined X byte as alpha where SDL writes 0xFF
+    const SDL_PixelFormatDetails *src_details = SDL_GetPixelFormatDetails(src->format);
+    const SDL_PixelFormatDetails *dst_details = SDL_GetPixelFormatDetails(dst->format);
+    if (src_details == nullptr || dst_details == nullptr || src_details->bytes_per_pixel != 4 || dst_details->bytes_per_pixel != 4 ||
+        src_details->Rmask != dst_details->Rmask || src_details->Gmask != dst_details->Gmask || src_details->Bmask != dst_details->Bmask ||
+        src_details->Amask != dst_details->Amask)
+    {
+        return false;
+    }
+
+    // The source pixels must be copied as they are: no blending, no color key, no color modulation
+    Uint8 r{0xFF}, g{0xFF}, b{0xFF};
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    return isOpaqueCopy(src) && r == 0xFF && g == 0xFF && b == 0xFF;
+}
+
+// ############################################################################################
+// SurfaceBlitter's coversSurface function checks if a blit replaces every pixel of the destination
+bool MSurfaceBlitter::coversSurface(SDL_Surface *src, const SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    if (src == nullptr || dst == nullptr || src->w <= 0 || src->h <= 0)
+    {
+        return false;
+    }
+
+    // The destination rectangle must contain the whole surface
+    const SDL_Rect dst_bounds{0, 0, dst->w, dst->h};
+    SDL_Rect covered{};
+    if (dstrect != nullptr && (!SDL_GetRectIntersection(dstrect, &dst_bounds, &covered) || !SDL_RectsEqual(&covered, &dst_bounds)))
+    {
+        return false;
+    }
+
+    // The source pixels must replace the destination pixels
+    return isOpaqueCopy(src);
+}
+
+// ############################################################################################
+// SurfaceBlitter's isOpaqueCopy function checks if blitting the source replaces the destination pixels
+bool MSurfaceBlitter::isOpaqueCopy(SDL_Surface *src)
+{
+    SDL_BlendMode blend_mode{SDL_BLENDMODE_NONE};
+    Uint8 alpha{0xFF};
+    SDL_GetSurfaceBlendMode(src, &blend_mode);
+    SDL_GetSurfaceAlphaMod(src, &alpha);
+
+    // Alpha blending of a surface without alpha channel nor alpha modulation is a copy too
+    const bool copies = blend_mode == SDL_BLENDMODE_NONE || (blend_mode == SDL_BLENDMODE_BLEND && !SDL_ISPIXELFORMAT_ALPHA(src->format) && alpha == 0xFF);
+    return copies && !SDL_SurfaceHasColorKey(src);
+}
+
+// ############################################################################################
+// SurfaceBlitter's isSupported function checks the instruction sets of the CPU
+bool MSurfaceBlitter::isSupported(const Kernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef MBLIT_X86
+    case KERNEL_SSE2:
+        return SDL_HasSSE2();
+    case KERNEL_AVX2:
+        return SDL_HasAVX2();
+#endif
+    case KERNEL_AUTO:
+    case KERNEL_SCALAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ############################################################################################
+// SurfaceBlitter's getKernelName function returns the printable name of a kernel
+const char *MSurfaceBlitter::getKernelName(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KERNEL_SCALAR:
+        return "scalar";
+    case KERNEL_SSE2:
+        return "sse2";
+    case KERNEL_AVX2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
+// ############################################################################################
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Scaled blitter for 32-bit surfaces, with SSE2/AVX2 kernels selected at runtime and a scalar fallback
+// Opaque copies only: any other blit (blending, color key, format conversion) is handed to SDL_BlitSurfaceScaled
+class MSurfaceBlitter
+{
+public:
+    // Kernels that can run a blit
+    enum Kernel
+    {
+        KERNEL_AUTO,   // Best kernel supported by the CPU
+        KERNEL_SCALAR, // Portable C++
+        KERNEL_SSE2,   // 4 pixels per iteration
+        KERNEL_AVX2    // 8 pixels per iteration
+    };
+
+private:
+    Kernel kernel;               // Kernel used by blitScaled
+    std::vector<int> columns[2]; // Source columns sampled by each destination column (left and right neighbour)
+    std::vector<int> weights;    // Weight of the right neighbour for each destination column, from 0 to 127
+    Uint64 fallback_count;       // Number of blits handed to SDL
+
+public:
+    // Constructor to select a kernel (KERNEL_AUTO picks the best one the CPU supports)
+    MSurfaceBlitter(const Kernel kernel = KERNEL_AUTO);
+
+    // Function to blit a surface scaled to a destination rectangle, like SDL_BlitSurfaceScaled
+    bool blitScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_ScaleMode scale_mode);
+
+    // Function to check if a blit would overwrite every pixel of the destination surface, so that clearing it first is useless
+    static bool coversSurface(SDL_Surface *src, const SDL_Surface *dst, const SDL_Rect *dstrect);
+
+    // Function to check if the CPU can run a kernel
+    static bool isSupported(const Kernel kernel);
+
+    // Getter for the blitter state inline for efficiency
+    inline const Kernel getKernel() const { return kernel; }                   // Getter for the kernel in use
+    inline const Uint64 getFallbackCount() const { return fallback_count; }    // Getter for the number of blits handed to SDL
+    static const char *getKernelName(const Kernel kernel);                     // Getter for the printable name of a kernel
+
+private:
+    // Function to check if the blit can be done by the kernels (same 32-bit layout including alpha, no blending, no color key)
+    static bool canBlit(SDL_Surface *src, const SDL_Surface *dst, const SDL_ScaleMode scale_mode);
+
+    // Function to check if blitting the source replaces the destination pixels (no blending, no color key)
+    static bool isOpaqueCopy(SDL_Surface *src);
+
+    // Function to precompute the source columns and weights of every destination column
+    void buildColumns(const int src_x, const int src_w, const int dst_w, const SDL_ScaleMode scale_mode);
+};
@@ -0,0 +1,413 @@
+#include "MTexture.hpp"
+#include "MLog.hpp"
+#include "MProfiler.hpp"
+#include <utility>
+
+// Longest file path accepted by loadTexture: the path is copied to the stack to be null-terminated for IMG_Load
+constexpr size_t MAX_PATH_LENGTH{1024};
+
+// TextureManager's destructor cleans up the texture resource
+MTexture::~MTexture() { clear(); }
+
+// ############################################################################################
+// TextureManager's move constructor takes over the SDL textures of another MTexture
+MTexture::MTexture(MTexture &&other) noexcept
+    : texture(std::exchange(other.texture, nullptr)),
+      keyed_texture(std::exchange(other.keyed_texture, nullptr)),
+      color_key_enabled(std::exchange(other.color_key_enabled, false)),
+      width(std::exchange(other.width, 0.f)),
+      height(std::exchange(other.height, 0.f)),
+      dirty_region(std::move(other.dirty_region)),
+      locked_pixels(std::exchange(other.locked_pixels, 0))
+{
+}
+
+// ############################################################################################
+// TextureManager's move assignment releases the current SDL textures and takes over those of another MTexture
+MTexture &MTexture::operator=(MTexture &&other) noexcept
+{
+    // Moving into itself must not destroy the textures
+    if (this != &other)
+    {
+        this->clear();
+        this->texture = std::exchange(other.texture, nullptr);
+        this->keyed_texture = std::exchange(other.keyed_texture, nullptr);
+        this->color_key_enabled = std::exchange(other.color_key_enabled, false);
+        this->width = std::exchange(other.width, 0.f);
+        this->height = std::exchange(other.height, 0.f);
+        this->dirty_region = std::move(other.dirty_region);
+        this->locked_pixels = std::exchange(other.locked_pixels, 0);
+    }
+    return *this;
+}
+
+// ############################################################################################
+// TextureManager's loadTexture function loads a texture from a file
+bool MTexture::loadTexture(const std::string_view file_path, SDL_Renderer *renderer, const SDL_Color *color_key, const bool keep_plain, const MColorKeyOptions &key_options)
+{
+    MPROFILE_ZONE("MTexture::loadTexture"); // Decoding and uploading on the render thread: a stall of the frame it happens in
+
+    // A view is not null-terminated: copy it to a stack buffer instead of a std::string, so that the path costs no heap allocation
+    char path[MAX_PATH_LENGTH];
+    if (file_path.size() >= MAX_PATH_LENGTH)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load texture: path longer than %d characters\n", (int)MAX_PATH_LENGTH - 1);
+        return false;
+    }
+    file_path.copy(path, file_path.size());
+    path[file_path.size()] = '\0';
+
+    // Clear any existing texture before loading a new one
+    this->clear();
+
+    // Declare a pointer to hold the loaded surface
+    SDL_Surface *loaded_surface{nullptr};
+
+    // Load the texture from the specified file path
+    if (loaded_surface = IMG_Load(path); loaded_surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load texture from %s: %s\n", path, SDL_GetError());
+        return false; // Return false if loading fails
+    }
+    load_count++;
+    MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Texture loaded successfully from %s.\n", path);
+
+    // Create the textures, then free the loaded surface as it's no longer needed
+    const bool created = this->createTextures(loaded_surface, renderer, color_key, keep_plain, key_options, true);
+    SDL_DestroySurface(loaded_surface);
+    loaded_surface = nullptr;
+    return created;
+}
+
+// ############################################################################################
+// TextureManager's loadTexture function loads a texture from a file through a surface arena
+bool MTexture::loadTexture(const std::string_view file_path, SDL_Renderer *renderer, MSurfaceArena &arena, const SDL_Color *color_key, const bool keep_plain,
+                           const MColorKeyOptions &key_options)
+{
+    MPROFILE_ZONE("MTexture::loadTexture(arena)"); // Decoding and uploading on the render thread, without a new pixel buffer once the arena is warm
+
+    // Clear any existing texture before loading a new one
+    this->clear();
+
+    // Decode the file into a surface of the arena (the arena logs the failure)
+    SDL_Surface *loaded_surface = arena.load(file_path);
+    if (loaded_surface == nullptr)
+    {
+        return false; // Return false if loading fails
+    }
+    load_count++;
+    MLOG_INFO(SDL_LOG_CATEGORY_APPLICATION, "Texture loaded successfully from %.*s through the surface arena.\n", (int)file_path.size(), file_path.data());
+
+    // Create the textures, then give the pixel buffer back to the arena for the next image of its size
+    const bool created = this->createTextures(loaded_surface, renderer, color_key, keep_plain, key_options, true);
+    arena.release(loaded_surface);
+    return created;
+}
+
+// ############################################################################################
+// TextureManager's createTextures function uploads a decoded surface, with its color keyed variant when a key is given
+bool MTexture::createTextures(SDL_Surface *surface, SDL_Renderer *renderer, const SDL_Color *color_key, const bool keep_plain, const MColorKeyOptions &key_options, const bool key_in_place)
+{
+    // Create the plain texture first when both variants are kept, so the key can be toggled without decoding again
+    if (color_key != nullptr && keep_plain)
+    {
+        if (texture = SDL_CreateTextureFromSurface(renderer, surface); texture == nullptr)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create texture from surface: %s\n", SDL_GetError());
+            return false; // Return false if texture creation fails
+        }
+    }
+
+    // Make the key color transparent in the pixels themselves, in one vectorized pass: SDL then uploads them without keying each pixel
+    // Formats without a byte per channel and alpha (e.g. RGB24 or paletted images) are converted to ARGB8888 first; the pixels of a
+    // surface the caller owns (which may be read-only, e.g. mapped from an asset pack) are keyed in a copy
+    SDL_Surface *keyed_surface{surface};
+    SDL_Surface *converted_surface{nullptr};
+    if (color_key != nullptr)
+    {
+        if (!MColorKeyConverter::canConvert(surface))
+        {
+            keyed_surface = converted_surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+        }
+        else if (!key_in_place)
+        {
+            keyed_surface = converted_surface = SDL_DuplicateSurface(surface);
+        }
+        if (keyed_surface == nullptr || !MColorKeyConverter().convert(keyed_surface, *color_key, key_options))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to convert color key for surface: %s\n", SDL_GetError());
+            SDL_DestroySurface(converted_surface);
+            this->clear();
+            return false; // Return false if the color key conversion fails
+        }
+        MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Color key converted to alpha successfully for surface.\n");
+    }
+
+    // Create the texture that is rendered by default (color keyed when a key is given)
+    SDL_Texture *created_texture = SDL_CreateTextureFromSurface(renderer, keyed_surface);
+    SDL_DestroySurface(converted_surface);
+    if (created_texture == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create texture from surface: %s\n", SDL_GetError());
+        this->clear();
+        return false; // Return false if texture creation fails
+    }
+    if (color_key != nullptr && key_options.premultiply)
+    {
+        SDL_SetTextureBlendMode(created_texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED); // The colors are already multiplied by alpha
+    }
+    if (this->texture != nullptr)
+    {
+        this->keyed_texture = created_texture; // The plain variant is kept: this one is the keyed variant
+        this->color_key_enabled = true;
+    }
+    else
+    {
+        this->texture = created_texture;
+    }
+
+    // Get the dimensions of the texture
+    this->width = (float)surface->w;
+    this->height = (float)surface->h;
+
+    MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Texture created successfully with dimensions %dx%d.\n", (int)this->width, (int)this->height);
+    return true;
+}
+
+// ############################################################################################
+// TextureManager's loadTexture function creates a texture from a surface that is already in memory
+bool MTexture::loadTexture(SDL_Surface *surface, SDL_Renderer *renderer, const SDL_Color *color_key, const MColorKeyOptions &key_options)
+{
+    MPROFILE_ZONE("MTexture::loadTexture(surface)"); // Upload only: the surface is already decoded
+
+    // Clear any existing texture before loading a new one
+    this->clear();
+
+    // Create a texture from the surface: its pixels are uploaded as they are, unless a color key is given
+    return this->createTextures(surface, renderer, color_key, false, key_options, false);
+}
+
+// ############################################################################################
+// TextureManager's reloadTexture function builds the new textures aside and swaps them in once they exist
+bool MTexture::reloadTexture(SDL_Surface *surface, SDL_Renderer *renderer, const SDL_Color *color_key, const MColorKeyOptions &key_options)
+{
+    MPROFILE_ZONE("MTexture::reloadTexture");
+
+    // The plain and keyed pair is kept when the current texture has one
+    const bool keep_plain = color_key != nullptr && this->keyed_texture != nullptr;
+    MTexture reloaded{};
+    if (!reloaded.createTextures(surface, renderer, color_key, keep_plain, key_options, false))
+    {
+        return false; // The current textures are left untouched
+    }
+    if (keep_plain)
+    {
+        reloaded.color_key_enabled = this->color_key_enabled;
+    }
+
+    // Destroy the old textures only now: every holder of this MTexture renders the new ones from the next draw
+    *this = std::move(reloaded);
+    return true;
+}
+
+// ############################################################################################
+// TextureManager's createStreaming function creates a texture whose pixels can be locked and changed after creation
+bool MTexture::createStreaming(const int width, const int height, SDL_Renderer *renderer)
+{
+    MPROFILE_ZONE("MTexture::createStreaming");
+
+    // Clear any existing texture before creating a new one
+    this->clear();
+
+    // Create a texture that keeps a copy of its pixels the CPU can write to
+    if (texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height); texture == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create streaming texture: %s\n", SDL_GetError());
+        return false; // Return false if texture creation fails
+    }
+    SDL_SetTextureBlendMode(this->texture, SDL_BLENDMODE_BLEND);
+
+    // Get the dimensions of the texture, all of it dirty until the first upload
+    this->width = (float)width;
+    this->height = (float)height;
+    this->dirty_region = std::make_unique<MDirtyRegion>(width, height);
+
+    MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Streaming texture created successfully with dimensions %dx%d.\n", width, height);
+    return true;
+}
+
+// ############################################################################################
+// TextureManager's loadStreaming function creates a streaming texture and uploads the whole surface into it
+bool MTexture::loadStreaming(const SDL_Surface *surface, SDL_Renderer *renderer)
+{
+    if (surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load streaming texture: no surface\n");
+        return false;
+    }
+    return this->createStreaming(surface->w, surface->h, renderer) && this->uploadDirty(surface);
+}
+
+// ############################################################################################
+// TextureManager's lockPixels function gives direct access to a rectangle of the streaming texture
+void *MTexture::lockPixels(const SDL_Rect *rect, int &pitch)
+{
+    if (!this->isStreaming())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to lock texture: not a streaming texture\n");
+        return nullptr;
+    }
+
+    void *pixels{nullptr};
+    if (!SDL_LockTexture(this->texture, rect, &pixels, &pitch))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to lock texture: %s\n", SDL_GetError());
+        return nullptr;
+    }
+    this->locked_pixels = rect != nullptr ? (Uint64)rect->w * rect->h : (Uint64)this->width * (Uint64)this->height;
+    return pixels;
+}
+
+// ############################################################################################
+// TextureManager's unlockPixels function uploads the locked rectangle, counted only now that it reaches the texture
+void MTexture::unlockPixels()
+{
+    if (this->isStreaming())
+    {
+        SDL_UnlockTexture(this->texture);
+        uploaded_pixels += this->locked_pixels;
+    }
+    this->locked_pixels = 0;
+}
+
+// ############################################################################################
+// TextureManager's markDirty function records a changed rectangle until the next upload
+void MTexture::markDirty(const SDL_Rect &rect)
+{
+    if (this->isStreaming())
+    {
+        this->dirty_region->add(rect);
+    }
+}
+
+// ############################################################################################
+// TextureManager's uploadDirty function copies the changed rectangles of a surface into the texture, leaving the other pixels as they are
+bool MTexture::uploadDirty(const SDL_Surface *source)
+{
+    MPROFILE_ZONE("MTexture::uploadDirty");
+
+    if (!this->isStreaming() || source == nullptr || source->w != (int)this->width || source->h != (int)this->height)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to upload texture: not a streaming texture of the surface size\n");
+        return false;
+    }
+
+    // Each rectangle is locked on its own, so that only the changed pixels go to the renderer (SDL_ConvertPixels copies rows when the formats match)
+    bool success{true};
+    const int bytes_per_pixel = SDL_BYTESPERPIXEL(source->format);
+    for (const SDL_Rect &rect : this->dirty_region->getRects())
+    {
+        int pitch{0};
+        void *pixels = this->lockPixels(&rect, pitch);
+        if (pixels == nullptr)
+        {
+            success = false;
+            continue;
+        }
+        const Uint8 *source_pixels = (const Uint8 *)source->pixels + (size_t)rect.y * source->pitch + (size_t)rect.x * bytes_per_pixel;
+        if (!SDL_ConvertPixels(rect.w, rect.h, source->format, source_pixels, source->pitch, SDL_PIXELFORMAT_ARGB8888, pixels, pitch))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to convert pixels for upload: %s\n", SDL_GetError());
+            this->locked_pixels = 0; // The rectangle holds no pixels of the surface: it is not counted as uploaded
+            success = false;
+        }
+        this->unlockPixels();
+    }
+    this->dirty_region->clear();
+    return success;
+}
+
+// ############################################################################################
+// TextureManager's renderTexture function renders the texture at a specified position
+void MTexture::renderTexture(const float pos_x, const float pos_y, SDL_Renderer *renderer, const SDL_FRect *clipRect) const
+{
+    MPROFILE_ZONE("MTexture::renderTexture");
+
+    SDL_FRect dstRect{pos_x, pos_y, this->width, this->height}; // Declare a rectangle to hold the destination position and size
+
+    // If a clip rectangle is provided, adjust the destination rectangle size
+    if (clipRect != nullptr)
+    {
+        dstRect.w = clipRect->w; // Set the width from the clip rectangle
+        dstRect.h = clipRect->h; // Set the height from the clip rectangle
+    }
+
+    // Render the texture with the specified renderer, clip rectangle and destination rectangle
+    if (!SDL_RenderTexture(renderer, this->getActiveTexture(), clipRect, &dstRect))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render texture: %s\n", SDL_GetError());
+    }
+}
+
+// ############################################################################################
+// TextureManager's renderTexture function renders the texture stretched to a specified size
+void MTexture::renderTexture(const float pos_x, const float pos_y, const float stretch_w, const float stretch_h, SDL_Renderer *renderer, const SDL_FRect *clipRect) const
+{
+    MPROFILE_ZONE("MTexture::renderTexture(stretched)");
+
+    // Declare a rectangle to hold the destination position and size
+    SDL_FRect dstRect{pos_x, pos_y, stretch_w, stretch_h};
+
+    // Render the texture with the specified renderer, clip rectangle and destination rectangle
+    if (!SDL_RenderTexture(renderer, this->getActiveTexture(), clipRect, &dstRect))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render texture with stretching: %s\n", SDL_GetError());
+    }
+}
+
+// ############################################################################################
+// TextureManager's renderTexture function renders the texture with rotation and flipping
+void MTexture::renderTexture(const float pos_x, const float pos_y, const float degree, const SDL_FlipMode flip_mode, SDL_Renderer *renderer, const SDL_FRect *clipRect) const
+{
+    MPROFILE_ZONE("MTexture::renderTexture(rotated)");
+
+    SDL_FRect dstRect{pos_x, pos_y, this->width, this->height};
+
+    // Adjust the destination rectangle if a clip rectangle is provided
+    if (clipRect != nullptr)
+    {
+        dstRect.w = clipRect->w;
+        dstRect.h = clipRect->h;
+    }
+
+    // Define the center point for rotation
+    SDL_FPoint center{dstRect.w / 2.f, dstRect.h / 2.f};
+
+    // Render the texture with rotation and flipping
+    if (!SDL_RenderTextureRotated(renderer, this->getActiveTexture(), clipRect, &dstRect, degree, &center, flip_mode))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to render texture with rotation: %s\n", SDL_GetError());
+    }
+}
+
+// ############################################################################################
+// TextureManager's clear function cleans up the texture resource
+void MTexture::clear()
+{
+    // An empty (or moved-from) texture has nothing to destroy
+    if (this->texture != nullptr || this->keyed_texture != nullptr)
+    {
+        destroy_count += (this->texture != nullptr) + (this->keyed_texture != nullptr);
+        SDL_DestroyTexture(this->texture);
+        SDL_DestroyTexture(this->keyed_texture);
+        MLOG_DEBUG(SDL_LOG_CATEGORY_APPLICATION, "Texture cleared successfully.\n");
+    }
+    this->texture = nullptr;
+    this->keyed_texture = nullptr;
+    this->color_key_enabled = false;
+    this->width = 0;
+    this->height = 0;
+    this->dirty_region.reset();
+    this->locked_pixels = 0;
+}
+// ############################################################################################
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include "MSurfaceArena.hpp"
+#include "MColorKeyConverter.hpp"
+#include "MDirtyRegion.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Texture class shared by every tutorial: it owns its SDL textures, so it can be moved but not copied
+class MTexture
+{
+private:
+    SDL_Texture *texture;       // Pointer to the texture object (color keyed, unless a plain variant was kept)
+    SDL_Texture *keyed_texture; // Pointer to the color keyed variant, only set when the plain variant is kept
+    bool color_key_enabled;     // Flag to select which of the two textures is rendered
+    float width;                // Width of the texture
+    float height;               // Height of the texture
+
+    std::unique_ptr<MDirtyRegion> dirty_region; // Rectangles changed since the last upload (streaming textures only, nullptr otherwise)
+    Uint64 locked_pixels;                       // Pixels of the rectangle locked by lockPixels, counted as uploaded by unlockPixels
+
+    inline static Uint64 load_count{0};      // Number of image files decoded by every MTexture
+    inline static Uint64 destroy_count{0};   // Number of SDL textures destroyed by every MTexture
+    inline static Uint64 uploaded_pixels{0}; // Number of pixels uploaded to streaming textures by every MTexture (counted at unlock)
+
+public:
+    // Constructor to initialize resources
+    MTexture() noexcept : texture(nullptr), keyed_texture(nullptr), color_key_enabled(false), width(0), height(0), locked_pixels(0) {};
+
+    // Destructor to clean up resources
+    ~MTexture();
+
+    // A texture is owned by exactly one MTexture: copying is not allowed
+    MTexture(const MTexture &) = delete;
+    MTexture &operator=(const MTexture &) = delete;
+
+    // Move constructor and assignment transfer the SDL textures and leave the source empty
+    MTexture(MTexture &&other) noexcept;
+    MTexture &operator=(MTexture &&other) noexcept;
+
+    // Function to load a texture from a file, optionally making a color transparent (keep_plain also keeps the variant without color key)
+    // The path is a view: literals and std::string both bind to it without building a std::string
+    // The key is converted to alpha by MColorKeyConverter, with an optional tolerance and premultiplied output (key_options)
+    bool loadTexture(const std::string_view file_path, SDL_Renderer *renderer, const SDL_Color *color_key = nullptr, const bool keep_plain = false, const MColorKeyOptions &key_options = {});
+
+    // Function to load a texture from a file decoded into a surface arena: the pixel buffer is given back to the arena once uploaded
+    bool loadTexture(const std::string_view file_path, SDL_Renderer *renderer, MSurfaceArena &arena, const SDL_Color *color_key = nullptr, const bool keep_plain = false,
+                     const MColorKeyOptions &key_options = {});
+
+    // Function to load a texture from an already decoded surface (e.g. an atlas page or an asset pack entry), owned by the caller
+    // The surface is never written: a color key is converted in a copy, so read-only pixels (e.g. mapped from an asset pack) can be keyed
+    bool loadTexture(SDL_Surface *surface, SDL_Renderer *renderer, const SDL_Color *color_key = nullptr, const MColorKeyOptions &key_options = {});
+
+    // Function to replace the content with a newly decoded surface (e.g. a hot reload): the new textures are created first and swapped in
+    // only on success, so a failure keeps the current ones; a kept plain variant is rebuilt too, with the same color key selection
+    // Like loadTexture, the surface (owned by the caller) is never written: a color key is converted in a copy
+    bool reloadTexture(SDL_Surface *surface, SDL_Renderer *renderer, const SDL_Color *color_key = nullptr, const MColorKeyOptions &key_options = {});
+
+    // Function to create an empty streaming texture (ARGB8888, SDL_TEXTUREACCESS_STREAMING) whose pixels are changed in place, without recreating it
+    bool createStreaming(const int width, const int height, SDL_Renderer *renderer);
+
+    // Function to create a streaming texture with the pixels of a surface (owned by the caller)
+    bool loadStreaming(const SDL_Surface *surface, SDL_Renderer *renderer);
+
+    // Function to lock a rectangle of a streaming texture (nullptr for all of it) and write into its pixels directly: they are write-only,
+    // so every pixel of the rectangle must be written before unlockPixels uploads it
+    void *lockPixels(const SDL_Rect *rect, int &pitch);
+
+    // Function to upload the rectangle written since lockPixels (its pixels are counted in getUploadedPixels)
+    void unlockPixels();
+
+    // Function to mark a rectangle of a streaming texture as changed in the surface it mirrors, merged with the other changed rectangles
+    void markDirty(const SDL_Rect &rect);
+
+    // Function to upload the changed rectangles from a surface of the texture size (any format), one lock per rectangle, then forget them
+    bool uploadDirty(const SDL_Surface *source);
+
+    // Function to render the texture at a specific position with clipping
+    void renderTexture(const float x, const float y, SDL_Renderer *renderer, const SDL_FRect *clipRect = nullptr) const;
+
+    // Function to render the texture with stretching
+    void renderTexture(const float x, const float y, const float stretch_w, const float stretch_h, SDL_Renderer *renderer, const SDL_FRect *clipRect = nullptr) const;
+
+    // Function to render the texture with rotation (around its center) and flipping
+    void renderTexture(const float x, const float y, const float degree, const SDL_FlipMode flip_mode, SDL_Renderer *renderer, const SDL_FRect *clipRect = nullptr) const;
+
+    // Function to clear up the texture resources
+    void clear();
+
+    // Function to toggle the color key at runtime without reloading the texture (needs keep_plain at load time)
+    inline void setColorKey(const bool enabled) { color_key_enabled = enabled; }
+
+    // Getter for the texture pointer inline for efficiency
+    inline const float getWidth() const { return width; }                            // Getter for texture width
+    inline const float getHeight() const { return height; }                          // Getter for texture height
+    inline const bool isLoaded() const { return texture != nullptr; }                // Getter for the loaded state
+    inline const bool isColorKeyEnabled() const { return color_key_enabled; }        // Getter for the color key state
+    inline SDL_Texture *getTexture() const { return getActiveTexture(); }            // Getter for the SDL texture (used by sprite batches)
+    inline static const Uint64 getLoadCount() { return load_count; }                 // Getter for the number of decoded files
+    inline static const Uint64 getDestroyCount() { return destroy_count; }           // Getter for the number of destroyed SDL textures
+    inline static const Uint64 getUploadedPixels() { return uploaded_pixels; }       // Getter for the number of pixels written to streaming textures
+    inline const bool isStreaming() const { return dirty_region != nullptr; }        // Getter for the streaming state
+
+private:
+    // Function to create the textures from a decoded surface, optionally making a color transparent (the surface stays owned by the caller)
+    // The key is converted in the pixels of the surface itself only with key_in_place (surfaces decoded by MTexture), in a copy otherwise
+    bool createTextures(SDL_Surface *surface, SDL_Renderer *renderer, const SDL_Color *color_key, const bool keep_plain, const MColorKeyOptions &key_options, const bool key_in_place);
+
+    // Function to get the variant selected by the color key flag
+    inline SDL_Texture *getActiveTexture() const { return color_key_enabled && keyed_texture != nullptr ? keyed_texture : texture; }
+};
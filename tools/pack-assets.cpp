@@ -0,0 +1,254 @@
+#include "MAssetPack.hpp"
+#include <SDL3_image/SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Pixel format stored in the pack: the format most renderers use natively, so texture creation needs no conversion
+constexpr SDL_PixelFormat PACK_PIXEL_FORMAT{SDL_PIXELFORMAT_ARGB8888};
+
+// Structure to hold how an asset is pre-processed before it is stored in the pack
+struct AssetDescription
+{
+    const char *name;    // File name in the assets directory
+    bool has_color_key;  // Flag to indicate if a color is made transparent
+    SDL_Color color_key; // Color made transparent (same keys as the tutorials)
+};
+
+// Structure to hold the assets loaded by one tutorial
+struct TutorialDescription
+{
+    const char *name;                 // Tutorial name
+    std::vector<const char *> assets; // Assets loaded at startup
+};
+
+const std::vector<AssetDescription> ASSETS{
+    {"02img.png", false, {}},
+    {"03img.png", false, {}},
+    {"03up.png", false, {}},
+    {"03down.png", false, {}},
+    {"03left.png", false, {}},
+    {"03right.png", false, {}},
+    {"04background0.png", false, {}},
+    {"04background1.png", false, {}},
+    {"04sprite.png", true, {0x00, 0xFF, 0xFF, 0xFF}},
+    {"05dots.png", true, {0xFF, 0xFF, 0xFF, 0xFF}},
+    {"06arrow.png", true, {0xFF, 0xFF, 0xFF, 0xFF}},
+};
+
+const std::vector<TutorialDescription> TUTORIALS{
+    {"02-sdl-textures", {"02img.png"}},
+    {"03-sdl-event-handling", {"03img.png", "03up.png", "03down.png", "03left.png", "03right.png"}},
+    {"04-sdl-color-keying", {"04background0.png", "04background1.png", "04sprite.png"}},
+    {"05-sdl-clipping-and-stretching", {"05dots.png"}},
+    {"06-sdl-rotation-and-flipping", {"06arrow.png"}},
+};
+
+// Function to find the description of an asset
+const AssetDescription *findAsset(const char *name)
+{
+    for (const AssetDescription &asset : ASSETS)
+    {
+        if (std::strcmp(asset.name, name) == 0)
+        {
+            return &asset;
+        }
+    }
+    return nullptr;
+}
+
+// Function to decode an asset, apply its color key and convert it to the pack pixel format
+SDL_Surface *decodeAsset(const std::string &assets_dir, const AssetDescription &asset)
+{
+    const std::string file_path = assets_dir + "/" + asset.name;
+    SDL_Surface *loaded_surface = IMG_Load(file_path.c_str());
+    if (loaded_surface == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load %s: %s\n", file_path.c_str(), SDL_GetError());
+        return nullptr;
+    }
+
+    // Copy the pixels as they are into a transparent surface: keyed pixels are skipped and stay transparent
+    SDL_Surface *converted_surface = SDL_CreateSurface(loaded_surface->w, loaded_surface->h, PACK_PIXEL_FORMAT);
+    if (converted_surface != nullptr)
+    {
+        SDL_SetSurfaceBlendMode(loaded_surface, SDL_BLENDMODE_NONE);
+        if (asset.has_color_key)
+        {
+            SDL_SetSurfaceColorKey(loaded_surface, true, SDL_MapSurfaceRGB(loaded_surface, asset.color_key.r, asset.color_key.g, asset.color_key.b));
+        }
+        if (!SDL_BlitSurface(loaded_surface, nullptr, converted_surface, nullptr))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to convert %s: %s\n", file_path.c_str(), SDL_GetError());
+            SDL_DestroySurface(converted_surface);
+            converted_surface = nullptr;
+        }
+    }
+
+    SDL_DestroySurface(loaded_surface);
+    return converted_surface;
+}
+
+// Function to write every asset into a pack file
+bool writePack(const std::string &assets_dir, const std::string &pack_path)
+{
+    std::vector<SDL_Surface *> surfaces;
+    std::vector<MAssetPackEntry> entries(ASSETS.size());
+
+    // Decode every asset and lay the index out
+    Uint64 offset = sizeof(MAssetPackHeader) + entries.size() * sizeof(MAssetPackEntry);
+    for (size_t i = 0; i < ASSETS.size(); i++)
+    {
+        SDL_Surface *surface = decodeAsset(assets_dir, ASSETS[i]);
+        if (surface == nullptr)
+        {
+            for (SDL_Surface *decoded : surfaces)
+            {
+                SDL_DestroySurface(decoded);
+            }
+            return false;
+        }
+        surfaces.push_back(surface);
+
+        offset = (offset + MASSET_PACK_ALIGNMENT - 1) / MASSET_PACK_ALIGNMENT * MASSET_PACK_ALIGNMENT;
+        MAssetPackEntry &entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::strncpy(entry.name, ASSETS[i].name, sizeof(entry.name) - 1);
+        entry.width = (Uint32)surface->w;
+        entry.height = (Uint32)surface->h;
+        entry.pitch = (Uint32)surface->w * SDL_BYTESPERPIXEL(PACK_PIXEL_FORMAT);
+        entry.offset = offset;
+        offset += (Uint64)entry.pitch * entry.height;
+    }
+
+    // Write the header, the index and the pixel blocks
+    std::ofstream file(pack_path, std::ios::binary | std::ios::trunc);
+    MAssetPackHeader header{};
+    std::memcpy(header.magic, MASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = MASSET_PACK_VERSION;
+    header.pixel_format = (Uint32)PACK_PIXEL_FORMAT;
+    header.entry_count = (Uint32)entries.size();
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)entries.data(), entries.size() * sizeof(MAssetPackEntry));
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        // Pad up to the aligned offset of the block
+        const std::vector<char> padding(entries[i].offset - (Uint64)file.tellp(), 0);
+        file.write(padding.data(), padding.size());
+
+        // Write the rows without the surface pitch padding
+        const Uint8 *pixels = (const Uint8 *)surfaces[i]->pixels;
+        for (Uint32 row = 0; row < entries[i].height; row++)
+        {
+            file.write((const char *)(pixels + row * surfaces[i]->pitch), entries[i].pitch);
+        }
+        SDL_DestroySurface(surfaces[i]);
+    }
+
+    if (!file)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to write asset pack %s\n", pack_path.c_str());
+        return false;
+    }
+    std::printf("Wrote %zu assets to %s (%llu bytes)\n", entries.size(), pack_path.c_str(), (unsigned long long)file.tellp());
+    return true;
+}
+
+// Function to measure the current startup path of a tutorial: PNG decode, color key and texture creation for each asset
+double measurePngPath(const std::string &assets_dir, const TutorialDescription &tutorial, SDL_Renderer *renderer)
+{
+    std::vector<SDL_Texture *> textures;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (const char *name : tutorial.assets)
+    {
+        const AssetDescription *asset = findAsset(name);
+        SDL_Surface *loaded_surface = IMG_Load((assets_dir + "/" + name).c_str());
+        if (loaded_surface == nullptr)
+        {
+            continue;
+        }
+        if (asset->has_color_key)
+        {
+            SDL_SetSurfaceColorKey(loaded_surface, true, SDL_MapSurfaceRGB(loaded_surface, asset->color_key.r, asset->color_key.g, asset->color_key.b));
+        }
+        textures.push_back(SDL_CreateTextureFromSurface(renderer, loaded_surface));
+        SDL_DestroySurface(loaded_surface);
+    }
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+
+    for (SDL_Texture *texture : textures)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    return seconds;
+}
+
+// Function to measure the pack startup path of a tutorial: map the pack and create each texture from the mapped pixels
+double measurePackPath(const std::string &pack_path, const TutorialDescription &tutorial, SDL_Renderer *renderer)
+{
+    std::vector<SDL_Texture *> textures;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    MAssetPack pack{};
+    if (pack.open(pack_path))
+    {
+        for (const char *name : tutorial.assets)
+        {
+            SDL_Surface *mapped_surface = pack.createSurface(name);
+            if (mapped_surface == nullptr)
+            {
+                continue;
+            }
+            textures.push_back(SDL_CreateTextureFromSurface(renderer, mapped_surface));
+            SDL_DestroySurface(mapped_surface);
+        }
+    }
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+
+    for (SDL_Texture *texture : textures)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    return seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string assets_dir = argc > 1 ? argv[1] : "../assets";
+    const std::string pack_path = argc > 2 ? argv[2] : assets_dir + "/tutorials.mpak";
+
+    // Build the pack
+    if (!writePack(assets_dir, pack_path))
+    {
+        return 1;
+    }
+
+    // The software renderer draws into a plain surface: no window or GPU is needed
+    SDL_Surface *pTarget = SDL_CreateSurface(640, 480, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer *pRenderer = pTarget != nullptr ? SDL_CreateSoftwareRenderer(pTarget) : nullptr;
+    if (pRenderer == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Could not create the software renderer: %s\n", SDL_GetError());
+        return 2;
+    }
+
+    // Compare the startup time of every tutorial: the files were just read and written, so they are in the OS file cache and the
+    // timings leave the disk reads of a cold start out
+    std::printf("Warm file cache: decode and upload time only, without the disk reads of a cold start\n");
+    std::printf("%-32s %12s %12s %10s\n", "tutorial", "warm png ms", "warm pack ms", "speedup");
+    for (const TutorialDescription &tutorial : TUTORIALS)
+    {
+        const double png_seconds = measurePngPath(assets_dir, tutorial, pRenderer);
+        const double pack_seconds = measurePackPath(pack_path, tutorial, pRenderer);
+        std::printf("%-32s %12.3f %12.3f %9.2fx\n", tutorial.name, png_seconds * 1000.0, pack_seconds * 1000.0, png_seconds / pack_seconds);
+    }
+
+    // Clean up
+    SDL_DestroyRenderer(pRenderer);
+    SDL_DestroySurface(pTarget);
+    SDL_Quit();
+
+    return 0;
+}